@@ -0,0 +1,165 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+using namespace mockturtle;
+
+/* rebuilds the output cones of `src` into `dest`; the outputs are
+ * distributed round-robin to `num_threads` threads, which
+ * concurrently create (and share) the nodes of overlapping cones */
+void concurrent_copy( aig_network const& src, aig_network& dest, uint32_t num_threads )
+{
+  std::vector<aig_network::signal> pis;
+  src.foreach_pi( [&]( auto const& ) {
+    pis.push_back( dest.create_pi() );
+  } );
+
+  std::vector<aig_network::signal> pos( src.num_pos() );
+
+  dest.begin_concurrent_strash( src.num_gates() );
+
+  const auto copy_cones = [&]( uint32_t t ) {
+    std::vector<aig_network::signal> old2new( src.size() );
+    std::vector<uint8_t> in_cone( src.size(), 0 );
+    std::vector<aig_network::node> stack;
+
+    src.foreach_po( [&]( auto const& f, auto i ) {
+      if ( i % num_threads == t )
+      {
+        stack.push_back( src.get_node( f ) );
+      }
+    } );
+    while ( !stack.empty() )
+    {
+      const auto n = stack.back();
+      stack.pop_back();
+      if ( in_cone[n] )
+      {
+        continue;
+      }
+      in_cone[n] = 1;
+      src.foreach_fanin( n, [&]( auto const& f ) {
+        stack.push_back( src.get_node( f ) );
+      } );
+    }
+
+    old2new[0] = dest.get_constant( false );
+    src.foreach_pi( [&]( auto const& n, auto i ) {
+      old2new[n] = pis[i];
+    } );
+    src.foreach_gate( [&]( auto const& n ) {
+      if ( !in_cone[n] )
+      {
+        return;
+      }
+      std::array<aig_network::signal, 2u> children;
+      src.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        children[i] = old2new[src.get_node( f )] ^ src.is_complemented( f );
+      } );
+      old2new[n] = dest.create_and( children[0], children[1] );
+    } );
+
+    src.foreach_po( [&]( auto const& f, auto i ) {
+      if ( i % num_threads == t )
+      {
+        pos[i] = old2new[src.get_node( f )] ^ src.is_complemented( f );
+      }
+    } );
+  };
+
+  std::vector<std::thread> threads;
+  for ( auto t = 1u; t < num_threads; ++t )
+  {
+    threads.emplace_back( copy_cones, t );
+  }
+  copy_cones( 0u );
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  dest.end_concurrent_strash();
+
+  for ( auto const& f : pos )
+  {
+    dest.create_po( f );
+  }
+}
+
+int main()
+{
+  using namespace experiments;
+
+  experiment<std::string, uint32_t, uint32_t, uint32_t, float, float, bool> exp( "concurrent_strash", "benchmark", "size", "threads", "size after", "runtime", "speedup", "equivalent" );
+
+  const auto max_threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    double base_time{0};
+    for ( auto num_threads = 1u; num_threads <= max_threads; num_threads *= 2u )
+    {
+      aig_network res;
+      stopwatch<>::duration time{0};
+      {
+        stopwatch t( time );
+        concurrent_copy( aig, res, num_threads );
+      }
+
+      if ( num_threads == 1u )
+      {
+        base_time = to_seconds( time );
+      }
+
+      const auto cec = benchmark == "hyp" ? true : abc_cec( res, benchmark );
+      exp( benchmark, aig.num_gates(), num_threads, res.num_gates(), to_seconds( time ), base_time / to_seconds( time ), cec );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
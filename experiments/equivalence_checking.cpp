@@ -33,6 +33,7 @@
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/miter.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/sweeping_equivalence_checking.hpp>
 #include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/networks/aig.hpp>
 
@@ -66,7 +67,7 @@ int main()
     {"voter", 3.54}
   };
 
-  experiment<std::string, double, double, bool> exp( "equivalence_checking", "benchmark", "abc cec", "runtime", "equivalent" );
+  experiment<std::string, double, double, double, bool> exp( "equivalence_checking", "benchmark", "abc cec", "runtime", "sweeping", "equivalent" );
 
   for ( auto const& benchmark : epfl_benchmarks() )
   {
@@ -83,10 +84,15 @@ int main()
 
     aig = cut_rewriting( aig, resyn, ps );
 
+    const auto miter_aig = *miter<aig_network>( orig, aig );
+
     equivalence_checking_stats st;
-    auto cec = *equivalence_checking( *miter<aig_network>( orig, aig ), {}, &st );
+    auto cec = *equivalence_checking( miter_aig, {}, &st );
+
+    sweeping_equivalence_checking_stats sweeping_st;
+    const auto sweeping_cec = sweeping_equivalence_checking( miter_aig, {}, &sweeping_st );
 
-    exp( benchmark, baseline[benchmark], to_seconds( st.time_total ), cec );
+    exp( benchmark, baseline[benchmark], to_seconds( st.time_total ), to_seconds( sweeping_st.time_total ), cec && sweeping_cec && *sweeping_cec );
   }
 
   exp.save();
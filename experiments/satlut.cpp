@@ -30,10 +30,12 @@
 
 #include <fmt/format.h>
 #include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
 #include <mockturtle/algorithms/lut_mapping.hpp>
 #include <mockturtle/algorithms/satlut_mapping.hpp>
 #include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/views/mapping_view.hpp>
 
 #include <experiments.hpp>
@@ -65,7 +67,7 @@ int main()
     {"voter", 2158}
   };
 
-  experiment<std::string, uint32_t, uint32_t, uint32_t, float, bool> exp( "satlut", "benchmark", "cells_baseline", "cells_init", "cells_final", "runtime", "equivalent" );
+  experiment<std::string, uint32_t, uint32_t, uint32_t, float, uint32_t, float, bool> exp( "satlut", "benchmark", "cells_baseline", "cells_init", "cells_final", "runtime", "cells_parallel", "runtime_parallel", "equivalent" );
 
   for ( auto const& benchmark : epfl_benchmarks( ~hyp & ~experiments::div ) )
   {
@@ -73,10 +75,11 @@ int main()
     aig_network aig;
     lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
 
-    mapping_view<aig_network, true> mapped_aig{aig};
     lut_mapping_params ps;
     ps.cut_enumeration_ps.cut_size = 6;
     ps.cut_enumeration_ps.cut_limit = 16;
+
+    mapping_view<aig_network, true> mapped_aig{aig};
     lut_mapping<mapping_view<aig_network, true>, true>( mapped_aig, ps );
     const auto cells_init = mapped_aig.num_cells();
 
@@ -88,10 +91,20 @@ int main()
     satlut_mapping_stats st;
 
     satlut_mapping<mapping_view<aig_network, true>, true>( mapped_aig, 32u, slps, &st );
+    const auto cells_final = mapped_aig.num_cells();
+
+    /* windows with disjoint gates solved concurrently on all hardware threads */
+    mapping_view<aig_network, true> mapped_par{aig};
+    lut_mapping<mapping_view<aig_network, true>, true>( mapped_par, ps );
+
+    slps.num_threads = 0u;
+    satlut_mapping_stats st_par;
+    satlut_mapping<mapping_view<aig_network, true>, true>( mapped_par, 32u, slps, &st_par );
 
-    auto cec = abc_cec( aig, benchmark );
+    auto cec = abc_cec( *collapse_mapped_network<klut_network>( mapped_aig ), benchmark ) &&
+               abc_cec( *collapse_mapped_network<klut_network>( mapped_par ), benchmark );
 
-    exp( benchmark, baseline[benchmark], cells_init, mapped_aig.num_cells(), to_seconds( st.time_total ), cec );
+    exp( benchmark, baseline[benchmark], cells_init, cells_final, to_seconds( st.time_total ), mapped_par.num_cells(), to_seconds( st_par.time_total ), cec );
   }
 
   exp.save();
@@ -0,0 +1,99 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/simulation_engine.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, uint32_t, float, float, float, uint32_t, float, bool> exp( "simulation_engine", "benchmark", "size", "patterns", "partial sim", "engine (1 thread)", "speedup", "threads", "engine (threads)", "same" );
+
+  const auto num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    for ( auto num_patterns : {256u, 4096u} )
+    {
+      partial_simulator sim( aig.num_pis(), num_patterns );
+
+      unordered_node_map<kitty::partial_truth_table, aig_network> expected( aig );
+      stopwatch<>::duration time_partial{0};
+      {
+        stopwatch t( time_partial );
+        simulate_nodes( aig, expected, sim, true );
+      }
+
+      simulation_engine_params ps;
+      simulation_engine engine( aig, ps );
+      stopwatch<>::duration time_engine{0};
+      {
+        stopwatch t( time_engine );
+        engine.run( sim );
+      }
+
+      ps.num_threads = num_threads;
+      simulation_engine engine_mt( aig, ps );
+      stopwatch<>::duration time_engine_mt{0};
+      {
+        stopwatch t( time_engine_mt );
+        engine_mt.run( sim );
+      }
+
+      bool same = true;
+      aig.foreach_gate( [&]( auto const& n ) {
+        same = same && engine.get_signature( n ) == expected[n] && engine_mt.get_signature( n ) == expected[n];
+      } );
+
+      exp( benchmark, aig.num_gates(), num_patterns, to_seconds( time_partial ), to_seconds( time_engine ), to_seconds( time_partial ) / to_seconds( time_engine ), num_threads, to_seconds( time_engine_mt ), same );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/utils/truth_table_cache.hpp>
+
+#include <experiments.hpp>
+
+using namespace mockturtle;
+
+/* previous implementation of the truth table cache, which stores each
+ * truth table as key of a hash map and in a vector */
+template<typename TT>
+class legacy_truth_table_cache
+{
+public:
+  uint32_t insert( TT tt )
+  {
+    uint32_t is_compl{0};
+    if ( kitty::get_bit( tt, 0 ) )
+    {
+      is_compl = 1;
+      tt = ~tt;
+    }
+
+    const auto it = _indexes.find( tt );
+    if ( it != _indexes.end() )
+    {
+      return static_cast<uint32_t>( 2 * it->second + is_compl );
+    }
+
+    const auto size = _data.size();
+    _data.push_back( tt );
+    _indexes[tt] = static_cast<uint32_t>( size );
+    return static_cast<uint32_t>( 2 * size + is_compl );
+  }
+
+  TT operator[]( uint32_t index ) const
+  {
+    auto& entry = _data[index >> 1];
+    return ( index & 1 ) ? ~entry : entry;
+  }
+
+  auto size() const { return _data.size(); }
+
+private:
+  std::unordered_map<TT, uint32_t, kitty::hash<TT>> _indexes;
+  std::vector<TT> _data;
+};
+
+/* inserts all truth tables and looks up each returned literal once */
+template<typename Cache>
+uint64_t insert_and_lookup( Cache& cache, std::vector<kitty::dynamic_truth_table> const& tts )
+{
+  uint64_t checksum{0};
+  for ( auto const& tt : tts )
+  {
+    checksum += *cache[cache.insert( tt )].cbegin() & 1u;
+  }
+  return checksum;
+}
+
+int main()
+{
+  using namespace experiments;
+
+  experiment<uint32_t, uint32_t, uint32_t, float, float, uint32_t, float, bool> exp( "truth_table_cache", "variables", "inserts", "entries", "legacy", "flat", "threads", "concurrent", "consistent" );
+
+  const auto max_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  const auto num_inserts = 200000u;
+
+  for ( auto num_vars : {4u, 6u, 8u, 10u, 12u} )
+  {
+    fmt::print( "[i] processing functions with {} variables\n", num_vars );
+
+    /* repeated functions, similar to the cut functions of a network */
+    std::default_random_engine gen( num_vars );
+    std::vector<kitty::dynamic_truth_table> pool( num_inserts / 8u, kitty::dynamic_truth_table( num_vars ) );
+    for ( auto i = 0u; i < pool.size(); ++i )
+    {
+      kitty::create_random( pool[i], i );
+    }
+    std::geometric_distribution<uint32_t> dist( 32.0 / pool.size() );
+    std::vector<kitty::dynamic_truth_table> tts;
+    tts.reserve( num_inserts );
+    for ( auto i = 0u; i < num_inserts; ++i )
+    {
+      tts.push_back( pool[std::min<uint32_t>( dist( gen ), pool.size() - 1u )] );
+    }
+
+    legacy_truth_table_cache<kitty::dynamic_truth_table> legacy;
+    stopwatch<>::duration time_legacy{0};
+    uint64_t checksum_legacy;
+    {
+      stopwatch t( time_legacy );
+      checksum_legacy = insert_and_lookup( legacy, tts );
+    }
+
+    truth_table_cache<kitty::dynamic_truth_table> flat;
+    stopwatch<>::duration time_flat{0};
+    uint64_t checksum_flat;
+    {
+      stopwatch t( time_flat );
+      checksum_flat = insert_and_lookup( flat, tts );
+    }
+
+    for ( auto num_threads = 1u; num_threads <= max_threads; num_threads *= 2u )
+    {
+      truth_table_cache<kitty::dynamic_truth_table> concurrent;
+      std::vector<uint64_t> checksums( num_threads, 0u );
+      stopwatch<>::duration time_concurrent{0};
+      {
+        stopwatch t( time_concurrent );
+        concurrent.begin_concurrent_insert();
+        std::vector<std::thread> threads;
+        for ( auto i = 0u; i < num_threads; ++i )
+        {
+          threads.emplace_back( [&, i]() {
+            for ( auto j = i; j < tts.size(); j += num_threads )
+            {
+              checksums[i] += *concurrent[concurrent.insert_concurrent( tts[j] )].cbegin() & 1u;
+            }
+          } );
+        }
+        for ( auto& thread : threads )
+        {
+          thread.join();
+        }
+        concurrent.end_concurrent_insert();
+      }
+
+      uint64_t checksum_concurrent{0};
+      for ( auto c : checksums )
+      {
+        checksum_concurrent += c;
+      }
+
+      const auto consistent = legacy.size() == flat.size() && flat.size() == concurrent.size() && checksum_legacy == checksum_flat && checksum_flat == checksum_concurrent;
+      exp( num_vars, num_inserts, static_cast<uint32_t>( flat.size() ), to_seconds( time_legacy ), to_seconds( time_flat ), num_threads, to_seconds( time_concurrent ), consistent );
+    }
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -169,6 +169,12 @@ public:
     return _storage->_window_hash.insert( _storage->_window_mask ).second;
   }
 
+  /*! \brief Returns a hash of the leaves and roots of the current window. */
+  std::array<uint64_t, 2> const& window_hash() const
+  {
+    return _storage->_window_mask;
+  }
+
   uint32_t num_pis() const
   {
     return _storage->_leaves.size();
@@ -184,6 +190,16 @@ public:
     return _storage->_gates.size();
   }
 
+  uint32_t num_cis() const
+  {
+    return num_pis();
+  }
+
+  uint32_t num_cos() const
+  {
+    return num_pos();
+  }
+
   uint32_t num_cells() const
   {
     return _storage->_nodes.size();
@@ -249,6 +265,18 @@ public:
     detail::foreach_element( _storage->_roots.begin(), _storage->_roots.end(), fn );
   }
 
+  template<typename Fn>
+  void foreach_ci( Fn&& fn ) const
+  {
+    foreach_pi( fn );
+  }
+
+  template<typename Fn>
+  void foreach_co( Fn&& fn ) const
+  {
+    foreach_po( fn );
+  }
+
   template<typename Fn>
   void foreach_gate( Fn&& fn ) const
   {
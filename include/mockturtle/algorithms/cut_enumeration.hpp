@@ -36,17 +36,22 @@
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <kitty/constructors.hpp>
+#include <kitty/detail/constants.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
 
 #include <fmt/format.h>
 
 #include "../traits.hpp"
 #include "../utils/cuts.hpp"
 #include "../utils/mixed_radix.hpp"
+#include "../utils/parallel.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/truth_table_cache.hpp"
 
@@ -72,6 +77,14 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{false};
 
+  /*! \brief Number of threads (0 uses all hardware threads).
+   *
+   * With a value other than 1, the nodes of each logic level are distributed
+   * among threads.  The computed cuts and truth table indexes are the same
+   * for every number of threads.
+   */
+  uint32_t num_threads{1u};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 
@@ -142,7 +155,65 @@ namespace detail
 {
 template<typename Ntk, bool ComputeTruth, typename CutData>
 class cut_enumeration_impl;
+
+/* Cut functions with up to 6 variables are stored as 64-bit words, in which
+ * functions with fewer variables are replicated.  Variables are moved with
+ * the precomputed permutation masks from kitty. */
+inline uint64_t swap_word_vars( uint64_t tt, uint8_t var_index1, uint8_t var_index2 )
+{
+  const auto& pmask = kitty::detail::ppermutation_masks[var_index1][var_index2];
+  const auto shift = ( 1 << var_index2 ) - ( 1 << var_index1 );
+  return ( tt & pmask[0] ) | ( ( tt & pmask[1] ) << shift ) | ( ( tt & pmask[2] ) >> shift );
 }
+
+/* moves variable i to position support[i], where support is increasing */
+inline uint64_t stretch_word( uint64_t tt, uint8_t const* support, uint32_t num_vars )
+{
+  for ( auto i = num_vars; i-- > 0u; )
+  {
+    if ( support[i] != i )
+    {
+      tt = swap_word_vars( tt, static_cast<uint8_t>( i ), support[i] );
+    }
+  }
+  return tt;
+}
+
+/* moves variable support[i] to position i, where support is increasing */
+inline uint64_t shrink_word( uint64_t tt, uint8_t const* support, uint32_t num_vars )
+{
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    if ( support[i] != i )
+    {
+      tt = swap_word_vars( tt, static_cast<uint8_t>( i ), support[i] );
+    }
+  }
+  return tt;
+}
+
+inline bool word_has_var( uint64_t tt, uint8_t var_index )
+{
+  return ( ( tt >> ( 1 << var_index ) ) & kitty::detail::projections_neg[var_index] ) != ( tt & kitty::detail::projections_neg[var_index] );
+}
+
+inline uint64_t truth_table_to_word( kitty::dynamic_truth_table const& tt )
+{
+  auto word = *tt.cbegin() & kitty::detail::masks[tt.num_vars()];
+  for ( auto i = tt.num_vars(); i < 6u; ++i )
+  {
+    word |= word << ( 1 << i );
+  }
+  return word;
+}
+
+inline kitty::dynamic_truth_table word_to_truth_table( uint64_t word, uint32_t num_vars )
+{
+  kitty::dynamic_truth_table tt( num_vars );
+  *tt.begin() = word & kitty::detail::masks[num_vars];
+  return tt;
+}
+} // namespace detail
 /*! \endcond */
 
 /*! \brief Cut database for a network.
@@ -164,8 +235,15 @@ public:
   static constexpr bool compute_truth = ComputeTruth;
 
 private:
-  explicit network_cuts( uint32_t size ) : _cuts( size )
+  explicit network_cuts( uint32_t size, bool small_truth_tables = false ) : _cuts( size ), _small( small_truth_tables )
   {
+    if ( _small )
+    {
+      _words.insert( 0u );
+      _words.insert( kitty::detail::projections[0] );
+      return;
+    }
+
     kitty::dynamic_truth_table zero( 0u ), proj( 1u );
     kitty::create_nth_var( proj, 0u );
 
@@ -184,7 +262,11 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
-    return _truth_tables[cut->func_id];
+    if ( _small && !( cut->func_id & large_flag ) )
+    {
+      return detail::word_to_truth_table( lookup_word( cut->func_id ), cut.size() );
+    }
+    return lookup_truth_table( cut->func_id );
   }
 
   /*! \brief Returns the total number of tuples that were tried to be merged */
@@ -236,7 +318,15 @@ public:
    */
   uint32_t insert_truth_table( kitty::dynamic_truth_table const& tt )
   {
-    return _truth_tables.insert( tt );
+    if ( !_small )
+    {
+      return _truth_tables.insert( tt );
+    }
+    if ( tt.num_vars() > 6u )
+    {
+      return large_flag | _truth_tables.insert( tt );
+    }
+    return _words.insert( detail::truth_table_to_word( tt ) );
   }
 
 private:
@@ -247,6 +337,46 @@ private:
   friend network_cuts<_Ntk, _ComputeTruth, _CutData> cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats * pst );
 
 private:
+  /* In parallel cut enumeration, truth tables are added to the cache in node
+   * order after all cuts have been computed.  Until then, the function of a
+   * cut refers to a pending truth table in `_pending`, which all threads
+   * insert into concurrently.  Pending words are first collected by each
+   * thread in the current level (`local_flag`) and then appended to
+   * `_pending_words`. */
+  static constexpr uint32_t pending_flag = UINT32_C( 1 ) << 31;
+  static constexpr uint32_t local_flag = UINT32_C( 1 ) << 30;
+
+  /* When cut functions are stored as words, functions with more than 6
+   * variables that are inserted with `insert_truth_table` are kept in
+   * `_truth_tables` instead. */
+  static constexpr uint32_t large_flag = UINT32_C( 1 ) << 29;
+  static constexpr uint32_t pending_mask = large_flag - 1u;
+
+  kitty::dynamic_truth_table lookup_truth_table( uint32_t func_id ) const
+  {
+    if ( func_id & pending_flag )
+    {
+      return _pending[func_id & pending_mask];
+    }
+    return _truth_tables[func_id & pending_mask];
+  }
+
+  /* pending words are addressed by literals, like words in the cache */
+  uint64_t lookup_word( uint32_t func_id ) const
+  {
+    assert( !( func_id & large_flag ) );
+    if ( func_id & pending_flag )
+    {
+      if ( func_id & local_flag )
+      {
+        return ( *_local_pending_words )[func_id & pending_mask];
+      }
+      const auto lit = func_id & pending_mask;
+      return ( lit & 1 ) ? ~_pending_words[lit >> 1] : _pending_words[lit >> 1];
+    }
+    return _words[func_id];
+  }
+
   void add_zero_cut( uint32_t index )
   {
     auto& cut = _cuts[index].add_cut( &index, &index ); /* fake iterator for emptyness */
@@ -272,7 +402,14 @@ private:
   std::vector<cut_set_t> _cuts;
 
   /* cut truth tables */
+  bool _small{false};
   truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
+  truth_table_cache<uint64_t> _words;
+
+  /* truth tables not yet in the cache (parallel cut enumeration) */
+  truth_table_cache<kitty::dynamic_truth_table> _pending;
+  std::vector<uint64_t> _pending_words;
+  inline static thread_local truth_table_cache<uint64_t> const* _local_pending_words = nullptr;
 
   /* statistics */
   uint32_t _total_tuples{};
@@ -287,8 +424,9 @@ template<typename Ntk, bool ComputeTruth, typename CutData>
 class cut_enumeration_impl
 {
 public:
-  using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
-  using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+  using network_cuts_t = network_cuts<Ntk, ComputeTruth, CutData>;
+  using cut_t = typename network_cuts_t::cut_t;
+  using cut_set_t = typename network_cuts_t::cut_set_t;
 
   explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
@@ -304,7 +442,14 @@ public:
   {
     stopwatch t( st.time_total );
 
-    ntk.foreach_node( [this]( auto node ) {
+    if ( ps.num_threads != 1u )
+    {
+      run_parallel( resolve_num_threads( ps.num_threads ) );
+      return;
+    }
+
+    worker w;
+    ntk.foreach_node( [&]( auto node ) {
       const auto index = ntk.node_to_index( node );
 
       if ( ps.very_verbose )
@@ -312,38 +457,248 @@ public:
         std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
       }
 
-      if ( ntk.is_constant( node ) )
+      compute_cuts( w, index );
+    } );
+    add_stats( w );
+  }
+
+private:
+  /* state of one thread */
+  struct worker
+  {
+    std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+
+    /* parallel mode: words computed by this thread in the current level */
+    bool parallel{false};
+    truth_table_cache<uint64_t> words{64u};
+
+    /* fanin functions when cut functions are stored as words */
+    std::vector<kitty::static_truth_table<6>> fanin_words;
+
+    uint32_t total_tuples{0};
+    std::size_t total_cuts{0};
+    stopwatch<>::duration time_truth_table{0};
+  };
+
+  void add_stats( worker const& w )
+  {
+    cuts._total_tuples += w.total_tuples;
+    cuts._total_cuts += w.total_cuts;
+    st.time_truth_table += w.time_truth_table;
+  }
+
+  void compute_cuts( worker& w, uint32_t index )
+  {
+    const auto node = ntk.index_to_node( index );
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+      {
+        merge_cuts2( w, index );
+      }
+      else
+      {
+        merge_cuts( w, index );
+      }
+    }
+  }
+
+  /* Nodes of the same level are independent and distributed among threads.
+   * Threads insert the truth tables they compute concurrently into the
+   * pending truth tables.  Words are collected by each thread in a level in
+   * its own cache and appended to the pending words after each level.  After
+   * the last level all pending truth tables are inserted into the cache in
+   * the same order as in the sequential algorithm. */
+  void run_parallel( uint32_t num_threads )
+  {
+    std::vector<uint32_t> level( ntk.size(), 0u );
+    std::vector<std::vector<uint32_t>> levels( 1u );
+    ntk.foreach_node( [&]( auto node ) {
+      const auto index = ntk.node_to_index( node );
+      if ( !ntk.is_constant( node ) && !ntk.is_pi( node ) )
       {
-        cuts.add_zero_cut( index );
+        ntk.foreach_fanin( node, [&]( auto const& f ) {
+          level[index] = std::max( level[index], level[ntk.node_to_index( ntk.get_node( f ) )] + 1u );
+        } );
       }
-      else if ( ntk.is_pi( node ) )
+      if ( level[index] >= levels.size() )
       {
-        cuts.add_unit_cut( index );
+        levels.resize( level[index] + 1u );
       }
-      else
+      levels[level[index]].push_back( index );
+    } );
+
+    if constexpr ( ComputeTruth )
+    {
+      sequences.resize( ntk.size() );
+      if ( !cuts._small )
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+        cuts._pending.begin_concurrent_insert();
+      }
+    }
+
+    std::vector<worker> workers( num_threads );
+    for ( auto& w : workers )
+    {
+      w.parallel = true;
+    }
+
+    spin_barrier barrier( num_threads );
+    run_on_threads( num_threads, [&]( uint32_t t ) {
+      auto& w = workers[t];
+      network_cuts_t::_local_pending_words = &w.words;
+
+      for ( auto const& nodes : levels )
+      {
+        const auto [begin, end] = thread_range( nodes.size(), t, num_threads );
+        for ( auto i = begin; i < end; ++i )
         {
-          merge_cuts2( index );
+          compute_cuts( w, nodes[i] );
         }
-        else
+
+        barrier.wait();
+        if ( t == 0u )
         {
-          merge_cuts( index );
+          publish_truth_tables( nodes, workers );
         }
+        barrier.wait();
       }
+
+      network_cuts_t::_local_pending_words = nullptr;
     } );
+
+    commit_truth_tables();
+    for ( auto const& w : workers )
+    {
+      add_stats( w );
+    }
   }
 
-private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  /* moves the words computed in the last level into the pending words */
+  void publish_truth_tables( std::vector<uint32_t> const& nodes, std::vector<worker>& workers )
+  {
+    if constexpr ( ComputeTruth )
+    {
+      if ( !cuts._small )
+      {
+        return;
+      }
+
+      for ( auto t = 0u; t < workers.size(); ++t )
+      {
+        auto& w = workers[t];
+        const auto offset = static_cast<uint32_t>( cuts._pending_words.size() );
+        const auto lit_offset = 2u * offset;
+        for ( auto i = 0u; i < w.words.size(); ++i )
+        {
+          cuts._pending_words.push_back( w.words[2u * i] );
+        }
+        w.words.clear();
+
+        const auto [begin, end] = thread_range( nodes.size(), t, static_cast<uint32_t>( workers.size() ) );
+        for ( auto i = begin; i < end; ++i )
+        {
+          for ( auto& id : sequences[nodes[i]] )
+          {
+            id += offset;
+          }
+          for ( auto* cut : cuts.cuts( nodes[i] ) )
+          {
+            if ( ( *cut )->func_id & network_cuts_t::local_flag )
+            {
+              ( *cut )->func_id = network_cuts_t::pending_flag | ( ( ( *cut )->func_id & network_cuts_t::pending_mask ) + lit_offset );
+            }
+          }
+        }
+      }
+    }
+    else
+    {
+      (void)nodes;
+      (void)workers;
+    }
+  }
+
+  void commit_truth_tables()
+  {
+    if constexpr ( ComputeTruth )
+    {
+      std::vector<uint32_t> func_ids( cuts._small ? cuts._pending_words.size() : cuts._pending.size() );
+      ntk.foreach_node( [&]( auto node ) {
+        for ( auto id : sequences[ntk.node_to_index( node )] )
+        {
+          func_ids[id] = cuts._small ? cuts._words.insert( cuts._pending_words[id] ) : cuts._truth_tables.insert( cuts._pending[2u * id] );
+        }
+      } );
+
+      ntk.foreach_node( [&]( auto node ) {
+        for ( auto* cut : cuts.cuts( ntk.node_to_index( node ) ) )
+        {
+          if ( ( *cut )->func_id & network_cuts_t::pending_flag )
+          {
+            /* pending truth tables are addressed by literals */
+            const auto id = ( *cut )->func_id & network_cuts_t::pending_mask;
+            ( *cut )->func_id = func_ids[id >> 1] ^ ( id & 1u );
+          }
+        }
+      } );
+
+      cuts._pending = truth_table_cache<kitty::dynamic_truth_table>();
+      std::vector<uint64_t>().swap( cuts._pending_words );
+      std::vector<std::vector<uint32_t>>().swap( sequences );
+    }
+  }
+
+  uint32_t insert_truth_table( worker& w, uint32_t index, kitty::dynamic_truth_table const& tt )
+  {
+    if ( !w.parallel )
+    {
+      return cuts._truth_tables.insert( tt );
+    }
+
+    const auto lit = cuts._pending.insert_concurrent( tt );
+    sequences[index].push_back( lit >> 1 );
+    return network_cuts_t::pending_flag | lit;
+  }
+
+  uint32_t insert_word( worker& w, uint32_t index, uint64_t tt )
+  {
+    if ( !w.parallel )
+    {
+      return cuts._words.insert( tt );
+    }
+
+    const auto lit = w.words.insert( tt );
+    sequences[index].push_back( lit >> 1 );
+    return network_cuts_t::pending_flag | network_cuts_t::local_flag | lit;
+  }
+
+  uint32_t compute_truth_table( worker& w, uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
   {
-    stopwatch t( st.time_truth_table );
+    if constexpr ( has_compute_v<Ntk, kitty::static_truth_table<6>> )
+    {
+      if ( cuts._small )
+      {
+        return compute_word( w, index, vcuts, res );
+      }
+    }
+
+    stopwatch t( w.time_truth_table );
 
     std::vector<kitty::dynamic_truth_table> tt( vcuts.size() );
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = kitty::extend_to( cuts._truth_tables[( *cut )->func_id], res.size() );
+      tt[i] = kitty::extend_to( cuts.lookup_truth_table( ( *cut )->func_id ), res.size() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -367,19 +722,78 @@ private:
           *it_leaves++ = leaves_before[*it_support++];
         }
         res.set_leaves( leaves_after.begin(), leaves_after.end() );
-        return cuts._truth_tables.insert( tt_res_shrink );
+        return insert_truth_table( w, index, tt_res_shrink );
+      }
+    }
+
+    return insert_truth_table( w, index, tt_res );
+  }
+
+  /* same as compute_truth_table for cut functions stored as words, without
+   * allocating memory per cut */
+  uint32_t compute_word( worker& w, uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  {
+    stopwatch t( w.time_truth_table );
+
+    std::array<uint8_t, 6> support;
+    w.fanin_words.resize( vcuts.size() );
+    auto i = 0u;
+    for ( auto const& cut : vcuts )
+    {
+      /* positions of the cut's leaves in the leaves of res */
+      auto itp = res.begin();
+      auto j = 0u;
+      for ( auto leaf : *cut )
+      {
+        while ( *itp != leaf )
+        {
+          ++itp;
+        }
+        support[j++] = static_cast<uint8_t>( std::distance( res.begin(), itp ) );
+      }
+      w.fanin_words[i++]._bits = stretch_word( cuts.lookup_word( ( *cut )->func_id ), support.data(), j );
+    }
+
+    auto tt_res = ntk.compute( ntk.index_to_node( index ), w.fanin_words.begin(), w.fanin_words.end() )._bits;
+
+    if ( ps.minimize_truth_table )
+    {
+      auto num_vars = 0u;
+      for ( auto v = 0u; v < res.size(); ++v )
+      {
+        if ( word_has_var( tt_res, static_cast<uint8_t>( v ) ) )
+        {
+          support[num_vars++] = static_cast<uint8_t>( v );
+        }
+      }
+
+      if ( num_vars != res.size() )
+      {
+        tt_res = shrink_word( tt_res, support.data(), num_vars );
+
+        std::array<uint32_t, 6> leaves;
+        auto it_leaves = res.begin();
+        for ( auto v = 0u, k = 0u; v < res.size(); ++v, ++it_leaves )
+        {
+          if ( k < num_vars && support[k] == v )
+          {
+            leaves[k++] = *it_leaves;
+          }
+        }
+        res.set_leaves( leaves.begin(), leaves.begin() + num_vars );
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return insert_word( w, index, tt_res );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( worker& w, uint32_t index )
   {
     const auto fanin = 2;
+    auto& lcuts = w.lcuts;
 
     uint32_t pairs{1};
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -391,7 +805,7 @@ private:
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
+    w.total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -410,7 +824,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( w, index, vcuts, new_cut );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -422,7 +836,7 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    w.total_cuts += rcuts.size();
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -430,11 +844,13 @@ private:
     }
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( worker& w, uint32_t index )
   {
+    auto& lcuts = w.lcuts;
+
     uint32_t pairs{1};
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &lcuts, &pairs, &cut_sizes]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -453,7 +869,7 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      w.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
@@ -483,7 +899,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( w, index, vcuts, new_cut );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -503,7 +919,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, {cut}, new_cut );
+          new_cut->func_id = compute_truth_table( w, index, {cut}, new_cut );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -515,7 +931,7 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    w.total_cuts += static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -526,7 +942,8 @@ private:
   cut_enumeration_stats& st;
   network_cuts<Ntk, ComputeTruth, CutData>& cuts;
 
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  /* parallel mode: pending truth tables computed for each node, in order */
+  std::vector<std::vector<uint32_t>> sequences;
 };
 } /* namespace detail */
 /*! \endcond */
@@ -591,7 +1008,9 @@ network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_en
   static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
 
   cut_enumeration_stats st;
-  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
+  /* store cut functions as words if the network can compute them */
+  constexpr bool compute_words = has_compute_v<Ntk, kitty::static_truth_table<6>>;
+  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size(), ComputeTruth && compute_words && ps.cut_size <= 6u );
   detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, ps, st, res );
   p.run();
 
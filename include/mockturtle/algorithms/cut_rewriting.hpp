@@ -32,12 +32,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <set>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include "../networks/klut.hpp"
@@ -45,6 +50,7 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cut_view.hpp"
@@ -100,6 +106,16 @@ struct cut_rewriting_params
   /*! \brief If true, candidates are only accepted if they do not increase logic level of node. */
   bool preserve_depth{false};
 
+  /*! \brief Number of threads to evaluate candidates (0 uses all hardware threads).
+   *
+   * Only used by `cut_rewriting_with_compatibility_graph`.  With more than
+   * one thread, candidates are built in thread-local scratch networks and
+   * only the selected replacements are added to the network.  The rewriting
+   * function is then called concurrently and must be thread-safe.  Ignored
+   * when `use_dont_cares` is set.
+   */
+  uint32_t num_threads{1u};
+
   /*! \brief Show progress. */
   bool progress{false};
 
@@ -412,6 +428,15 @@ public:
       ntk.set_value( n, ntk.fanout_size( n ) );
     } );
 
+    if constexpr ( supports_speculation )
+    {
+      if ( ps.num_threads != 1u && !ps.use_dont_cares )
+      {
+        run_speculative( cuts );
+        return;
+      }
+    }
+
     /* store best replacement for each cut */
     node_map<std::vector<signal<Ntk>>, Ntk> best_replacements( ntk );
 
@@ -554,6 +579,456 @@ public:
   }
 
 private:
+  static constexpr bool supports_speculation = std::is_constructible_v<Ntk, typename Ntk::base_type> && has_clone_node_v<Ntk>;
+
+  /* candidate structures that match an existing gate are looked up in the fanout of its fanins */
+  static constexpr bool supports_structural_lookup = has_foreach_fanout_v<Ntk> && Ntk::max_fanin_size <= 3u;
+
+  /* thread-local state to evaluate candidates without modifying the network */
+  struct speculation_worker
+  {
+    explicit speculation_worker( std::vector<int32_t> const& refs )
+        : scratch( scratch_base ),
+          refs( refs ) {}
+
+    /* views may keep a reference to the network they are constructed from */
+    typename Ntk::base_type scratch_base;
+    Ntk scratch;
+    std::vector<signal<Ntk>> pis;
+
+    /* reference counters of the network, copied from the fanout sizes */
+    std::vector<int32_t> refs;
+    std::vector<node<Ntk>> deref_trail;
+    std::vector<node<Ntk>> ref_trail;
+    std::vector<node<Ntk>> scratch_trail;
+
+    /* existing signal in the network for each node in the scratch network */
+    std::vector<signal<Ntk>> existing;
+    std::vector<uint8_t> has_existing;
+    std::vector<uint32_t> visited;
+    uint32_t trav_id{0u};
+  };
+
+  struct speculative_replacement
+  {
+    uint32_t worker;
+    signal<Ntk> f; /* signal in the scratch network of the worker */
+    std::vector<node<Ntk>> leaves;
+  };
+
+  template<class Cuts>
+  void run_speculative( Cuts const& cuts )
+  {
+    const auto num_threads = resolve_num_threads( ps.num_threads );
+    const auto size = ntk.size();
+
+    std::vector<int32_t> refs( size, 0 );
+    ntk.foreach_node( [&]( auto const& n ) {
+      refs[ntk.node_to_index( n )] = ntk.fanout_size( n );
+    } );
+
+    std::vector<std::unique_ptr<speculation_worker>> workers;
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      workers.emplace_back( std::make_unique<speculation_worker>( refs ) );
+    }
+
+    /* evaluate all cuts of the original nodes, workers fetch chunks of nodes */
+    node_map<std::vector<speculative_replacement>, Ntk> best_replacements( ntk );
+    std::atomic<uint32_t> next_index{0u};
+    call_with_stopwatch( st.time_rewriting, [&]() {
+      run_on_threads( num_threads, [&]( uint32_t t ) {
+        constexpr uint32_t chunk_size = 64u;
+        while ( true )
+        {
+          const auto begin = next_index.fetch_add( chunk_size );
+          if ( begin >= size )
+            break;
+          for ( auto index = begin; index < std::min<uint32_t>( begin + chunk_size, size ); ++index )
+          {
+            const auto n = ntk.index_to_node( index );
+            if ( ntk.is_constant( n ) || ntk.is_pi( n ) || is_dead_node( n ) )
+              continue;
+            evaluate_node( *workers[t], t, n, cuts, best_replacements[n] );
+          }
+        }
+      } );
+    } );
+
+    stopwatch t2( st.time_mis );
+    auto [g, map] = network_cuts_graph( ntk, cuts, ps );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << "[i] replacement dependency graph has " << g.num_vertices() << " vertices and " << g.num_edges() << " edges\n";
+    }
+
+    const auto is = ( ps.candidate_selection_strategy == cut_rewriting_params::minimize_weight ) ? maximum_weighted_independent_set_gwmin( g ) : maximal_weighted_independent_set( g );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << "[i] size of independent set is " << is.size() << "\n";
+    }
+
+    /* only the selected candidates are copied into the network */
+    std::unordered_map<node<Ntk>, signal<Ntk>> substitutions;
+    for ( const auto v : is )
+    {
+      const auto v_node = map[v].first;
+      const auto v_cut = map[v].second;
+
+      if ( best_replacements[v_node].empty() || is_dead_node( v_node ) )
+        continue;
+
+      const auto& cand = best_replacements[v_node][v_cut];
+
+      /* leaves may have been substituted by previous replacements */
+      std::vector<signal<Ntk>> leaves;
+      for ( auto const& l : cand.leaves )
+      {
+        if ( const auto f = resolve_substitution( l, substitutions ); f )
+        {
+          leaves.push_back( *f );
+        }
+        else
+        {
+          break;
+        }
+      }
+      if ( leaves.size() != cand.leaves.size() )
+        continue;
+
+      const auto replacement = insert_replacement( *workers[cand.worker], cand.f, leaves );
+
+      if ( ntk.is_constant( ntk.get_node( replacement ) ) || v_node == ntk.get_node( replacement ) )
+        continue;
+
+      if ( ps.very_verbose )
+      {
+        std::cout << "[i] optimize cut #" << v_cut << " in node #" << ntk.node_to_index( v_node ) << " and replace with node " << ntk.node_to_index( ntk.get_node( replacement ) ) << "\n";
+      }
+
+      ntk.substitute_node( v_node, replacement );
+      substitutions[v_node] = replacement;
+    }
+  }
+
+  template<class Cuts>
+  void evaluate_node( speculation_worker& w, uint32_t worker_index, node<Ntk> const& n, Cuts const& cuts, std::vector<speculative_replacement>& best_replacements )
+  {
+    const auto [value, num_nodes] = speculative_deref( w, n );
+
+    /* skip cuts with small MFFC */
+    if ( num_nodes != 1u )
+    {
+      /* foreach cut */
+      for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+      {
+        /* skip trivial cuts */
+        if ( cut->size() < ps.min_cand_cut_size )
+          continue;
+
+        std::vector<node<Ntk>> leaves;
+        for ( auto l : *cut )
+        {
+          leaves.push_back( ntk.index_to_node( l ) );
+        }
+        while ( w.pis.size() < leaves.size() )
+        {
+          w.pis.push_back( w.scratch.create_pi() );
+        }
+
+        int32_t best_gain{-1};
+        const auto on_signal = [&]( auto const& f_new ) {
+          auto [v, contains] = speculative_ref_contains( w, f_new, leaves, n );
+
+          int32_t gain = contains ? -1 : value - v;
+
+          if ( gain > 0 || ( ps.allow_zero_gain && gain == 0 ) )
+          {
+            if ( best_gain == -1 )
+            {
+              ( *cut )->data.gain = best_gain = gain;
+              best_replacements.push_back( {worker_index, f_new, leaves} );
+            }
+            else if ( gain > best_gain )
+            {
+              ( *cut )->data.gain = best_gain = gain;
+              best_replacements.back().f = f_new;
+            }
+          }
+
+          return true;
+        };
+
+        rewriting_fn( w.scratch, cuts.truth_table( *cut ), w.pis.begin(), w.pis.begin() + leaves.size(), on_signal );
+      }
+    }
+
+    for ( auto const& c : w.deref_trail )
+    {
+      ++w.refs[ntk.node_to_index( c )];
+    }
+    w.deref_trail.clear();
+  }
+
+  /* same as `recursive_deref`, but on the local reference counters, also returns the number of nodes */
+  std::pair<int32_t, uint32_t> speculative_deref( speculation_worker& w, node<Ntk> const& n )
+  {
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      return {0, 0u};
+
+    int32_t value = NodeCostFn{}( ntk, n );
+    uint32_t num_nodes{1u};
+    ntk.foreach_fanin( n, [&]( auto const& s ) {
+      const auto c = ntk.get_node( s );
+      w.deref_trail.push_back( c );
+      if ( --w.refs[ntk.node_to_index( c )] == 0 )
+      {
+        const auto [v, k] = speculative_deref( w, c );
+        value += v;
+        num_nodes += k;
+      }
+    } );
+    return {value, num_nodes};
+  }
+
+  /* same as `recursive_ref_contains` for a candidate in the scratch network, gates that exist in the network are not counted as new */
+  std::pair<int32_t, bool> speculative_ref_contains( speculation_worker& w, signal<Ntk> const& f, std::vector<node<Ntk>> const& leaves, node<Ntk> const& repl )
+  {
+    auto& scratch = w.scratch;
+    w.existing.resize( scratch.size() );
+    w.has_existing.resize( scratch.size() );
+    w.visited.resize( scratch.size(), 0u );
+    ++w.trav_id;
+
+    for ( auto i = 0u; i < leaves.size(); ++i )
+    {
+      const auto index = scratch.node_to_index( scratch.get_node( w.pis[i] ) );
+      w.visited[index] = w.trav_id;
+      w.has_existing[index] = 1u;
+      w.existing[index] = ntk.make_signal( leaves[i] );
+    }
+    map_to_existing( w, scratch.get_node( f ) );
+
+    const auto index = scratch.node_to_index( scratch.get_node( f ) );
+    const auto result = w.has_existing[index] ? existing_ref_contains( w, ntk.get_node( w.existing[index] ), repl ) : scratch_ref_contains( w, scratch.get_node( f ), repl );
+
+    for ( auto const& c : w.ref_trail )
+    {
+      --w.refs[ntk.node_to_index( c )];
+    }
+    w.ref_trail.clear();
+    for ( auto const& c : w.scratch_trail )
+    {
+      scratch.set_value( c, 0u );
+    }
+    w.scratch_trail.clear();
+
+    return result;
+  }
+
+  void map_to_existing( speculation_worker& w, node<Ntk> const& n )
+  {
+    auto& scratch = w.scratch;
+    const auto index = scratch.node_to_index( n );
+    if ( w.visited[index] == w.trav_id )
+      return;
+    w.visited[index] = w.trav_id;
+    w.has_existing[index] = 0u;
+
+    if ( scratch.is_constant( n ) )
+    {
+      w.has_existing[index] = 1u;
+      w.existing[index] = ntk.get_constant( scratch.constant_value( n ) );
+      return;
+    }
+    if ( scratch.is_pi( n ) )
+      return;
+
+    bool all_existing{true};
+    scratch.foreach_fanin( n, [&]( auto const& s ) {
+      map_to_existing( w, scratch.get_node( s ) );
+      all_existing = all_existing && w.has_existing[scratch.node_to_index( scratch.get_node( s ) )];
+    } );
+
+    if constexpr ( supports_structural_lookup )
+    {
+      if ( !all_existing )
+        return;
+
+      const auto literal = [&]( signal<Ntk> const& s ) {
+        return ( static_cast<uint64_t>( ntk.node_to_index( ntk.get_node( s ) ) ) << 1 ) | ( ntk.is_complemented( s ) ? 1u : 0u );
+      };
+      const auto sort_literals = []( std::array<uint64_t, 3>& literals ) {
+        if ( literals[0] > literals[1] )
+          std::swap( literals[0], literals[1] );
+        if ( literals[1] > literals[2] )
+          std::swap( literals[1], literals[2] );
+        if ( literals[0] > literals[1] )
+          std::swap( literals[0], literals[1] );
+      };
+
+      std::array<uint64_t, 3> key{};
+      uint32_t num_fanins{0u};
+      std::optional<node<Ntk>> pivot;
+      scratch.foreach_fanin( n, [&]( auto const& s ) {
+        const auto e = w.existing[scratch.node_to_index( scratch.get_node( s ) )];
+        const auto c = scratch.is_complemented( s ) ? ntk.create_not( e ) : e;
+        key[num_fanins++] = literal( c );
+        if ( !ntk.is_constant( ntk.get_node( c ) ) && ( !pivot || ntk.fanout_size( ntk.get_node( c ) ) < ntk.fanout_size( *pivot ) ) )
+        {
+          pivot = ntk.get_node( c );
+        }
+      } );
+      if ( !pivot )
+        return;
+      sort_literals( key );
+
+      const auto function = scratch.node_function( n );
+      ntk.foreach_fanout( *pivot, [&]( auto const& o ) {
+        if ( ntk.fanin_size( o ) != num_fanins )
+          return true;
+
+        std::array<uint64_t, 3> other{};
+        ntk.foreach_fanin( o, [&]( auto const& s, auto i ) {
+          other[i] = literal( s );
+        } );
+        sort_literals( other );
+        if ( other != key || ntk.node_function( o ) != function )
+          return true;
+
+        w.has_existing[index] = 1u;
+        w.existing[index] = ntk.make_signal( o );
+        return false;
+      } );
+    }
+    else
+    {
+      (void)all_existing;
+    }
+  }
+
+  std::pair<int32_t, bool> existing_ref_contains( speculation_worker& w, node<Ntk> const& n, node<Ntk> const& repl )
+  {
+    /* terminate? */
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      return {0, false};
+
+    /* recursively collect nodes */
+    int32_t value = cost_fn( ntk, n );
+    bool contains = ( n == repl );
+    ntk.foreach_fanin( n, [&]( auto const& s ) {
+      const auto c = ntk.get_node( s );
+      contains = contains || ( c == repl );
+      w.ref_trail.push_back( c );
+      if ( w.refs[ntk.node_to_index( c )]++ == 0 )
+      {
+        const auto [v, cc] = existing_ref_contains( w, c, repl );
+        value += v;
+        contains = contains || cc;
+      }
+    } );
+    return {value, contains};
+  }
+
+  std::pair<int32_t, bool> scratch_ref_contains( speculation_worker& w, node<Ntk> const& n, node<Ntk> const& repl )
+  {
+    auto& scratch = w.scratch;
+
+    /* terminate? */
+    if ( scratch.is_constant( n ) || scratch.is_pi( n ) )
+      return {0, false};
+
+    /* recursively collect nodes */
+    int32_t value = cost_fn( scratch, n );
+    bool contains{false};
+    scratch.foreach_fanin( n, [&]( auto const& s ) {
+      const auto c = scratch.get_node( s );
+      const auto index = scratch.node_to_index( c );
+      if ( w.has_existing[index] )
+      {
+        const auto e = ntk.get_node( w.existing[index] );
+        contains = contains || ( e == repl );
+        w.ref_trail.push_back( e );
+        if ( w.refs[ntk.node_to_index( e )]++ == 0 )
+        {
+          const auto [v, cc] = existing_ref_contains( w, e, repl );
+          value += v;
+          contains = contains || cc;
+        }
+      }
+      else if ( scratch.incr_value( c ) == 0 )
+      {
+        w.scratch_trail.push_back( c );
+        const auto [v, cc] = scratch_ref_contains( w, c, repl );
+        value += v;
+        contains = contains || cc;
+      }
+    } );
+    return {value, contains};
+  }
+
+  /* copies the candidate structure of a worker into the network */
+  signal<Ntk> insert_replacement( speculation_worker& w, signal<Ntk> const& f, std::vector<signal<Ntk>> const& leaves )
+  {
+    std::unordered_map<node<Ntk>, signal<Ntk>> old_to_new;
+    for ( auto i = 0u; i < leaves.size(); ++i )
+    {
+      old_to_new[w.scratch.get_node( w.pis[i] )] = leaves[i];
+    }
+    const auto s = copy_scratch_node( w, w.scratch.get_node( f ), old_to_new );
+    return w.scratch.is_complemented( f ) ? ntk.create_not( s ) : s;
+  }
+
+  signal<Ntk> copy_scratch_node( speculation_worker& w, node<Ntk> const& n, std::unordered_map<node<Ntk>, signal<Ntk>>& old_to_new )
+  {
+    if ( const auto it = old_to_new.find( n ); it != old_to_new.end() )
+    {
+      return it->second;
+    }
+    if ( w.scratch.is_constant( n ) )
+    {
+      return ntk.get_constant( w.scratch.constant_value( n ) );
+    }
+
+    std::vector<signal<Ntk>> children;
+    w.scratch.foreach_fanin( n, [&]( auto const& s ) {
+      const auto c = copy_scratch_node( w, w.scratch.get_node( s ), old_to_new );
+      children.push_back( w.scratch.is_complemented( s ) ? ntk.create_not( c ) : c );
+    } );
+    const auto f = ntk.clone_node( w.scratch, n, children );
+    old_to_new[n] = f;
+    return f;
+  }
+
+  std::optional<signal<Ntk>> resolve_substitution( node<Ntk> const& n, std::unordered_map<node<Ntk>, signal<Ntk>> const& substitutions ) const
+  {
+    auto f = ntk.make_signal( n );
+    while ( is_dead_node( ntk.get_node( f ) ) )
+    {
+      const auto it = substitutions.find( ntk.get_node( f ) );
+      if ( it == substitutions.end() )
+        return std::nullopt;
+      f = ntk.is_complemented( f ) ? ntk.create_not( it->second ) : it->second;
+    }
+    return f;
+  }
+
+  bool is_dead_node( node<Ntk> const& n ) const
+  {
+    if constexpr ( std::is_same_v<typename Ntk::base_type, klut_network> )
+    {
+      /* substituted nodes are not removed from k-LUT networks */
+      (void)n;
+      return false;
+    }
+    else
+    {
+      return ntk.is_dead( n );
+    }
+  }
+
   std::pair<int32_t, bool> recursive_ref_contains( node<Ntk> const& n, node<Ntk> const& repl )
   {
     /* terminate? */
@@ -32,12 +32,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
-#include <bill/sat/interface/glucose.hpp>
+#include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/common.hpp>
+#include <bill/sat/interface/ghack.hpp>
+#include <bill/sat/interface/glucose.hpp>
 #include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
@@ -48,6 +54,7 @@
 #include "../generators/sorting.hpp"
 #include "../io/write_verilog.hpp"
 #include "../networks/xag.hpp"
+#include "../utils/parallel.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cnf_view.hpp"
@@ -56,6 +63,20 @@
 namespace mockturtle
 {
 
+/*! \brief Solver configuration for portfolio-based exact MC synthesis. */
+struct exact_mc_synthesis_config
+{
+  /*! \brief SAT solver.
+   *
+   * Supported are glucose_41, ghack, and bsat2; other solvers are replaced
+   * by the solver given as template argument.
+   */
+  bill::solvers solver{bill::solvers::glucose_41};
+
+  /*! \brief Use CEGAR based solving strategy. */
+  bool use_cegar{false};
+};
+
 struct exact_mc_synthesis_params
 {
   /* \brief Minimum number of AND gates. */
@@ -94,6 +115,22 @@ struct exact_mc_synthesis_params
    */
   bool ignore_conflict_limit_for_first_solution{false};
 
+  /*! \brief Number of configurations solved in parallel (0 uses all hardware threads).
+   *
+   * If different from 1, the first ``num_threads`` configurations of
+   * ``portfolio`` race against each other and the result of the first one
+   * to finish is returned.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Configurations for portfolio solving.
+   *
+   * If empty, the solver given as template argument with and without CEGAR
+   * (the latter only when searching for a single solution) is raced against
+   * the remaining supported solvers.
+   */
+  std::vector<exact_mc_synthesis_config> portfolio;
+
   /*! \brief Show progress (in CEGAR). */
   bool progress{false};
 
@@ -139,14 +176,15 @@ struct exact_mc_synthesis_impl
 {
   using problem_network_t = cnf_view<xag_network, false, Solver>;
 
-  exact_mc_synthesis_impl( kitty::dynamic_truth_table const& func, uint32_t num_solutions, exact_mc_synthesis_params const& ps, exact_mc_synthesis_stats& st )
+  exact_mc_synthesis_impl( kitty::dynamic_truth_table const& func, uint32_t num_solutions, exact_mc_synthesis_params const& ps, exact_mc_synthesis_stats& st, std::atomic<bool> const* stop = nullptr )
       : num_vars_( func.num_vars() ),
         func_( kitty::get_bit( func, 0 ) ? ~func : func ),
         invert_( kitty::get_bit( func, 0 ) ),
         heuristic_xor_bound_( ps.heuristic_xor_bound ),
         num_solutions_( num_solutions ),
         ps_( ps ),
-        st_( st )
+        st_( st ),
+        stop_( stop )
   {
   }
 
@@ -207,6 +245,10 @@ struct exact_mc_synthesis_impl
         }
         return ntks;
       }
+      if ( stop_ && stop_->load( std::memory_order_relaxed ) )
+      {
+        return {};
+      }
       ++num_ands;
     }
   }
@@ -282,7 +324,8 @@ private:
         assumptions.push_back( pntk.lit( !xor_counter_[pos] ) );
       }
     }
-    const auto res = pntk.solve( assumptions, ps_.ignore_conflict_limit_for_first_solution && first ? 0u : ps_.conflict_limit );
+    const auto limit = ps_.ignore_conflict_limit_for_first_solution && first ? 0u : ps_.conflict_limit;
+    const auto res = stop_ ? solve_sliced( pntk, assumptions, limit ) : pntk.solve( assumptions, limit );
 
     if ( ps_.auto_update_xor_bound && res && *res )
     {
@@ -292,6 +335,27 @@ private:
     return res;
   }
 
+  /* solves in growing conflict slices, such that a portfolio run can be stopped */
+  std::optional<bool> solve_sliced( problem_network_t& pntk, bill::result::clause_type const& assumptions, uint32_t limit )
+  {
+    uint32_t used{0u}, slice{1000u};
+    while ( !stop_->load( std::memory_order_relaxed ) )
+    {
+      const auto budget = limit == 0u ? slice : std::min( slice, limit - used );
+      if ( const auto res = pntk.solve( assumptions, budget ); res )
+      {
+        return res;
+      }
+      used += budget;
+      if ( limit != 0u && used >= limit )
+      {
+        break;
+      }
+      slice = std::min( 2u * slice, 1u << 20u );
+    }
+    return std::nullopt;
+  }
+
 private:
   Ntk extract_network( problem_network_t& pntk )
   {
@@ -594,15 +658,90 @@ private:
   uint32_t num_solutions_;
   exact_mc_synthesis_params const& ps_;
   exact_mc_synthesis_stats& st_;
+  std::atomic<bool> const* stop_{nullptr};
 };
 
+template<bill::solvers Fallback, class Fn>
+void dispatch_exact_mc_solver( bill::solvers solver, Fn&& fn )
+{
+  switch ( solver )
+  {
+  case bill::solvers::glucose_41:
+    fn( std::integral_constant<bill::solvers, bill::solvers::glucose_41>{} );
+    break;
+  case bill::solvers::ghack:
+    fn( std::integral_constant<bill::solvers, bill::solvers::ghack>{} );
+    break;
+  case bill::solvers::bsat2:
+    fn( std::integral_constant<bill::solvers, bill::solvers::bsat2>{} );
+    break;
+  default:
+    fn( std::integral_constant<bill::solvers, Fallback>{} );
+    break;
+  }
+}
+
+template<class Ntk, bill::solvers Solver>
+std::vector<Ntk> exact_mc_synthesis_run( kitty::dynamic_truth_table const& func, uint32_t num_solutions, exact_mc_synthesis_params const& ps, exact_mc_synthesis_stats& st )
+{
+  const auto num_threads = ps.num_threads == 1u ? 1u : resolve_num_threads( ps.num_threads );
+  if ( num_threads == 1u )
+  {
+    return exact_mc_synthesis_impl<Ntk, Solver>{func, num_solutions, ps, st}.run();
+  }
+
+  auto configs = ps.portfolio;
+  if ( configs.empty() )
+  {
+    configs.push_back( {Solver, ps.use_cegar} );
+    /* additional solutions found with CEGAR are not verified against all minterms */
+    if ( num_solutions == 1u )
+    {
+      configs.push_back( {Solver, !ps.use_cegar} );
+    }
+    for ( auto solver : {bill::solvers::glucose_41, bill::solvers::bsat2, bill::solvers::ghack} )
+    {
+      if ( solver != Solver )
+      {
+        configs.push_back( {solver, ps.use_cegar} );
+      }
+    }
+  }
+  configs.resize( std::min<std::size_t>( configs.size(), num_threads ) );
+
+  /* stops all other configurations once the first one has found a solution */
+  std::atomic<bool> found{false};
+  std::mutex mutex;
+  std::vector<Ntk> ntks;
+
+  run_on_threads( static_cast<uint32_t>( configs.size() ), [&]( uint32_t t ) {
+    auto cps = ps;
+    cps.use_cegar = configs[t].use_cegar;
+    cps.progress = false;
+    cps.verbose = cps.very_verbose = false;
+    exact_mc_synthesis_stats cst;
+
+    dispatch_exact_mc_solver<Solver>( configs[t].solver, [&]( auto solver ) {
+      auto result = exact_mc_synthesis_impl<Ntk, decltype( solver )::value>{func, num_solutions, cps, cst, &found}.run();
+      if ( !result.empty() && !found.exchange( true ) )
+      {
+        std::lock_guard<std::mutex> lock( mutex );
+        ntks = std::move( result );
+        st = cst;
+      }
+    } );
+  } );
+
+  return ntks;
+}
+
 } // namespace detail
 
 template<class Ntk = xag_network, bill::solvers Solver = bill::solvers::glucose_41>
 Ntk exact_mc_synthesis( kitty::dynamic_truth_table const& func, exact_mc_synthesis_params const& ps = {}, exact_mc_synthesis_stats* pst = nullptr )
 {
   exact_mc_synthesis_stats st;
-  const auto xag = detail::exact_mc_synthesis_impl<Ntk, Solver>{func, 1u, ps, st}.run().front();
+  const auto xag = detail::exact_mc_synthesis_run<Ntk, Solver>( func, 1u, ps, st ).front();
 
   if ( ps.verbose )
   {
@@ -620,7 +759,7 @@ template<class Ntk = xag_network, bill::solvers Solver = bill::solvers::glucose_
 std::vector<Ntk> exact_mc_synthesis_multiple( kitty::dynamic_truth_table const& func, uint32_t num_solutions, exact_mc_synthesis_params const& ps = {}, exact_mc_synthesis_stats* pst = nullptr )
 {
   exact_mc_synthesis_stats st;
-  const auto xags = detail::exact_mc_synthesis_impl<Ntk, Solver>{func, num_solutions, ps, st}.run();
+  const auto xags = detail::exact_mc_synthesis_run<Ntk, Solver>( func, num_solutions, ps, st );
 
   if ( ps.verbose )
   {
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../utils/parallel.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
@@ -43,6 +44,11 @@
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/io/write_patterns.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+
 namespace mockturtle
 {
 
@@ -76,6 +82,17 @@ struct functional_reduction_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{1000};
+
+  /*! \brief Number of SAT worker threads (0 uses all hardware threads).
+   *
+   * With more than one thread, candidate pairs are collected in batches and
+   * proven concurrently, each worker with its own validator.  Substitutions
+   * are applied by the calling thread after each batch.
+   */
+  uint32_t num_threads{1};
+
+  /*! \brief Number of candidate pairs per batch in parallel mode. */
+  uint32_t batch_size{256};
 };
 
 struct functional_reduction_stats
@@ -133,11 +150,30 @@ public:
   using signal = typename Ntk::signal;
   using TT = unordered_node_map<kitty::partial_truth_table, Ntk>;
 
+  /* candidate pair proven by a worker in parallel mode */
+  struct sat_job
+  {
+    node root;
+    signal g;
+    bool is_constant;
+    std::vector<node> excluded;
+    std::optional<bool> result{};
+    std::vector<bool> cex{};
+  };
+
   explicit functional_reduction_impl( Ntk& ntk, functional_reduction_params const& ps, validator_params const& vps, functional_reduction_stats& st )
       : ntk( ntk ), ps( ps ), st( st ), tts( ntk ),
         sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), 256 ) ), validator( ntk, vps )
   {
     static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
+
+    if ( const auto num_threads = resolve_num_threads( ps.num_threads ); num_threads > 1u )
+    {
+      for ( auto t = 0u; t < num_threads; ++t )
+      {
+        workers.emplace_back( std::make_unique<validator_t>( ntk, vps ) );
+      }
+    }
   }
 
   ~functional_reduction_impl()
@@ -157,6 +193,12 @@ public:
       simulate_nodes<Ntk>( ntk, tts, sim, true );
     } );
 
+    if ( !workers.empty() )
+    {
+      run_parallel();
+      return;
+    }
+
     /* remove constant nodes. */
     substitute_constants();
 
@@ -242,68 +284,78 @@ private:
       check_tts( root );
       auto tt = tts[root];
       auto ntt = ~tts[root];
-      std::vector<node> tfi;
-      bool keep_trying = true;
-      foreach_transitive_fanin( root, [&]( auto const& n ) {
-        tfi.emplace_back( n );
-        if ( tfi.size() > ps.max_TFI_nodes )
-        {
-          return false;
-        }
-        
-        keep_trying = try_node( tt, ntt, root, n );
-        return keep_trying;
+      foreach_candidate( root, [&]( auto const& n ) {
+        return try_node( tt, ntt, root, n );
       } );
 
-      if ( keep_trying ) /* didn't find a substitution in TFI cone, explore fanouts. */
+      return true; /* next */
+    } );
+  }
+
+  /* calls `fn` on the nodes that may substitute `root` until it returns false */
+  template<typename Fn>
+  void foreach_candidate( node const& root, Fn&& fn )
+  {
+    std::vector<node> tfi;
+    bool keep_trying = true;
+    foreach_transitive_fanin( root, [&]( auto const& n ) {
+      tfi.emplace_back( n );
+      if ( tfi.size() > ps.max_TFI_nodes )
       {
-        for ( auto j = 0u; j < tfi.size() && tfi.size() <= ps.max_TFI_nodes && keep_trying; ++j )
-        {
-          auto& n = tfi.at( j );
-          if ( ntk.fanout_size( n ) > ps.skip_fanout_limit )
-            { continue; }
-
-          /* if the fanout has all fanins in the set, add it */
-          ntk.foreach_fanout( n, [&]( node const& p ) {
-            if ( ntk.visited( p ) == ntk.trav_id() )
-              { return true; /* next fanout */ }
-
-            bool all_fanins_visited = true;
-            ntk.foreach_fanin( p, [&]( const auto& g ) {
-              if ( ntk.visited( ntk.get_node( g ) ) != ntk.trav_id() )
-              {
-                all_fanins_visited = false;
-                return false; /* terminate fanin-loop */
-              }
-              return true; /* next fanin */
-            } );
-            if ( !all_fanins_visited )
-              { return true; /* next fanout */ }
-
-            bool has_root_as_child = false;
-            ntk.foreach_fanin( p, [&]( const auto& g ) {
-              if ( ntk.get_node( g ) == root )
-              {
-                has_root_as_child = true;
-                return false; /* terminate fanin-loop */
-              }
-              return true; /* next fanin */
-            } );
-            if ( has_root_as_child )
-              { return true; /* next fanout */ }
-
-            tfi.emplace_back( p );
-            ntk.set_visited( p, ntk.trav_id() );
-
-            check_tts( p );
-            keep_trying = try_node( tt, ntt, root, p );
-            return keep_trying;
+        return false;
+      }
+      
+      keep_trying = fn( n );
+      return keep_trying;
+    } );
+
+    if ( keep_trying ) /* didn't find a substitution in TFI cone, explore fanouts. */
+    {
+      for ( auto j = 0u; j < tfi.size() && tfi.size() <= ps.max_TFI_nodes && keep_trying; ++j )
+      {
+        auto& n = tfi.at( j );
+        if ( ntk.fanout_size( n ) > ps.skip_fanout_limit )
+          { continue; }
+
+        /* if the fanout has all fanins in the set, add it */
+        ntk.foreach_fanout( n, [&]( node const& p ) {
+          if ( ntk.visited( p ) == ntk.trav_id() )
+            { return true; /* next fanout */ }
+
+          bool all_fanins_visited = true;
+          ntk.foreach_fanin( p, [&]( const auto& g ) {
+            if ( ntk.visited( ntk.get_node( g ) ) != ntk.trav_id() )
+            {
+              all_fanins_visited = false;
+              return false; /* terminate fanin-loop */
+            }
+            return true; /* next fanin */
           } );
-        }
+          if ( !all_fanins_visited )
+            { return true; /* next fanout */ }
+
+          bool has_root_as_child = false;
+          ntk.foreach_fanin( p, [&]( const auto& g ) {
+            if ( ntk.get_node( g ) == root )
+            {
+              has_root_as_child = true;
+              return false; /* terminate fanin-loop */
+            }
+            return true; /* next fanin */
+          } );
+          if ( has_root_as_child )
+            { return true; /* next fanout */ }
+
+          tfi.emplace_back( p );
+          ntk.set_visited( p, ntk.trav_id() );
+
+          check_tts( p );
+          keep_trying = fn( p );
+          return keep_trying;
+        } );
       }
+    }
 
-      return true; /* next */
-    } );
   }
 
   bool try_node( kitty::partial_truth_table& tt, kitty::partial_truth_table& ntt, node const& root, node const& n )
@@ -351,10 +403,174 @@ private:
     }
   }
 
+  void run_parallel()
+  {
+    /* remove constant nodes. */
+    std::vector<node> roots;
+    auto zero = sim.compute_constant( false );
+    auto one = sim.compute_constant( true );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      roots.emplace_back( n );
+    } );
+    run_batches( roots, [&]( node const& n, std::vector<node> const& ) -> std::optional<sat_job> {
+      check_tts( n );
+      if ( tts[n].num_bits() != zero.num_bits() )
+      {
+        zero = sim.compute_constant( false );
+        one = sim.compute_constant( true );
+      }
+      if ( tts[n] != zero && tts[n] != one )
+      {
+        return std::nullopt;
+      }
+      return sat_job{n, ntk.get_constant( tts[n] == one ), true, {}};
+    } );
+
+    /* substitute functional equivalent nodes. */
+    auto size_before = ntk.size();
+    do
+    {
+      size_before = ntk.size();
+      roots.clear();
+      ntk.foreach_gate( [&]( auto const& n ) {
+        roots.emplace_back( n );
+      } );
+      run_batches( roots, [&]( node const& root, std::vector<node> const& excluded ) -> std::optional<sat_job> {
+        check_tts( root );
+        const auto tt = tts[root];
+        const auto ntt = ~tt;
+        std::optional<sat_job> job;
+        foreach_candidate( root, [&]( auto const& n ) {
+          if ( std::find( excluded.begin(), excluded.end(), n ) != excluded.end() )
+          {
+            return true;
+          }
+          if ( tt == tts[n] )
+          {
+            job = sat_job{root, ntk.make_signal( n ), false, excluded};
+          }
+          else if ( ntt == tts[n] )
+          {
+            job = sat_job{root, !ntk.make_signal( n ), false, excluded};
+          }
+          return !job;
+        } );
+        return job;
+      } );
+    } while ( ps.saturation && ntk.size() != size_before );
+  }
+
+  /* Collects up to `batch_size` candidate pairs with `make_job`, proves them
+   * on the workers, and commits the results in order.  Roots whose candidate
+   * is refuted are retried in a later batch with the updated simulation
+   * signatures; candidates that time out are excluded for their root. */
+  template<typename Fn>
+  void run_batches( std::vector<node> const& roots, Fn&& make_job )
+  {
+    progress_bar pbar{static_cast<uint32_t>( roots.size() ), "FR-par |{0}| node = {1:>4}   cand = {2:>4}", ps.progress};
+
+    std::deque<std::pair<node, std::vector<node>>> retry;
+    std::vector<sat_job> jobs;
+    auto next = 0u;
+    while ( next < roots.size() || !retry.empty() )
+    {
+      pbar( next, next, candidates );
+
+      jobs.clear();
+      const auto add_job = [&]( node const& root, std::vector<node> const& excluded ) {
+        if ( ntk.is_dead( root ) )
+        {
+          return;
+        }
+        if ( auto job = make_job( root, excluded ) )
+        {
+          jobs.emplace_back( std::move( *job ) );
+        }
+      };
+      while ( !retry.empty() && jobs.size() < ps.batch_size )
+      {
+        add_job( retry.front().first, retry.front().second );
+        retry.pop_front();
+      }
+      while ( next < roots.size() && jobs.size() < ps.batch_size )
+      {
+        add_job( roots[next++], {} );
+      }
+      candidates += static_cast<uint32_t>( jobs.size() );
+
+      solve_jobs( jobs );
+
+      for ( auto& job : jobs )
+      {
+        if ( !job.result ) /* timeout */
+        {
+          ++st.num_timeout;
+          if ( !job.is_constant )
+          {
+            job.excluded.emplace_back( ntk.get_node( job.g ) );
+            retry.emplace_back( job.root, std::move( job.excluded ) );
+          }
+        }
+        else if ( !( *job.result ) ) /* SAT, cex found */
+        {
+          add_cex( job.cex );
+          if ( !job.is_constant )
+          {
+            retry.emplace_back( job.root, std::move( job.excluded ) );
+          }
+        }
+        else if ( !ntk.is_dead( job.root ) ) /* UNSAT, verified */
+        {
+          /* the candidate may have been substituted by an earlier job of this batch */
+          if ( ntk.is_dead( ntk.get_node( job.g ) ) )
+          {
+            retry.emplace_back( job.root, std::move( job.excluded ) );
+            continue;
+          }
+          ++st.num_reduction;
+          ++( job.is_constant ? st.num_const_accepts : st.num_equ_accepts );
+          ntk.substitute_node( job.root, job.g );
+        }
+      }
+    }
+  }
+
+  /* proves all jobs concurrently; the network is not modified meanwhile */
+  void solve_jobs( std::vector<sat_job>& jobs )
+  {
+    stopwatch t( st.time_sat );
+
+    std::atomic<uint32_t> next_job{0u};
+    run_on_threads( std::min( static_cast<uint32_t>( workers.size() ), static_cast<uint32_t>( jobs.size() ) ), [&]( uint32_t w ) {
+      auto& v = *workers[w];
+      for ( auto i = next_job++; i < jobs.size(); i = next_job++ )
+      {
+        auto& job = jobs[i];
+        if ( job.is_constant )
+        {
+          job.result = v.validate( job.root, ntk.get_constant( true ) == job.g );
+        }
+        else
+        {
+          job.result = v.validate( job.root, job.g );
+        }
+        if ( job.result && !*job.result )
+        {
+          job.cex = v.cex;
+        }
+      }
+    } );
+  }
+
   void found_cex()
+  {
+    add_cex( validator.cex );
+  }
+
+  void add_cex( std::vector<bool> const& cex )
   {
     ++st.num_cex;
-    sim.add_pattern( validator.cex );
+    sim.add_pattern( cex );
 
     /* re-simulate the whole circuit (for the last block) when a block is full */
     if ( sim.num_bits() % 64 == 0 )
@@ -415,6 +631,7 @@ private:
   TT tts;
   partial_simulator sim;
   validator_t validator;
+  std::vector<std::unique_ptr<validator_t>> workers;
 
   uint32_t candidates{0};
 }; /* functional_reduction_impl */
@@ -424,6 +641,11 @@ private:
 /*! \brief Functional reduction.
  *
  * Removes constant nodes and substitute functionally equivalent nodes.
+ *
+ * If `ps.num_threads` is not 1, candidate pairs are proven concurrently by a
+ * pool of validators, and the calling thread applies the substitutions and
+ * adds the counter-examples to the shared simulation patterns after each
+ * batch.
  */
 template<class Ntk>
 void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {}, functional_reduction_stats* pst = nullptr )
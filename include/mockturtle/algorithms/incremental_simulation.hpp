@@ -0,0 +1,492 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file incremental_simulation.hpp
+  \brief Event-driven incremental partial simulation
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <kitty/partial_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "simulation.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Computes the words of `result` starting at block `first_block`
+ *
+ * All fanin signatures must have the same length as `result`.  AND, XOR,
+ * MAJ, and XOR3 gates are evaluated word by word; other gates are
+ * recomputed completely with the network's `compute` method.
+ */
+template<class Ntk>
+void compute_blocks( Ntk const& ntk, typename Ntk::node const& n, std::vector<kitty::partial_truth_table const*> const& fanins, std::vector<uint64_t> const& masks, kitty::partial_truth_table& result, uint32_t first_block )
+{
+  bool done = false;
+  if constexpr ( has_is_and_v<Ntk> && has_is_xor_v<Ntk> && has_is_maj_v<Ntk> && has_is_xor3_v<Ntk> )
+  {
+    auto& words = result._bits;
+    if ( fanins.size() == 2u && ( ntk.is_and( n ) || ntk.is_xor( n ) ) )
+    {
+      auto const& a = fanins[0]->_bits;
+      auto const& b = fanins[1]->_bits;
+      if ( ntk.is_and( n ) )
+      {
+        for ( auto i = first_block; i < words.size(); ++i )
+        {
+          words[i] = ( a[i] ^ masks[0] ) & ( b[i] ^ masks[1] );
+        }
+      }
+      else
+      {
+        for ( auto i = first_block; i < words.size(); ++i )
+        {
+          words[i] = a[i] ^ b[i] ^ masks[0] ^ masks[1];
+        }
+      }
+      done = true;
+    }
+    else if ( fanins.size() == 3u && ( ntk.is_maj( n ) || ntk.is_xor3( n ) ) )
+    {
+      auto const& a = fanins[0]->_bits;
+      auto const& b = fanins[1]->_bits;
+      auto const& c = fanins[2]->_bits;
+      if ( ntk.is_maj( n ) )
+      {
+        for ( auto i = first_block; i < words.size(); ++i )
+        {
+          const auto x = a[i] ^ masks[0], y = b[i] ^ masks[1], z = c[i] ^ masks[2];
+          words[i] = ( x & y ) | ( z & ( x | y ) );
+        }
+      }
+      else
+      {
+        for ( auto i = first_block; i < words.size(); ++i )
+        {
+          words[i] = a[i] ^ b[i] ^ c[i] ^ masks[0] ^ masks[1] ^ masks[2];
+        }
+      }
+      done = true;
+    }
+  }
+
+  if ( !done )
+  {
+    std::vector<kitty::partial_truth_table> values;
+    for ( auto const* tt : fanins )
+    {
+      values.push_back( *tt );
+    }
+    result = ntk.compute( n, values.begin(), values.end() );
+  }
+  result.mask_bits();
+}
+
+} // namespace detail
+
+/*! \brief Incremental partial simulation driven by network events.
+ *
+ * Keeps a simulation signature for every node of `ntk` up-to-date while the
+ * network is being modified.  The simulator subscribes to the network's
+ * `on_add`, `on_modified`, and `on_delete` events:
+ *
+ * - added nodes are simulated immediately from their fanins,
+ * - modified nodes are collected and, on the next `update`, re-simulated
+ *   together with their transitive fanout, stopping at nodes whose
+ *   signature does not change, and
+ * - deleted nodes are removed from the signature map.
+ *
+ * When patterns are appended to the simulator `sim` (e.g., counter-examples
+ * with `add_pattern`), `update` only computes the words of each signature
+ * that contain new patterns.
+ *
+ * The network must provide fanouts, e.g., by wrapping it into a
+ * `fanout_view`.  The simulator `sim` is kept by reference and must outlive
+ * this object.
+ *
+ * **Required network functions:**
+ * - `get_node`
+ * - `get_constant`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `foreach_fanout`
+ * - `is_complemented`
+ * - `is_dead`
+ * - `events`
+ * - `compute<kitty::partial_truth_table>`
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      fanout_view<aig_network> aig{...};
+      partial_simulator sim( aig.num_pis(), 256 );
+
+      incremental_simulator isim( aig, sim );
+      aig.substitute_node( n, f );
+      sim.add_pattern( cex );
+
+      auto const& tt = isim.get( aig.get_node( f ) );
+   \endverbatim
+ */
+template<class Ntk, class Simulator = partial_simulator>
+class incremental_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  incremental_simulator( Ntk& ntk, Simulator const& sim )
+      : ntk( ntk ), sim( sim ), tts( ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute specialization for kitty::partial_truth_table" );
+
+    simulate_all();
+
+    event_ptr = {ntk.events().on_add.size(), ntk.events().on_modified.size(), ntk.events().on_delete.size()};
+    ntk.events().on_add.emplace_back( [this]( auto const& n ) {
+      simulate( n, 0u );
+    } );
+    ntk.events().on_modified.emplace_back( [this]( auto const& n, auto const& previous ) {
+      (void)previous;
+      modified.push_back( n );
+    } );
+    ntk.events().on_delete.emplace_back( [this]( auto const& n ) {
+      tts.erase( n );
+    } );
+  }
+
+  ~incremental_simulator()
+  {
+    ntk.events().on_add.erase( ntk.events().on_add.begin() + event_ptr[0] );
+    ntk.events().on_modified.erase( ntk.events().on_modified.begin() + event_ptr[1] );
+    ntk.events().on_delete.erase( ntk.events().on_delete.begin() + event_ptr[2] );
+  }
+
+  incremental_simulator( incremental_simulator const& ) = delete;
+  incremental_simulator& operator=( incremental_simulator const& ) = delete;
+
+  /*! \brief Brings all signatures up-to-date.
+   *
+   * First computes the words of new patterns for all nodes, then
+   * re-simulates the transitive fanout of all nodes modified since the last
+   * call.
+   */
+  void update()
+  {
+    if ( num_bits != sim.num_bits() )
+    {
+      extend_patterns();
+    }
+    if ( !modified.empty() )
+    {
+      propagate_modifications();
+    }
+  }
+
+  /*! \brief Returns the up-to-date signature of node `n`. */
+  kitty::partial_truth_table const& get( node const& n )
+  {
+    update();
+    return tts[n];
+  }
+
+  /*! \brief Returns the up-to-date signature of signal `f`. */
+  kitty::partial_truth_table get( signal const& f )
+  {
+    auto const& tt = get( ntk.get_node( f ) );
+    return ntk.is_complemented( f ) ? ~tt : tt;
+  }
+
+  /*! \brief Returns the signatures of all nodes (call `update` first). */
+  unordered_node_map<kitty::partial_truth_table, Ntk> const& signatures() const
+  {
+    return tts;
+  }
+
+  /*! \brief Returns the number of gates simulated since construction (excluding the initial simulation). */
+  uint64_t num_simulated_gates() const
+  {
+    return num_simulated;
+  }
+
+private:
+  void simulate_all()
+  {
+    num_bits = sim.num_bits();
+    update_const_pi();
+
+    topological_order( [&]( auto const& fn ) {
+      ntk.foreach_gate( [&]( auto const& n ) { fn( n ); } );
+    } );
+    for ( auto const& n : order )
+    {
+      compute( n, 0u );
+    }
+  }
+
+  void update_const_pi()
+  {
+    auto const c = ntk.get_node( ntk.get_constant( false ) );
+    tts[c] = sim.compute_constant( false );
+    if ( c != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      tts[ntk.get_node( ntk.get_constant( true ) )] = sim.compute_constant( true );
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      tts[n] = sim.compute_pi( i );
+    } );
+  }
+
+  /* computes all words from `first_block` on */
+  bool compute( node const& n, uint32_t first_block )
+  {
+    fanins.clear();
+    masks.clear();
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( &tts[ntk.get_node( f )] );
+      masks.push_back( ntk.is_complemented( f ) ? ~uint64_t( 0 ) : uint64_t( 0 ) );
+    } );
+
+    auto& tt = tts[n];
+    if ( first_block == 0u )
+    {
+      previous = tt;
+      tt = kitty::partial_truth_table( num_bits );
+    }
+    else
+    {
+      tt.resize( num_bits );
+    }
+    detail::compute_blocks( ntk, n, fanins, masks, tt, first_block );
+    return first_block != 0u || previous != tt;
+  }
+
+  void simulate( node const& n, uint32_t first_block )
+  {
+    ++num_simulated;
+    compute( n, first_block );
+  }
+
+  void extend_patterns()
+  {
+    assert( sim.num_bits() > num_bits );
+    auto const first_block = num_bits >> 6u;
+    num_bits = sim.num_bits();
+    update_const_pi();
+
+    topological_order( [&]( auto const& fn ) {
+      ntk.foreach_gate( [&]( auto const& n ) { fn( n ); } );
+    } );
+    for ( auto const& n : order )
+    {
+      simulate( n, first_block );
+    }
+  }
+
+  void propagate_modifications()
+  {
+    /* topological order of the transitive fanout of all modified nodes */
+    std::vector<node> roots;
+    std::swap( roots, modified );
+    tfo_order( roots );
+
+    dirty.clear();
+    changed.clear();
+    for ( auto const& n : roots )
+    {
+      dirty.insert( ntk.node_to_index( n ) );
+    }
+
+    for ( auto const& n : order )
+    {
+      if ( dirty.count( ntk.node_to_index( n ) ) == 0u )
+      {
+        bool fanin_changed = false;
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          fanin_changed = fanin_changed || changed.count( ntk.node_to_index( ntk.get_node( f ) ) ) != 0u;
+        } );
+        if ( !fanin_changed )
+        {
+          continue;
+        }
+      }
+
+      ++num_simulated;
+      if ( compute( n, 0u ) )
+      {
+        changed.insert( ntk.node_to_index( n ) );
+      }
+    }
+  }
+
+  /* post-order over the fanins of the nodes enumerated by `foreach_root`, reversed into `order` */
+  template<typename Fn>
+  void topological_order( Fn&& foreach_root )
+  {
+    order.clear();
+    reset_marks();
+
+    mark( ntk.get_node( ntk.get_constant( false ) ) );
+    mark( ntk.get_node( ntk.get_constant( true ) ) );
+    ntk.foreach_pi( [&]( auto const& n ) { mark( n ); } );
+
+    std::vector<std::pair<node, bool>> stack;
+    foreach_root( [&]( node const& root ) {
+      if ( is_marked( root ) )
+      {
+        return;
+      }
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        if ( is_marked( n ) )
+        {
+          stack.pop_back();
+          continue;
+        }
+        if ( !expanded )
+        {
+          stack.back().second = true;
+          ntk.foreach_fanin( n, [&]( auto const& f ) {
+            if ( !is_marked( ntk.get_node( f ) ) )
+            {
+              stack.emplace_back( ntk.get_node( f ), false );
+            }
+          } );
+          continue;
+        }
+        stack.pop_back();
+        mark( n );
+        order.push_back( n );
+      }
+    } );
+  }
+
+  /* reverse post-order over the fanouts of `roots` into `order` */
+  void tfo_order( std::vector<node> const& roots )
+  {
+    order.clear();
+    reset_marks();
+
+    std::vector<std::pair<node, bool>> stack;
+    for ( auto const& root : roots )
+    {
+      if ( ntk.is_dead( root ) || is_marked( root ) )
+      {
+        continue;
+      }
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        if ( !expanded )
+        {
+          if ( is_marked( n ) )
+          {
+            stack.pop_back();
+            continue;
+          }
+          mark( n );
+          stack.back().second = true;
+          ntk.foreach_fanout( n, [&]( auto const& fo ) {
+            if ( !ntk.is_dead( fo ) && !is_marked( fo ) )
+            {
+              stack.emplace_back( fo, false );
+            }
+          } );
+          continue;
+        }
+        stack.pop_back();
+        order.push_back( n );
+      }
+    }
+    std::reverse( order.begin(), order.end() );
+  }
+
+  void reset_marks()
+  {
+    marks.assign( ntk.size(), 0u );
+  }
+
+  void mark( node const& n )
+  {
+    marks[ntk.node_to_index( n )] = 1u;
+  }
+
+  bool is_marked( node const& n ) const
+  {
+    return marks[ntk.node_to_index( n )] != 0u;
+  }
+
+private:
+  Ntk& ntk;
+  Simulator const& sim;
+  unordered_node_map<kitty::partial_truth_table, Ntk> tts;
+
+  uint32_t num_bits{0u};
+  uint64_t num_simulated{0u};
+  std::array<std::size_t, 3u> event_ptr;
+
+  std::vector<node> modified;
+  std::vector<node> order;
+  std::vector<uint8_t> marks;
+  phmap::flat_hash_set<uint64_t> dirty;
+  phmap::flat_hash_set<uint64_t> changed;
+
+  /* scratch space for `compute` */
+  std::vector<kitty::partial_truth_table const*> fanins;
+  std::vector<uint64_t> masks;
+  kitty::partial_truth_table previous;
+};
+
+} /* namespace mockturtle */
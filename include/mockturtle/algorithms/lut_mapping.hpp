@@ -36,6 +36,7 @@
 
 #include <fmt/format.h>
 
+#include "../utils/parallel.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/topo_view.hpp"
 #include "cut_enumeration.hpp"
@@ -72,6 +73,18 @@ struct lut_mapping_params
   /*! \brief Number of rounds for exact area optimization. */
   uint32_t rounds_ela{1u};
 
+  /*! \brief Number of threads (0 uses all hardware threads).
+   *
+   * With a value other than 1, the delay and area flow rounds distribute the
+   * nodes of each logic level among threads, which gives the same mapping as
+   * the sequential algorithm.  The exact area rounds split the gates into one
+   * region of consecutive nodes in topological order per thread; nodes of
+   * other regions are treated like primary inputs, and the reference counts
+   * are recomputed after each round.  The mapping only depends on the number
+   * of threads.
+   */
+  uint32_t num_threads{1u};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 };
@@ -114,6 +127,13 @@ public:
   using network_cuts_t = network_cuts<Ntk, StoreFunction, CutData>;
   using cut_t = typename network_cuts_t::cut_t;
 
+  /* state of one thread in exact area optimization */
+  struct ela_context
+  {
+    uint32_t region{0u};
+    std::vector<uint32_t> tmp_area; /* temporary vector to compute exact area */
+  };
+
 public:
   lut_mapping_impl( Ntk& ntk, lut_mapping_params const& ps, lut_mapping_stats& st )
       : ntk( ntk ),
@@ -138,6 +158,12 @@ public:
       top_order.push_back( n );
     } );
 
+    num_threads = resolve_num_threads( ps.num_threads );
+    if ( num_threads > 1u )
+    {
+      init_parallel();
+    }
+
     init_nodes();
     //print_state();
 
@@ -183,19 +209,139 @@ private:
     } );
   }
 
+  /* groups the gates by level and splits them into regions */
+  void init_parallel()
+  {
+    std::vector<uint32_t> level( ntk.size(), 0u );
+    std::vector<uint32_t> gates;
+    for ( auto const& n : top_order )
+    {
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+        continue;
+
+      const auto index = ntk.node_to_index( n );
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level[index] = std::max( level[index], level[ntk.node_to_index( ntk.get_node( f ) )] + 1u );
+      } );
+      if ( level[index] > levels.size() )
+      {
+        levels.resize( level[index] );
+      }
+      levels[level[index] - 1u].push_back( index );
+      gates.push_back( index );
+    }
+
+    region_of.resize( ntk.size(), 0u );
+    regions.resize( num_threads );
+    contexts.resize( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      contexts[t].region = t;
+      const auto [begin, end] = thread_range( gates.size(), t, num_threads );
+      regions[t].assign( gates.begin() + begin, gates.begin() + end );
+      for ( auto const& index : regions[t] )
+      {
+        region_of[index] = t;
+      }
+    }
+  }
+
   template<bool ELA>
   void compute_mapping()
   {
+    if ( num_threads > 1u )
+    {
+      if constexpr ( ELA )
+      {
+        compute_mapping_regions();
+      }
+      else
+      {
+        foreach_level_parallel( [this]( uint32_t index, uint32_t t ) {
+          compute_best_cut<false>( index, contexts[t] );
+        } );
+      }
+      set_mapping_refs<ELA>();
+      return;
+    }
+
     for ( auto const& n : top_order )
     {
       if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
         continue;
-      compute_best_cut<ELA>( ntk.node_to_index( n ) );
+      compute_best_cut<ELA>( ntk.node_to_index( n ), serial_context );
     }
     set_mapping_refs<ELA>();
     //print_state();
   }
 
+  /* calls `fn( index, t )` on all gates; gates of the same level are distributed among threads */
+  template<typename Fn>
+  void foreach_level_parallel( Fn&& fn )
+  {
+    spin_barrier barrier( num_threads );
+    run_on_threads( num_threads, [&]( uint32_t t ) {
+      for ( auto const& nodes : levels )
+      {
+        const auto [begin, end] = thread_range( nodes.size(), t, num_threads );
+        for ( auto i = begin; i < end; ++i )
+        {
+          fn( nodes[i], t );
+        }
+        barrier.wait();
+      }
+    } );
+  }
+
+  /* Each thread performs exact area optimization on its region, in which
+   * references to other regions are not followed.  Afterwards, the delays and
+   * the mapping references are recomputed for the selected cuts. */
+  void compute_mapping_regions()
+  {
+    run_on_threads( num_threads, [this]( uint32_t t ) {
+      for ( auto const& index : regions[t] )
+      {
+        compute_best_cut<true>( index, contexts[t] );
+      }
+    } );
+
+    foreach_level_parallel( [this]( uint32_t index, uint32_t ) {
+      if ( cuts.cuts( index )[0].size() > 1 )
+      {
+        delays[index] = cut_flow( cuts.cuts( index )[0] ).second;
+      }
+    } );
+
+    for ( auto const& n : top_order )
+    {
+      if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+      {
+        map_refs[ntk.node_to_index( n )] = 0u;
+      }
+    }
+    ntk.foreach_po( [this]( auto s ) {
+      const auto n = ntk.get_node( s );
+      if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+      {
+        map_refs[ntk.node_to_index( n )]++;
+      }
+    } );
+    for ( auto it = top_order.rbegin(); it != top_order.rend(); ++it )
+    {
+      const auto index = ntk.node_to_index( *it );
+      if ( ntk.is_constant( *it ) || ntk.is_pi( *it ) || map_refs[index] == 0 )
+        continue;
+
+      for ( auto leaf : cuts.cuts( index )[0] )
+      {
+        if ( !ntk.is_constant( ntk.index_to_node( leaf ) ) && !ntk.is_pi( ntk.index_to_node( leaf ) ) )
+        {
+          map_refs[leaf]++;
+        }
+      }
+    }
+  }
+
   template<bool ELA>
   void set_mapping_refs()
   {
@@ -262,17 +408,17 @@ private:
    *   adds cut to current mapping and recursively adds best cuts of leaf
    *   nodes, if they are not part of the current mapping.
    */
-  uint32_t cut_ref( cut_t const& cut )
+  uint32_t cut_ref( cut_t const& cut, ela_context& ctx )
   {
     uint32_t count = cut_area( cut );
     for ( auto leaf : cut )
     {
-      if ( ntk.is_constant( ntk.index_to_node( leaf ) ) || ntk.is_pi( ntk.index_to_node( leaf ) ) )
+      if ( is_terminal( leaf, ctx ) )
         continue;
 
       if ( map_refs[leaf]++ == 0 )
       {
-        count += cut_ref( cuts.cuts( leaf )[0] );
+        count += cut_ref( cuts.cuts( leaf )[0], ctx );
       }
     }
     return count;
@@ -283,17 +429,17 @@ private:
    *   leaf nodes, if they are part of the current mapping.
    *   (this is the inverse operation to cut_ref)
    */
-  uint32_t cut_deref( cut_t const& cut )
+  uint32_t cut_deref( cut_t const& cut, ela_context& ctx )
   {
     uint32_t count = cut_area( cut );
     for ( auto leaf : cut )
     {
-      if ( ntk.is_constant( ntk.index_to_node( leaf ) ) || ntk.is_pi( ntk.index_to_node( leaf ) ) )
+      if ( is_terminal( leaf, ctx ) )
         continue;
 
       if ( --map_refs[leaf] == 0 )
       {
-        count += cut_deref( cuts.cuts( leaf ).best() );
+        count += cut_deref( cuts.cuts( leaf ).best(), ctx );
       }
     }
     return count;
@@ -303,9 +449,9 @@ private:
    *   this special version of cut_ref does two additional things:
    *   1. it stops recursing if it has found `limit` cuts
    *   2. it remembers all cuts for which the reference count increases in the
-   *      vector `tmp_area`.
+   *      vector `ctx.tmp_area`.
    */
-  uint32_t cut_ref_limit_save( cut_t const& cut, uint32_t limit )
+  uint32_t cut_ref_limit_save( cut_t const& cut, uint32_t limit, ela_context& ctx )
   {
     uint32_t count = cut_area( cut );
     if ( limit == 0 )
@@ -313,13 +459,13 @@ private:
 
     for ( auto leaf : cut )
     {
-      if ( ntk.is_constant( ntk.index_to_node( leaf ) ) || ntk.is_pi( ntk.index_to_node( leaf ) ) )
+      if ( is_terminal( leaf, ctx ) )
         continue;
 
-      tmp_area.push_back( leaf );
+      ctx.tmp_area.push_back( leaf );
       if ( map_refs[leaf]++ == 0 )
       {
-        count += cut_ref_limit_save( cuts.cuts( leaf ).best(), limit - 1 );
+        count += cut_ref_limit_save( cuts.cuts( leaf ).best(), limit - 1, ctx );
       }
     }
     return count;
@@ -330,19 +476,26 @@ private:
    *   would be needed to add to the mapping if `cut` were to be added.  It
    *   temporarily modifies the reference counters but reverts them eventually.
    */
-  uint32_t cut_area_estimation( cut_t const& cut )
+  uint32_t cut_area_estimation( cut_t const& cut, ela_context& ctx )
   {
-    tmp_area.clear();
-    const auto count = cut_ref_limit_save( cut, 8 );
-    for ( auto const& n : tmp_area )
+    ctx.tmp_area.clear();
+    const auto count = cut_ref_limit_save( cut, 8, ctx );
+    for ( auto const& n : ctx.tmp_area )
     {
       map_refs[n]--;
     }
     return count;
   }
 
+  /* leaves at which reference counting stops: constants, PIs, and nodes of other regions */
+  bool is_terminal( uint32_t leaf, ela_context const& ctx ) const
+  {
+    const auto n = ntk.index_to_node( leaf );
+    return ntk.is_constant( n ) || ntk.is_pi( n ) || ( !region_of.empty() && region_of[leaf] != ctx.region );
+  }
+
   template<bool ELA>
-  void compute_best_cut( uint32_t index )
+  void compute_best_cut( uint32_t index, ela_context& ctx )
   {
     constexpr auto mf_eps{0.005f};
 
@@ -357,7 +510,7 @@ private:
     {
       if ( map_refs[index] > 0 )
       {
-        cut_deref( cuts.cuts( index )[0] );
+        cut_deref( cuts.cuts( index )[0], ctx );
       }
     }
 
@@ -369,7 +522,7 @@ private:
 
       if constexpr ( ELA )
       {
-        flow = static_cast<float>( cut_area_estimation( *cut ) );
+        flow = static_cast<float>( cut_area_estimation( *cut, ctx ) );
       }
       else
       {
@@ -391,7 +544,7 @@ private:
     {
       if ( map_refs[index] > 0 )
       {
-        cut_ref( cuts.cuts( index )[best_cut] );
+        cut_ref( cuts.cuts( index )[best_cut], ctx );
       }
     }
     else
@@ -400,9 +553,16 @@ private:
     }
     if constexpr ( ELA )
     {
-      best_time = cut_flow( cuts.cuts( index )[best_cut] ).second;
+      /* leaves in other regions may still change; delays are recomputed after all regions */
+      if ( region_of.empty() )
+      {
+        delays[index] = cut_flow( cuts.cuts( index )[best_cut] ).second;
+      }
+    }
+    else
+    {
+      delays[index] = best_time;
     }
-    delays[index] = best_time;
     flows[index] = best_flow / flow_refs[index];
 
     if ( best_cut != 0 )
@@ -465,7 +625,14 @@ private:
   std::vector<uint32_t> delays;
   network_cuts_t cuts;
 
-  std::vector<uint32_t> tmp_area; /* temporary vector to compute exact area */
+  ela_context serial_context;
+
+  /* parallel mode */
+  uint32_t num_threads{1u};
+  std::vector<std::vector<uint32_t>> levels; /* gates by level */
+  std::vector<uint32_t> region_of;           /* region of each node in exact area optimization */
+  std::vector<std::vector<uint32_t>> regions;
+  std::vector<ela_context> contexts;
 };
 
 }; /* namespace detail */
@@ -500,6 +667,7 @@ private:
  * - `foreach_po`
  * - `foreach_node`
  * - `fanout_size`
+ * - `foreach_fanin`
  * - `clear_mapping`
  * - `add_to_mapping`
  * - `set_lut_funtion` (if `StoreFunction` is true)
@@ -525,6 +693,7 @@ void lut_mapping( Ntk& ntk, lut_mapping_params const& ps = {}, lut_mapping_stats
   static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
   static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
   static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
   static_assert( has_clear_mapping_v<Ntk>, "Ntk does not implement the clear_mapping method" );
   static_assert( has_add_to_mapping_v<Ntk>, "Ntk does not implement the add_to_mapping method" );
   static_assert( !StoreFunction || has_set_cell_function_v<Ntk>, "Ntk does not implement the set_cell_function method" );
@@ -229,7 +229,6 @@ private:
       const auto& [x, y, z, u, assoc] = *cand;
       auto opt = ntk.create_maj( z, assoc ? u : x, ntk.create_maj( x, y, u ) );
       ntk.substitute_node( n, opt );
-      ntk.update_levels();
 
       return true;
     }
@@ -241,7 +240,6 @@ private:
                                  ntk.create_maj( ocs[0], ocs[1], ocs2[0] ),
                                  ntk.create_maj( ocs[0], ocs[1], ocs2[1] ) );
       ntk.substitute_node( n, opt );
-      ntk.update_levels();
     }
     return true;
   }
@@ -321,10 +319,12 @@ private:
  * only considers pairs of nodes which both implement the majority-of-3
  * function.
  *
+ * Levels are expected to stay up-to-date when nodes are substituted, which
+ * is the case if the network is wrapped in a `depth_view`.
+ *
  * **Required network functions:**
  * - `get_node`
  * - `level`
- * - `update_levels`
  * - `create_maj`
  * - `substitute_node`
  * - `foreach_node`
@@ -352,7 +352,6 @@ void mig_algebraic_depth_rewriting( Ntk& ntk, mig_algebraic_depth_rewriting_para
   static_assert( has_level_v<Ntk>, "Ntk does not implement the level method" );
   static_assert( has_create_maj_v<Ntk>, "Ntk does not implement the create_maj method" );
   static_assert( has_substitute_node_v<Ntk>, "Ntk does not implement the substitute_node method" );
-  static_assert( has_update_levels_v<Ntk>, "Ntk does not implement the update_levels method" );
   static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
   static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
   static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
@@ -49,12 +49,16 @@ namespace mockturtle
  * OR of XORs of all primary output pairs.  In other words, the miter outputs
  * 1 for all input assignments in which the two input networks differ.
  *
+ * If `combine_outputs` is false, the miter instead has one primary output for
+ * each XOR of an output pair, such that outputs can be checked individually
+ * (e.g., with `parallel_equivalence_checking`).
+ *
  * All networks may have different types.  The method returns an optional, which
  * is `nullopt`, whenever the two input networks don't match in their number of
  * primary inputs and primary outputs.
  */
 template<class NtkDest, class NtkSource1, class NtkSource2>
-std::optional<NtkDest> miter( NtkSource1 const& ntk1, NtkSource2 const& ntk2 )
+std::optional<NtkDest> miter( NtkSource1 const& ntk1, NtkSource2 const& ntk2, bool combine_outputs = true )
 {
   static_assert( is_network_type_v<NtkSource1>, "NtkSource1 is not a network type" );
   static_assert( is_network_type_v<NtkSource2>, "NtkSource2 is not a network type" );
@@ -92,6 +96,15 @@ std::optional<NtkDest> miter( NtkSource1 const& ntk1, NtkSource2 const& ntk2 )
   std::transform( pos1.begin(), pos1.end(), pos2.begin(), std::back_inserter( xor_outputs ),
                   [&]( auto const& o1, auto const& o2 ) { return dest.create_xor( o1, o2 ); } );
 
+  if ( !combine_outputs )
+  {
+    for ( auto const& f : xor_outputs )
+    {
+      dest.create_po( f );
+    }
+    return dest;
+  }
+
   /* create big OR of XOR gates */
   dest.create_po( dest.create_nary_or( xor_outputs ) );
 
@@ -32,25 +32,41 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/hash.hpp>
+#include <kitty/operations.hpp>
 #include <kitty/print.hpp>
 #include <kitty/traits.hpp>
 
 #include "../../networks/aig.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../networks/klut.hpp"
+#include "../../utils/chain_store.hpp"
 #include "../../utils/include/percy.hpp"
+#include "../../utils/parallel.hpp"
 
 namespace mockturtle
 {
 
+/*! \brief Solver, encoder and synthesis method for exact synthesis. */
+struct exact_synthesis_config
+{
+  percy::SolverType solver_type = percy::SLV_BSAT2;
+  percy::EncoderType encoder_type = percy::ENC_SSV;
+  percy::SynthMethod synthesis_method = percy::SYNTH_STD;
+};
+
 struct exact_resynthesis_params
 {
   using cache_map_t = std::unordered_map<kitty::dynamic_truth_table, percy::chain, kitty::hash<kitty::dynamic_truth_table>>;
@@ -58,10 +74,20 @@ struct exact_resynthesis_params
 
   using blacklist_cache_map_t = std::unordered_map<kitty::dynamic_truth_table, int32_t, kitty::hash<kitty::dynamic_truth_table>>;
   using blacklist_cache_t = std::shared_ptr<blacklist_cache_map_t>;
-  
+
+  using store_t = std::shared_ptr<chain_store>;
+
   cache_t cache;
   blacklist_cache_t blacklist_cache;
 
+  /*! \brief Persistent store for chains of NPN representatives.
+   *
+   * If set, functions without don't cares are NPN canonized, and chains are
+   * looked up in and added to the store.  The in-memory caches are then
+   * indexed by NPN representatives.
+   */
+  store_t store;
+
   bool add_alonce_clauses{true};
   bool add_colex_clauses{true};
   bool add_lex_clauses{false};
@@ -76,8 +102,216 @@ struct exact_resynthesis_params
   percy::EncoderType encoder_type = percy::ENC_SSV;
 
   percy::SynthMethod synthesis_method = percy::SYNTH_STD;
+
+  /*! \brief Number of threads for portfolio synthesis (0 uses all hardware threads).
+   *
+   * If not 1, the configurations in `portfolio` race on the same
+   * specification and the first optimum chain is taken.  Since the winner
+   * may differ between runs, so may the chain.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Configurations for portfolio synthesis.
+   *
+   * If empty, the SSV encoding with and without CEGAR, the MSV and DITT
+   * encodings, and fence-based synthesis are raced.  When gate primitives
+   * are restricted, as for AIGs, only SSV configurations are used.
+   * Configurations whose encoder does not support the synthesis method
+   * (e.g., the fence encoder with `SYNTH_STD`) are skipped.
+   */
+  std::vector<exact_synthesis_config> portfolio;
 };
 
+namespace detail
+{
+
+/* the standard methods require an encoder derived from `percy::std_cegar_encoder`,
+ * the fence methods a `percy::fence_encoder` */
+inline bool is_supported_exact_synthesis_config( exact_synthesis_config const& config )
+{
+  switch ( config.synthesis_method )
+  {
+  case percy::SYNTH_STD:
+  case percy::SYNTH_STD_CEGAR:
+    return config.encoder_type == percy::ENC_SSV || config.encoder_type == percy::ENC_MSV || config.encoder_type == percy::ENC_DITT;
+  case percy::SYNTH_FENCE:
+  case percy::SYNTH_FENCE_CEGAR:
+    return config.encoder_type == percy::ENC_FENCE;
+  default:
+    return false;
+  }
+}
+
+/* only the SSV encoding supports restricting the gate primitives */
+inline std::vector<exact_synthesis_config> exact_synthesis_portfolio( std::vector<exact_synthesis_config> const& portfolio, bool has_primitives )
+{
+  std::vector<exact_synthesis_config> configs;
+  if ( portfolio.empty() )
+  {
+    configs = {{percy::SLV_BSAT2, percy::ENC_SSV, percy::SYNTH_STD},
+               {percy::SLV_BSAT2, percy::ENC_SSV, percy::SYNTH_STD_CEGAR},
+               {percy::SLV_BSAT2, percy::ENC_MSV, percy::SYNTH_STD},
+               {percy::SLV_BSAT2, percy::ENC_DITT, percy::SYNTH_STD},
+               {percy::SLV_BSAT2, percy::ENC_FENCE, percy::SYNTH_FENCE}};
+  }
+  else
+  {
+    configs = portfolio;
+  }
+
+  configs.erase( std::remove_if( configs.begin(), configs.end(), [&]( auto const& config ) {
+                   return !is_supported_exact_synthesis_config( config ) || ( has_primitives && config.encoder_type != percy::ENC_SSV );
+                 } ),
+                 configs.end() );
+  return configs;
+}
+
+/*! \brief Races several exact synthesis configurations for the same spec.
+ *
+ * Each configuration is solved in slices of a doubling conflict budget.
+ * With the standard method, the SAT solver of a timed out slice continues
+ * in the next slice.  Other methods restart from the number of steps that
+ * was reached, since all smaller numbers of steps have been refuted.  Hence,
+ * every returned chain is optimum, and the other configurations stop after
+ * their current slice once a chain has been found.  The conflict limit of
+ * the spec, if any, bounds the total budget of each configuration.
+ */
+inline percy::synth_result portfolio_synthesize( percy::spec const& spec, percy::chain& chain, std::vector<exact_synthesis_config> const& portfolio, uint32_t num_threads )
+{
+  struct portfolio_entry
+  {
+    exact_synthesis_config config;
+    percy::spec spec;
+    std::unique_ptr<percy::solver_wrapper> solver;
+    std::unique_ptr<percy::encoder> encoder;
+    percy::chain chain;
+    int64_t used{0};
+    int32_t slice{1000};
+    bool encoded{false};
+    bool done{false};
+  };
+
+  /* one slice of percy::std_synthesize that keeps the solver state */
+  const auto std_synthesize_slice = []( portfolio_entry& e, int conflict_limit ) {
+    if ( !e.encoded )
+    {
+      e.spec.preprocess();
+      if ( e.spec.nr_triv == e.spec.get_nr_out() )
+      {
+        return percy::synthesize( e.spec, e.chain, *e.solver, *e.encoder, percy::SYNTH_STD );
+      }
+      e.spec.nr_steps = e.spec.initial_steps;
+    }
+
+    assert( is_supported_exact_synthesis_config( e.config ) );
+    auto& encoder = static_cast<percy::std_encoder&>( *e.encoder );
+    while ( true )
+    {
+      if ( !e.encoded )
+      {
+        e.solver->restart();
+        if ( !encoder.encode( e.spec ) )
+        {
+          e.spec.nr_steps++;
+          continue;
+        }
+        e.encoded = true;
+      }
+
+      switch ( e.solver->solve( conflict_limit ) )
+      {
+      case percy::success:
+        encoder.extract_chain( e.spec, e.chain );
+        return percy::success;
+      case percy::failure:
+        e.spec.nr_steps++;
+        e.encoded = false;
+        break;
+      default:
+        return percy::timeout;
+      }
+    }
+  };
+
+  std::atomic<bool> found{false};
+  std::atomic<bool> failed{false};
+  std::mutex mutex;
+
+  const auto num_configs = static_cast<uint32_t>( portfolio.size() );
+  const auto num_workers = std::min( resolve_num_threads( num_threads ), num_configs );
+  run_on_threads( num_workers, [&]( uint32_t t ) {
+    /* worker t interleaves the configurations t, t + num_workers, ... */
+    std::vector<portfolio_entry> entries;
+    for ( auto i = t; i < num_configs; i += num_workers )
+    {
+      auto& e = entries.emplace_back();
+      e.config = portfolio[i];
+      e.spec = spec;
+      e.solver = percy::get_solver( e.config.solver_type );
+      e.encoder = percy::get_encoder( *e.solver, e.config.encoder_type );
+    }
+
+    auto active = true;
+    while ( active && !found.load() )
+    {
+      active = false;
+      for ( auto& e : entries )
+      {
+        if ( e.done || found.load() )
+        {
+          continue;
+        }
+        active = true;
+
+        auto budget = static_cast<int64_t>( e.slice );
+        if ( spec.conflict_limit > 0 )
+        {
+          budget = std::min<int64_t>( budget, spec.conflict_limit - e.used );
+        }
+        e.spec.conflict_limit = static_cast<int>( budget );
+
+        const auto result = e.config.synthesis_method == percy::SYNTH_STD
+                                ? std_synthesize_slice( e, static_cast<int>( budget ) )
+                                : percy::synthesize( e.spec, e.chain, *e.solver, *e.encoder, e.config.synthesis_method );
+        e.used += budget;
+        if ( result == percy::success )
+        {
+          std::lock_guard lock( mutex );
+          if ( !found.exchange( true ) )
+          {
+            chain = e.chain;
+          }
+          return;
+        }
+        else if ( result == percy::timeout && ( spec.conflict_limit == 0 || e.used < spec.conflict_limit ) )
+        {
+          if ( e.config.synthesis_method != percy::SYNTH_STD )
+          {
+            e.spec.initial_steps = e.spec.nr_steps;
+          }
+          e.slice = e.slice < ( 1 << 30 ) ? 2 * e.slice : e.slice;
+        }
+        else
+        {
+          if ( result == percy::failure )
+          {
+            failed.store( true );
+          }
+          e.done = true;
+        }
+      }
+    }
+  } );
+
+  if ( found.load() )
+  {
+    return percy::success;
+  }
+  return failed.load() ? percy::failure : percy::timeout;
+}
+
+} /* namespace detail */
+
 /*! \brief Resynthesis function based on exact synthesis.
  *
  * This resynthesis function can be passed to ``node_resynthesis``,
@@ -116,6 +350,27 @@ struct exact_resynthesis_params
       exact_resynthesis<klut_network> resyn( 3, ps );
       klut = cut_rewriting( klut, resyn );
 
+   Results can be kept across runs with a persistent ``chain_store``, which
+   stores chains of NPN representatives in a file:
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.store = std::make_shared<chain_store>( "exact.chains" );
+      exact_resynthesis<klut_network> resyn( 3, ps );
+      klut = cut_rewriting( klut, resyn );
+
+   Since no single SAT encoding is fastest for all functions, several
+   encodings can race against each other on the same function.  All of them
+   find optimum chains, and the first one to finish is taken:
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.num_threads = 4;
+      exact_resynthesis<klut_network> resyn( 3, ps );
+      klut = cut_rewriting( klut, resyn );
+
    The underlying engine for this resynthesis function is percy_.
 
    .. _percy: https://github.com/lsils/percy
@@ -147,6 +402,27 @@ public:
       return;
     }
 
+    bool const with_dont_cares = !kitty::is_const0( dont_cares );
+
+    /* the chain is synthesized for target, whose input i is leaf
+     * signals[i], complemented if complemented[i] is set */
+    std::vector<signal<Ntk>> signals( begin, end );
+    std::vector<bool> complemented( signals.size(), false );
+    auto target = function;
+    bool output_complemented{false};
+    if ( _ps.store && !with_dont_cares )
+    {
+      const std::vector<signal<Ntk>> leaves( begin, end );
+      const auto [repr, phase, perm] = chain_store::canonization( function );
+      for ( auto i = 0u; i < perm.size(); ++i )
+      {
+        signals[i] = leaves[perm[i]];
+        complemented[i] = ( phase >> perm[i] ) & 1;
+      }
+      target = repr;
+      output_complemented = ( phase >> function.num_vars() ) & 1;
+    }
+
     percy::spec spec;
     spec.fanin = _fanin_size;
     spec.verbosity = 0;
@@ -158,18 +434,25 @@ public:
     spec.add_noreapply_clauses = _ps.add_noreapply_clauses;
     spec.add_symvar_clauses = _ps.add_symvar_clauses;
     spec.conflict_limit = _ps.conflict_limit;
-    spec[0] = function;
-    bool with_dont_cares{false};
-    if ( !kitty::is_const0( dont_cares ) )
+    spec[0] = target;
+    if ( with_dont_cares )
     {
       spec.set_dont_care( 0, dont_cares );
-      with_dont_cares = true;
     }
 
+    const auto kind = "lut" + std::to_string( _fanin_size );
     auto c = [&]() -> std::optional<percy::chain> {
+      if ( !with_dont_cares && _ps.store )
+      {
+        if ( const auto chains = _ps.store->find( kind, target ); chains && !chains->empty() )
+        {
+          return chains->front();
+        }
+      }
+
       if ( !with_dont_cares && _ps.cache )
       {
-        const auto it = _ps.cache->find( function );
+        const auto it = _ps.cache->find( target );
         if ( it != _ps.cache->end() )
         {
           return it->second;
@@ -177,7 +460,7 @@ public:
       }
       else if ( !with_dont_cares && _ps.blacklist_cache )
       {
-        const auto it = _ps.blacklist_cache->find( function );
+        const auto it = _ps.blacklist_cache->find( target );
         if ( it != _ps.blacklist_cache->end() && _ps.conflict_limit >= it->second )
         {
           return std::nullopt;
@@ -185,21 +468,22 @@ public:
       }
 
       percy::chain c;
-      if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
-                                             _ps.encoder_type,
-                                             _ps.synthesis_method );
-           result != percy::success )
+      if ( const auto result = synthesize( spec, c ); result != percy::success )
       {
         if ( _ps.blacklist_cache )
         {
-          ( *_ps.blacklist_cache )[function] = result == percy::timeout ? _ps.conflict_limit : 0;
+          ( *_ps.blacklist_cache )[target] = result == percy::timeout ? _ps.conflict_limit : 0;
         }
         return std::nullopt;
       }
       c.denormalize();
       if ( !with_dont_cares && _ps.cache )
       {
-        ( *_ps.cache )[function] = c;
+        ( *_ps.cache )[target] = c;
+      }
+      if ( !with_dont_cares && _ps.store )
+      {
+        _ps.store->insert( kind, target, {c} );
       }
       return c;
     }();
@@ -209,22 +493,42 @@ public:
       return;
     }
 
-    std::vector<signal<Ntk>> signals( begin, end );
-
     for ( auto i = 0; i < c->get_nr_steps(); ++i )
     {
       std::vector<signal<Ntk>> fanin;
+      auto op = c->get_operator( i );
       for ( const auto& child : c->get_step( i ) )
       {
+        /* complemented inputs are absorbed into the operator */
+        if ( static_cast<uint32_t>( child ) < complemented.size() && complemented[child] )
+        {
+          kitty::flip_inplace( op, static_cast<uint32_t>( fanin.size() ) );
+        }
         fanin.emplace_back( signals[child] );
       }
-      signals.emplace_back( ntk.create_node( fanin, c->get_operator( i ) ) );
+      if ( output_complemented && i + 1 == c->get_nr_steps() )
+      {
+        op = ~op;
+      }
+      signals.emplace_back( ntk.create_node( fanin, op ) );
     }
 
     fn( signals.back() );
   }
 
 private:
+  percy::synth_result synthesize( percy::spec& spec, percy::chain& c ) const
+  {
+    if ( _ps.num_threads != 1u )
+    {
+      if ( const auto portfolio = detail::exact_synthesis_portfolio( _ps.portfolio, false ); !portfolio.empty() )
+      {
+        return detail::portfolio_synthesize( spec, c, portfolio, _ps.num_threads );
+      }
+    }
+    return percy::synthesize( spec, c, _ps.solver_type, _ps.encoder_type, _ps.synthesis_method );
+  }
+
   uint32_t _fanin_size{3u};
   exact_resynthesis_params _ps;
 };
@@ -291,6 +595,24 @@ public:
   void operator()( Ntk& ntk, kitty::dynamic_truth_table const& function, kitty::dynamic_truth_table const& dont_cares, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
   {
     // TODO: special case for small functions (up to 2 variables)?
+    bool const with_dont_cares = !kitty::is_const0( dont_cares );
+
+    /* the chain is synthesized for target, whose inputs are signals */
+    std::vector<signal<Ntk>> signals( begin, end );
+    auto target = function;
+    bool output_complemented{false};
+    if ( _ps.store && !with_dont_cares )
+    {
+      const std::vector<signal<Ntk>> leaves( begin, end );
+      const auto [repr, phase, perm] = chain_store::canonization( function );
+      for ( auto i = 0u; i < perm.size(); ++i )
+      {
+        signals[i] = ( ( phase >> perm[i] ) & 1 ) ? !leaves[perm[i]] : leaves[perm[i]];
+      }
+      target = repr;
+      output_complemented = ( phase >> function.num_vars() ) & 1;
+    }
+
     percy::spec spec;
     if ( !_allow_xor )
     {
@@ -310,18 +632,25 @@ public:
     {
       spec.initial_steps = *_lower_bound;
     }
-    spec[0] = function;
-    bool with_dont_cares{false};
-    if ( !kitty::is_const0( dont_cares ) )
+    spec[0] = target;
+    if ( with_dont_cares )
     {
       spec.set_dont_care( 0, dont_cares );
-      with_dont_cares = true;
     }
 
+    const std::string kind = _allow_xor ? "xag" : "aig";
     auto c = [&]() -> std::optional<percy::chain> {
+      if ( !with_dont_cares && _ps.store )
+      {
+        if ( const auto chains = _ps.store->find( kind, target ); chains && !chains->empty() )
+        {
+          return chains->front();
+        }
+      }
+
       if ( !with_dont_cares && _ps.cache )
       {
-        const auto it = _ps.cache->find( function );
+        const auto it = _ps.cache->find( target );
         if ( it != _ps.cache->end() )
         {
           return it->second;
@@ -329,16 +658,17 @@ public:
       }
 
       percy::chain c;
-      if ( const auto result = percy::synthesize( spec, c, _ps.solver_type,
-                                                  _ps.encoder_type,
-                                                  _ps.synthesis_method );
-           result != percy::success )
+      if ( const auto result = synthesize( spec, c ); result != percy::success )
       {
         return std::nullopt;
       }
       if ( !with_dont_cares && _ps.cache )
       {
-        ( *_ps.cache )[function] = c;
+        ( *_ps.cache )[target] = c;
+      }
+      if ( !with_dont_cares && _ps.store )
+      {
+        _ps.store->insert( kind, target, {c} );
       }
       return c;
     }();
@@ -348,7 +678,6 @@ public:
       return;
     }
 
-    std::vector<signal<Ntk>> signals( begin, end );
     for ( auto i = 0; i < c->get_nr_steps(); ++i )
     {
       auto c1 = signals[c->get_step( i )[0]];
@@ -377,7 +706,7 @@ public:
       }
     }
 
-    fn( c->is_output_inverted( 0 ) ? !signals.back() : signals.back() );
+    fn( c->is_output_inverted( 0 ) != output_complemented ? !signals.back() : signals.back() );
   }
 
   void set_bounds( std::optional<uint32_t> const& lower_bound, std::optional<uint32_t> const& upper_bound )
@@ -387,6 +716,18 @@ public:
   }
 
 private:
+  percy::synth_result synthesize( percy::spec& spec, percy::chain& c ) const
+  {
+    if ( _ps.num_threads != 1u )
+    {
+      if ( const auto portfolio = detail::exact_synthesis_portfolio( _ps.portfolio, !_allow_xor ); !portfolio.empty() )
+      {
+        return detail::portfolio_synthesize( spec, c, portfolio, _ps.num_threads );
+      }
+    }
+    return percy::synthesize( spec, c, _ps.solver_type, _ps.encoder_type, _ps.synthesis_method );
+  }
+
   bool _allow_xor = false;
   exact_resynthesis_params _ps;
 
@@ -398,6 +739,9 @@ struct exact_xmg_resynthesis_params
 {
   uint32_t num_candidates{10u};
   bool use_only_self_dual_gates{false};
+
+  /*! \brief Persistent store for candidate chains of NPN representatives. */
+  std::shared_ptr<chain_store> store;
 };
 
 /*! \brief Resynthesis function based on exact synthesis for XMGs.
@@ -441,7 +785,24 @@ public:
 
     using signal = mockturtle::signal<Ntk>;
     auto const tt = function.num_vars() < 3u ? kitty::extend_to( function, 3u ) : function;
-    bool const normal = kitty::is_normal( tt );
+
+    /* the chains are synthesized for target, whose inputs are leaves */
+    std::vector<signal> leaves( tt.num_vars(), ntk.get_constant( false ) );
+    std::copy( begin, end, leaves.begin() );
+    auto target = tt;
+    bool output_complemented{false};
+    if ( ps.store )
+    {
+      auto const pis = leaves;
+      auto const [repr, phase, perm] = chain_store::canonization( tt );
+      for ( auto i = 0u; i < perm.size(); ++i )
+      {
+        leaves[i] = ( ( phase >> perm[i] ) & 1 ) ? !pis[perm[i]] : pis[perm[i]];
+      }
+      target = repr;
+      output_complemented = ( phase >> tt.num_vars() ) & 1;
+    }
+    bool const normal = kitty::is_normal( target );
 
     percy::chain chain;
     percy::spec spec;
@@ -489,24 +850,10 @@ public:
       spec.add_primitive( kitty::ternary_majority(   a, ~b,  const0 ) ); // 22
     }
 
-    percy::bsat_wrapper solver;
-    percy::ssv_encoder encoder(solver);
-
-    spec[0] = normal ? tt : ~tt;
+    spec[0] = normal ? target : ~target;
 
-    for ( auto i = 0u; i < ps.num_candidates; ++i )
-    {
-      auto const result = percy::next_struct_solution( spec, chain, solver, encoder );
-      if ( result != percy::success )
-        break;
-
-      assert( result == percy::success );
-
-      auto const sim = chain.simulate();
-      assert( chain.simulate()[0] == spec[0] );
-
-      std::vector<signal> signals( tt.num_vars(), ntk.get_constant( false ) );
-      std::copy( begin, end, signals.begin() );
+    auto const create_chain = [&]( percy::chain& chain ) {
+      std::vector<signal> signals = leaves;
 
       for ( auto i = 0; i < chain.get_nr_steps(); ++i )
       {
@@ -589,15 +936,64 @@ public:
       assert( chain.get_outputs().size() > 0u );
       uint32_t const output_index = ( chain.get_outputs()[0u] >> 1u );
       auto const output_signal = output_index == 0u ? ntk.get_constant( false ) : signals[output_index - 1];
-      if ( !fn( chain.is_output_inverted( 0 ) ^ normal ? output_signal : !output_signal ) )
+      return fn( chain.is_output_inverted( 0 ) ^ normal ^ output_complemented ? output_signal : !output_signal );
+    };
+
+    std::string const kind = ( ps.use_only_self_dual_gates ? "xmg-sd:" : "xmg:" ) + std::to_string( ps.num_candidates );
+    if ( ps.store )
+    {
+      if ( auto chains = ps.store->find( kind, target ) )
+      {
+        for ( auto& chain : *chains )
+        {
+          if ( !create_chain( chain ) )
+          {
+            return; /* quit */
+          }
+        }
+        return;
+      }
+    }
+
+    percy::bsat_wrapper solver;
+    percy::ssv_encoder encoder(solver);
+
+    std::vector<percy::chain> chains;
+    for ( auto i = 0u; i < ps.num_candidates; ++i )
+    {
+      auto const result = percy::next_struct_solution( spec, chain, solver, encoder );
+      if ( result != percy::success )
+        break;
+
+      assert( result == percy::success );
+      assert( chain.simulate()[0] == spec[0] );
+
+      /* with a store, all candidates are computed before they are used */
+      if ( ps.store )
+      {
+        chains.push_back( chain );
+      }
+      else if ( !create_chain( chain ) )
       {
         return; /* quit */
       }
     }
+
+    if ( ps.store )
+    {
+      ps.store->insert( kind, target, chains );
+      for ( auto& chain : chains )
+      {
+        if ( !create_chain( chain ) )
+        {
+          return; /* quit */
+        }
+      }
+    }
   }
 
 protected:
-  exact_xmg_resynthesis_params const& ps;
+  exact_xmg_resynthesis_params ps;
 }; /* exact_xmg_resynthesis */
 
 } /* namespace mockturtle */
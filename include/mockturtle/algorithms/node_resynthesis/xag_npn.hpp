@@ -47,6 +47,7 @@
 #include "../../networks/xag.hpp"
 #include "../../utils/index_list.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn4_table.hpp"
 #include "../../utils/stopwatch.hpp"
 
 namespace mockturtle
@@ -58,6 +59,14 @@ struct xag_npn_resynthesis_params
   bool verbose{false};
 };
 
+namespace detail
+{
+
+template<class DatabaseNtk>
+struct xag_npn_database;
+
+} /* namespace detail */
+
 struct xag_npn_resynthesis_stats
 {
   stopwatch<>::duration time_classes{0};
@@ -79,6 +88,10 @@ struct xag_npn_resynthesis_stats
  * produce a network based on pre-computed XAGs with up to at most 4 variables.
  * Consequently, the nodes' fan-in sizes in the input network must not exceed
  * 4.
+ *
+ * The NPN classification (see `npn4_table`) and the decoded database are
+ * built once per process and shared by all instances, so that constructing
+ * further resynthesis objects is cheap.
  *
    \verbatim embed:rst
 
@@ -102,8 +115,7 @@ class xag_npn_resynthesis
 public:
   xag_npn_resynthesis( xag_npn_resynthesis_params const& ps = {}, xag_npn_resynthesis_stats* pst = nullptr )
       : ps( ps ),
-        pst( pst ),
-        _repr( 1u << 16u )
+        pst( pst )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
@@ -146,11 +158,11 @@ public:
     kitty::static_truth_table<4u> tt = kitty::extend_to<4u>( function );
 
     /* get representative of function */
-    const auto [repr, phase, perm] = _repr[*tt.cbegin()];
+    const auto [repr, phase, perm] = _npn->canonization( tt );
 
     /* check if representative has circuits */
-    const auto it = _repr_to_signal.find( repr );
-    if ( it == _repr_to_signal.end() )
+    const auto it = _db->repr_to_signal.find( repr );
+    if ( it == _db->repr_to_signal.end() )
     {
       return;
     }
@@ -167,8 +179,8 @@ public:
 
     for ( auto const& cand : it->second )
     {
-      const auto f = copy_db_entry( ntk, _db.get_node( cand ), db_to_ntk );
-      if ( !fn( _db.is_complemented( cand ) != ( phase >> 4 & 1 ) ? ntk.create_not( f ) : f ) )
+      const auto f = copy_db_entry( ntk, _db->db.get_node( cand ), db_to_ntk );
+      if ( !fn( _db->db.is_complemented( cand ) != ( phase >> 4 & 1 ) ? ntk.create_not( f ) : f ) )
       {
         return;
       }
@@ -185,12 +197,12 @@ private:
     }
 
     std::array<signal<Ntk>, 2> fanin{};
-    _db.foreach_fanin( n, [&]( auto const& f, auto i ) {
-      const auto ntk_f = copy_db_entry( ntk, _db.get_node( f ), db_to_ntk );
-      fanin[i] = _db.is_complemented( f ) ? ntk.create_not( ntk_f ) : ntk_f;
+    _db->db.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      const auto ntk_f = copy_db_entry( ntk, _db->db.get_node( f ), db_to_ntk );
+      fanin[i] = _db->db.is_complemented( f ) ? ntk.create_not( ntk_f ) : ntk_f;
     } );
 
-    const auto f = _db.is_xor( n ) ? ntk.create_xor( fanin[0], fanin[1] ) : ntk.create_and( fanin[0], fanin[1] );
+    const auto f = _db->db.is_xor( n ) ? ntk.create_xor( fanin[0], fanin[1] ) : ntk.create_and( fanin[0], fanin[1] );
     db_to_ntk.insert( {n, f} );
     return f;
   }
@@ -198,63 +210,70 @@ private:
   void build_classes()
   {
     stopwatch t( st.time_classes );
-
-    kitty::static_truth_table<4u> tt;
-    do {
-      _repr[*tt.cbegin()] = kitty::exact_npn_canonization( tt );
-      kitty::next_inplace( tt );
-    } while ( !kitty::is_const0( tt ) );
+    _npn = &npn4_table::instance();
   }
 
   void build_db()
   {
     stopwatch t( st.time_db );
+    _db = &detail::xag_npn_database<DatabaseNtk>::instance();
+
+    st.db_size = _db->db.size();
+    st.covered_classes = static_cast<uint32_t>( _db->repr_to_signal.size() );
+  }
+
+  xag_npn_resynthesis_params ps;
+  xag_npn_resynthesis_stats st;
+  xag_npn_resynthesis_stats* pst{nullptr};
+
+  npn4_table const* _npn{nullptr};
+  detail::xag_npn_database<DatabaseNtk> const* _db{nullptr};
+};
+
+namespace detail
+{
+
+/*! \brief Decoded database of `xag_npn_resynthesis`.
+ *
+ * The database is built once per process and database network type, and
+ * shared by all resynthesis objects.  It is only read after construction.
+ */
+template<class DatabaseNtk>
+struct xag_npn_database
+{
+  static xag_npn_database const& instance()
+  {
+    static const xag_npn_database database;
+    return database;
+  }
+
+  DatabaseNtk db;
+  std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> repr_to_signal;
+
+private:
+  xag_npn_database()
+  {
+    auto const& npn = npn4_table::instance();
 
-    decode( _db, xag_index_list{std::vector<uint32_t>{subgraphs, subgraphs + sizeof subgraphs / sizeof subgraphs[0]}} );
-    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( _db );
+    decode( db, xag_index_list{std::vector<uint32_t>{subgraphs, subgraphs + sizeof subgraphs / sizeof subgraphs[0]}} );
+    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( db );
 
-    _db.foreach_node( [&]( auto n ) {
-      if ( std::get<0>( _repr[*sim_res[n].cbegin()] ) == sim_res[n] )
+    db.foreach_node( [&]( auto n ) {
+      if ( npn.representative( static_cast<uint16_t>( *sim_res[n].cbegin() ) ) == *sim_res[n].cbegin() )
       {
-        if ( _repr_to_signal.count( sim_res[n] ) == 0 )
-        {
-          _repr_to_signal.insert( {sim_res[n], {_db.make_signal( n )}} );
-        }
-        else
-        {
-          _repr_to_signal[sim_res[n]].push_back( _db.make_signal( n ) );
-        }
+        repr_to_signal[sim_res[n]].push_back( db.make_signal( n ) );
       }
       else
       {
         const auto f = ~sim_res[n];
-        if ( std::get<0>( _repr[*f.cbegin()] ) == f )
+        if ( npn.representative( static_cast<uint16_t>( *f.cbegin() ) ) == *f.cbegin() )
         {
-          if ( _repr_to_signal.count( f ) == 0 )
-          {
-            _repr_to_signal.insert( {f, {!_db.make_signal( n )}} );
-          }
-          else
-          {
-            _repr_to_signal[f].push_back( !_db.make_signal( n ) );
-          }
+          repr_to_signal[f].push_back( !db.make_signal( n ) );
         }
       }
     } );
-
-    st.db_size = _db.size();
-    st.covered_classes = static_cast<uint32_t>( _repr_to_signal.size() );
   }
 
-  xag_npn_resynthesis_params ps;
-  xag_npn_resynthesis_stats st;
-  xag_npn_resynthesis_stats* pst{nullptr};
-
-  std::vector<std::tuple<kitty::static_truth_table<4u>, uint32_t, std::vector<uint8_t>>> _repr;
-  std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> _repr_to_signal;
-
-  DatabaseNtk _db;
-
   // clang-format off
   inline static const uint32_t subgraphs[] = {1780 << 16 | 0 << 8 | 4,
       2, 4, 2, 5, 3, 4, 3, 5, 4, 2, 2, 6, 2, 7, 3, 6, 3, 7, 6, 2, 4, 6,
@@ -435,7 +454,9 @@ private:
       67, 1370, 1372, 144, 1374, 16, 25, 1378, 245, 1382, 555, 1382, 891, 1382, 143, 1385, 497, 1385, 804, 1387,
       1388, 816, 143, 1391, 497, 1391, 379, 1392, 143, 1394, 1396, 78, 39, 1399, 650, 1401, 679, 1401, 1400, 796,
       39, 1403, 1404, 796, 233, 1407, 699, 1407, 11, 1409, 245, 1411, 555, 1411, 891, 1411, 61, 1413};
-  // clang-format off
-}; // namespace mockturtle
+  // clang-format on
+};
+
+} /* namespace detail */
 
 } /* namespace mockturtle */
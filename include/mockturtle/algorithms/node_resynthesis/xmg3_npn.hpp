@@ -34,12 +34,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include <fmt/format.h>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
-#include <kitty/npn.hpp>
 #include <kitty/print.hpp>
 #include <kitty/static_truth_table.hpp>
 
@@ -47,6 +47,7 @@
 #include "../../io/write_bench.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn4_table.hpp"
 #include "../../utils/stopwatch.hpp"
 #include "../../views/topo_view.hpp"
 
@@ -59,6 +60,14 @@ struct xmg3_npn_resynthesis_params
   bool verbose{false};
 };
 
+namespace detail
+{
+
+template<class DatabaseNtk>
+struct xmg3_npn_database;
+
+} /* namespace detail */
+
 struct xmg3_npn_resynthesis_stats
 {
   stopwatch<>::duration time_classes{0};
@@ -80,6 +89,9 @@ struct xmg3_npn_resynthesis_stats
  * produce a network based on pre-computed xmg3s with up to at most 4 variables.
  * Consequently, the nodes' fan-in sizes in the input network must not exceed
  * 4.
+ *
+ * The NPN classification (see `npn4_table`) and the decoded database are
+ * built once per process and shared by all instances.
  *
    \verbatim embed:rst
 
@@ -103,8 +115,7 @@ class xmg3_npn_resynthesis
 public:
   xmg3_npn_resynthesis( xmg3_npn_resynthesis_params const& ps = {}, xmg3_npn_resynthesis_stats* pst = nullptr )
       : ps( ps ),
-        pst( pst ),
-        _classes( 1 << 16 )
+        pst( pst )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
@@ -124,7 +135,6 @@ public:
     static_assert( has_foreach_node_v<DatabaseNtk>, "DatabaseNtk does not implement the foreach_node method" );
     static_assert( has_make_signal_v<DatabaseNtk>, "DatabaseNtk does not implement the make_signal method" );
 
-    _repr.reserve( 222u );
     build_classes();
     build_db();
   }
@@ -148,30 +158,24 @@ public:
     kitty::static_truth_table<4u> tt = kitty::extend_to<4u>( function );
 
     /* get representative of function */
-    const auto repr = _repr[_classes[*tt.cbegin()]];
+    const auto [repr, phase, perm] = _npn->canonization( tt );
 
     /* check if representative has circuits */
-    const auto it = _repr_to_signal.find( repr );
-    if ( it == _repr_to_signal.end() )
+    const auto it = _db->repr_to_signal.find( repr );
+    if ( it == _db->repr_to_signal.end() )
     {
       return;
     }
 
-    const auto config = kitty::exact_npn_canonization( tt );
-
-    assert( repr == std::get<0>( config ) );
-
     std::vector<signal<Ntk>> pis( 4, ntk.get_constant( false ) );
     std::copy( begin, end, pis.begin() );
 
     std::vector<signal<Ntk>> pis_perm;
-    auto perm = std::get<2>( config );
     for ( auto i = 0; i < 4; ++i )
     {
       pis_perm.push_back( pis[perm[i]] );
     }
 
-    const auto& phase = std::get<1>( config );
     for ( auto i = 0; i < 4; ++i )
     {
       if ( ( phase >> perm[i] ) & 1 )
@@ -189,8 +193,8 @@ public:
       {
         db_to_ntk.insert( {i + 1, pis_perm[i]} );
       }
-      auto f = copy_db_entry( ntk, _db.get_node( cand ), db_to_ntk );
-      if ( _db.is_complemented( cand ) != ( ( phase >> 4 ) & 1 ) )
+      auto f = copy_db_entry( ntk, _db->db.get_node( cand ), db_to_ntk );
+      if ( _db->db.is_complemented( cand ) != ( ( phase >> 4 ) & 1 ) )
       {
         f = ntk.create_not( f );
       }
@@ -212,16 +216,16 @@ private:
 
     std::vector<signal<Ntk>> fanin;
     //std::array<signal<Ntk>, 2> fanin;
-    _db.foreach_fanin( n, [&]( auto const& f ) {
-      auto ntk_f = copy_db_entry( ntk, _db.get_node( f ), db_to_ntk );
-      if ( _db.is_complemented( f ) )
+    _db->db.foreach_fanin( n, [&]( auto const& f ) {
+      auto ntk_f = copy_db_entry( ntk, _db->db.get_node( f ), db_to_ntk );
+      if ( _db->db.is_complemented( f ) )
       {
         ntk_f = ntk.create_not( ntk_f );
       }
       fanin.push_back( ntk_f );
     } );
 
-    const auto f = _db.is_xor3( n ) ? ntk.create_xor3( fanin[0], fanin[1], fanin[2] ) : ntk.create_maj( fanin[0], fanin[1], fanin[2] );
+    const auto f = _db->db.is_xor3( n ) ? ntk.create_xor3( fanin[0], fanin[1], fanin[2] ) : ntk.create_maj( fanin[0], fanin[1], fanin[2] );
     db_to_ntk.insert( {n, f} );
     return f;
   }
@@ -229,36 +233,57 @@ private:
   void build_classes()
   {
     stopwatch t( st.time_classes );
-
-    kitty::dynamic_truth_table map( 16u );
-    std::transform( map.cbegin(), map.cend(), map.begin(), []( auto word ) { return ~word; } );
-
-    int64_t index = 0;
-    kitty::static_truth_table<4u> tt;
-    while ( index != -1 )
-    {
-      kitty::create_from_words( tt, &index, &index + 1 );
-      const auto res = kitty::exact_npn_canonization( tt, [&]( const auto& tt ) {
-        _classes[*tt.cbegin()] = _repr.size();
-        kitty::clear_bit( map, *tt.cbegin() );
-      } );
-      _repr.push_back( std::get<0>( res ) );
-
-      /* find next non-classified truth table */
-      index = find_first_one_bit( map );
-    }
+    _npn = &npn4_table::instance();
   }
 
   void build_db()
   {
     stopwatch t( st.time_db );
+    _db = &detail::xmg3_npn_database<DatabaseNtk>::instance();
+
+    st.db_size = _db->db.size();
+    st.covered_classes = static_cast<uint32_t>( _db->repr_to_signal.size() );
+  }
+
+  xmg3_npn_resynthesis_params ps;
+  xmg3_npn_resynthesis_stats st;
+  xmg3_npn_resynthesis_stats* pst{nullptr};
+
+  npn4_table const* _npn{nullptr};
+  detail::xmg3_npn_database<DatabaseNtk> const* _db{nullptr};
+};
+
+namespace detail
+{
+
+/*! \brief Decoded database of `xmg3_npn_resynthesis`.
+ *
+ * The database is built once per process and database network type, and
+ * shared by all resynthesis objects.  It is only read after construction.
+ */
+template<class DatabaseNtk>
+struct xmg3_npn_database
+{
+  static xmg3_npn_database const& instance()
+  {
+    static const xmg3_npn_database database;
+    return database;
+  }
+
+  DatabaseNtk db;
+  std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> repr_to_signal;
 
-    _db.get_constant( false );
+private:
+  xmg3_npn_database()
+  {
+    auto const& npn = npn4_table::instance();
+
+    db.get_constant( false );
     /* four primary inputs */
-    _db.create_pi();
-    _db.create_pi();
-    _db.create_pi();
-    _db.create_pi();
+    db.create_pi();
+    db.create_pi();
+    db.create_pi();
+    db.create_pi();
 
     auto* p = subgraphs;
     while ( true )
@@ -273,65 +298,38 @@ private:
       auto is_xor = entry0 & 1;
       entry0 >>= 1;
 
-      const auto child0 = _db.make_signal( entry0 >> 1 ) ^ ( entry0 & 1 );
-      const auto child1 = _db.make_signal( entry1 >> 1 ) ^ ( entry1 & 1 );
-      const auto child2 = _db.make_signal( entry2 >> 1 ) ^ ( entry2 & 1 );
+      const auto child0 = db.make_signal( entry0 >> 1 ) ^ ( entry0 & 1 );
+      const auto child1 = db.make_signal( entry1 >> 1 ) ^ ( entry1 & 1 );
+      const auto child2 = db.make_signal( entry2 >> 1 ) ^ ( entry2 & 1 );
 
       if ( is_xor )
       {
-        _db.create_xor3( child0, child1, child2 );
+        db.create_xor3( child0, child1, child2 );
       }
       else
       {
-        _db.create_maj( child0, child1, child2 );
+        db.create_maj( child0, child1, child2 );
       }
     }
 
-    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( _db );
+    const auto sim_res = simulate_nodes<kitty::static_truth_table<4u>>( db );
 
-    _db.foreach_node( [&]( auto n ) {
-      if ( _repr[_classes[*sim_res[n].cbegin()]] == sim_res[n] )
+    db.foreach_node( [&]( auto n ) {
+      if ( npn.representative( static_cast<uint16_t>( *sim_res[n].cbegin() ) ) == *sim_res[n].cbegin() )
       {
-        if ( _repr_to_signal.count( sim_res[n] ) == 0 )
-        {
-          _repr_to_signal.insert( {sim_res[n], {_db.make_signal( n )}} );
-        }
-        else
-        {
-          _repr_to_signal[sim_res[n]].push_back( _db.make_signal( n ) );
-        }
+        repr_to_signal[sim_res[n]].push_back( db.make_signal( n ) );
       }
       else
       {
         const auto f = ~sim_res[n];
-        if ( _repr[_classes[*f.cbegin()]] == f )
+        if ( npn.representative( static_cast<uint16_t>( *f.cbegin() ) ) == *f.cbegin() )
         {
-          if ( _repr_to_signal.count( f ) == 0 )
-          {
-            _repr_to_signal.insert( {f, {!_db.make_signal( n )}} );
-          }
-          else
-          {
-            _repr_to_signal[f].push_back( !_db.make_signal( n ) );
-          }
+          repr_to_signal[f].push_back( !db.make_signal( n ) );
         }
       }
     } );
-
-    st.db_size = _db.size();
-    st.covered_classes = static_cast<uint32_t>( _repr_to_signal.size() );
   }
 
-  xmg3_npn_resynthesis_params ps;
-  xmg3_npn_resynthesis_stats st;
-  xmg3_npn_resynthesis_stats* pst{nullptr};
-
-  std::vector<kitty::static_truth_table<4u>> _repr;
-  std::vector<uint32_t> _classes;
-  std::unordered_map<kitty::static_truth_table<4u>, std::vector<signal<DatabaseNtk>>, kitty::hash<kitty::static_truth_table<4u>>> _repr_to_signal;
-
-  DatabaseNtk _db;
-
   // clang-format off
   inline static const uint16_t subgraphs[]
   {
@@ -339,6 +337,8 @@ private:
 
   };
   // clang-format on
-}; // namespace mockturtle
+};
+
+} /* namespace detail */
 
 } /* namespace mockturtle */
@@ -0,0 +1,391 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parallel_equivalence_checking.hpp
+  \brief Output-partitioned parallel combinational equivalence checking
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <fmt/format.h>
+
+#include "../traits.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/stopwatch.hpp"
+#include "circuit_validator.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for parallel_equivalence_checking.
+ *
+ * The data structure `parallel_equivalence_checking_params` holds
+ * configurable parameters with default arguments for
+ * `parallel_equivalence_checking`.
+ */
+struct parallel_equivalence_checking_params
+{
+  /*! \brief Number of threads (0 uses all hardware threads). */
+  uint32_t num_threads{0u};
+
+  /*! \brief Conflict limit for each output (0 means no limit). */
+  uint32_t conflict_limit{0u};
+
+  /*! \brief Number of conflicts after which a solver checks whether a
+   * counter-example has been found by another thread. */
+  uint32_t conflict_interval{1000u};
+
+  /*! \brief Maximum number of gates in a group of overlapping output cones.
+   *
+   * Output cones that share gates are checked with the same solver, unless
+   * the group would exceed this size.
+   */
+  uint32_t max_group_size{20000u};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Result of checking one output of a miter. */
+enum class miter_output_status : uint8_t
+{
+  /*! \brief Not checked, because a counter-example was found for another output. */
+  skipped,
+  /*! \brief Output is constant 0. */
+  equivalent,
+  /*! \brief Output is 1 for some input assignment. */
+  not_equivalent,
+  /*! \brief Resource limit was reached. */
+  timeout
+};
+
+/*! \brief Statistics for parallel_equivalence_checking.
+ *
+ * The data structure `parallel_equivalence_checking_stats` provides data
+ * collected by running `parallel_equivalence_checking`.
+ */
+struct parallel_equivalence_checking_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Number of groups of output cones. */
+  uint32_t num_groups{0};
+
+  /*! \brief Result for each output. */
+  std::vector<miter_output_status> output_status;
+
+  /*! \brief Output with counter-example, in case the miter is not equivalent. */
+  std::optional<uint32_t> failing_output;
+
+  /*! \brief Counter-example, in case the miter is not equivalent. */
+  std::vector<bool> counter_example;
+
+  void report() const
+  {
+    const auto count = [&]( miter_output_status status ) {
+      return std::count( output_status.begin(), output_status.end(), status );
+    };
+
+    std::cout << fmt::format( "[i] groups         = {:8d}\n", num_groups );
+    std::cout << fmt::format( "[i] equivalent     = {:8d}\n", count( miter_output_status::equivalent ) );
+    std::cout << fmt::format( "[i] not equivalent = {:8d}\n", count( miter_output_status::not_equivalent ) );
+    std::cout << fmt::format( "[i] timeout        = {:8d}\n", count( miter_output_status::timeout ) );
+    std::cout << fmt::format( "[i] skipped        = {:8d}\n", count( miter_output_status::skipped ) );
+    if ( failing_output )
+    {
+      std::cout << fmt::format( "[i] failing output = {:8d}\n", *failing_output );
+    }
+    std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class parallel_equivalence_checking_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using validator_t = circuit_validator<Ntk, bill::solvers::bsat2>;
+
+  parallel_equivalence_checking_impl( Ntk const& miter, parallel_equivalence_checking_params const& ps, parallel_equivalence_checking_stats& st )
+      : miter( miter ),
+        ps( ps ),
+        st( st )
+  {
+  }
+
+  std::optional<bool> run()
+  {
+    stopwatch t( st.time_total );
+
+    miter.foreach_po( [&]( auto const& f ) {
+      outputs.push_back( f );
+    } );
+    st.output_status.assign( outputs.size(), miter_output_status::skipped );
+
+    compute_groups();
+    st.num_groups = static_cast<uint32_t>( groups.size() );
+
+    std::atomic<uint32_t> next_group{0u};
+    run_on_threads( std::min<uint32_t>( resolve_num_threads( ps.num_threads ), std::max<uint32_t>( st.num_groups, 1u ) ), [&]( uint32_t ) {
+      for ( auto g = next_group++; g < groups.size(); g = next_group++ )
+      {
+        check_group( groups[g] );
+      }
+    } );
+
+    if ( st.failing_output )
+    {
+      return false;
+    }
+    if ( std::any_of( st.output_status.begin(), st.output_status.end(), []( auto status ) { return status != miter_output_status::equivalent; } ) )
+    {
+      return std::nullopt;
+    }
+    return true;
+  }
+
+private:
+  /* Groups outputs whose cones share gates, as long as the group does not
+   * exceed `max_group_size` gates.  Groups are sorted by decreasing size,
+   * such that large groups are started first. */
+  void compute_groups()
+  {
+    constexpr auto no_group = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> parent( outputs.size() ), size( outputs.size(), 0u );
+    std::iota( parent.begin(), parent.end(), 0u );
+    const auto find = [&]( uint32_t i ) {
+      while ( parent[i] != i )
+      {
+        i = parent[i] = parent[parent[i]];
+      }
+      return i;
+    };
+
+    std::vector<uint32_t> owner( miter.size(), no_group ), visited( miter.size(), no_group );
+    std::vector<node> stack;
+    for ( auto i = 0u; i < outputs.size(); ++i )
+    {
+      stack.push_back( miter.get_node( outputs[i] ) );
+      while ( !stack.empty() )
+      {
+        const auto n = stack.back();
+        stack.pop_back();
+        const auto index = miter.node_to_index( n );
+        if ( visited[index] == i || miter.is_constant( n ) || miter.is_pi( n ) )
+        {
+          continue;
+        }
+        visited[index] = i;
+
+        if ( owner[index] == no_group )
+        {
+          owner[index] = i;
+          ++size[find( i )];
+        }
+        else
+        {
+          const auto a = find( owner[index] ), b = find( i );
+          if ( a != b && size[a] + size[b] <= ps.max_group_size )
+          {
+            parent[b] = a;
+            size[a] += size[b];
+          }
+        }
+
+        miter.foreach_fanin( n, [&]( auto const& f ) {
+          stack.push_back( miter.get_node( f ) );
+        } );
+      }
+    }
+
+    std::vector<uint32_t> group_of( outputs.size(), no_group );
+    for ( auto i = 0u; i < outputs.size(); ++i )
+    {
+      const auto root = find( i );
+      if ( group_of[root] == no_group )
+      {
+        group_of[root] = static_cast<uint32_t>( groups.size() );
+        groups.emplace_back();
+        group_sizes.push_back( size[root] );
+      }
+      groups[group_of[root]].push_back( i );
+    }
+
+    std::vector<uint32_t> order( groups.size() );
+    std::iota( order.begin(), order.end(), 0u );
+    std::stable_sort( order.begin(), order.end(), [&]( auto a, auto b ) { return group_sizes[a] > group_sizes[b]; } );
+    std::vector<std::vector<uint32_t>> sorted;
+    for ( auto g : order )
+    {
+      sorted.emplace_back( std::move( groups[g] ) );
+    }
+    groups.swap( sorted );
+  }
+
+  /* Checks all outputs of a group with one solver, which shares the CNF of
+   * common gates.  The solver is interrupted every `conflict_interval`
+   * conflicts to stop early if another thread found a counter-example. */
+  void check_group( std::vector<uint32_t> const& group )
+  {
+    validator_params vps;
+    vps.max_clauses = std::numeric_limits<uint32_t>::max();
+    vps.conflict_limit = ps.conflict_interval;
+    validator_t validator( miter, vps );
+
+    for ( auto i : group )
+    {
+      uint64_t conflicts{0u};
+      std::optional<bool> res;
+      while ( !cex_found.load() )
+      {
+        res = validator.validate( outputs[i], false );
+        conflicts += ps.conflict_interval;
+        if ( res || ( ps.conflict_limit != 0u && conflicts >= ps.conflict_limit ) )
+        {
+          break;
+        }
+      }
+
+      if ( !res )
+      {
+        if ( !cex_found.load() )
+        {
+          st.output_status[i] = miter_output_status::timeout;
+        }
+        continue;
+      }
+      if ( *res )
+      {
+        st.output_status[i] = miter_output_status::equivalent;
+        continue;
+      }
+
+      st.output_status[i] = miter_output_status::not_equivalent;
+      std::lock_guard<std::mutex> lock( cex_mutex );
+      if ( !st.failing_output )
+      {
+        st.failing_output = i;
+        st.counter_example = validator.cex;
+      }
+      cex_found = true;
+      return;
+    }
+  }
+
+private:
+  Ntk const& miter;
+  parallel_equivalence_checking_params const& ps;
+  parallel_equivalence_checking_stats& st;
+
+  std::vector<signal> outputs;
+  std::vector<std::vector<uint32_t>> groups;
+  std::vector<uint32_t> group_sizes;
+
+  std::atomic<bool> cex_found{false};
+  std::mutex cex_mutex;
+};
+
+} // namespace detail
+
+/*! \brief Output-partitioned parallel combinational equivalence checking.
+ *
+ * This function expects a miter with one output for each pair of outputs of
+ * the two networks, e.g., generated with `miter` and `combine_outputs` set to
+ * false.  The miter is equivalent if all outputs are constant 0.  A miter
+ * with a single output is checked as one group.
+ *
+ * Outputs whose cones share gates are grouped, such that they share the CNF
+ * of common logic, and each group is checked with its own incremental SAT
+ * solver.  Groups are distributed among `num_threads` threads.  When a
+ * counter-example is found for some output, the remaining outputs are
+ * skipped and running solvers stop after at most `conflict_interval`
+ * conflicts.
+ *
+ * Like `equivalence_checking`, the function returns `nullopt` if no result
+ * could be found due to resource limits, `true` if the miter is equivalent,
+ * and `false` if it is not.  The result for each output, the failing output,
+ * and the counter-example are written to the statistics.
+ *
+ * **Required network functions:**
+ * - `foreach_fanin`
+ * - `foreach_po`
+ * - `get_node`
+ * - `is_constant`
+ * - `is_pi`
+ * - `node_to_index`
+ * - `size`
+ *
+ * \param miter Miter network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk>
+std::optional<bool> parallel_equivalence_checking( Ntk const& miter, parallel_equivalence_checking_params const& ps = {}, parallel_equivalence_checking_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+
+  parallel_equivalence_checking_stats st;
+  detail::parallel_equivalence_checking_impl<Ntk> impl( miter, ps, st );
+  const auto result = impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return result;
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,370 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parallel_resubstitution.hpp
+  \brief Partition-parallel resubstitution
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/topo_view.hpp"
+#include "cleanup.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for parallel_resubstitution.
+ *
+ * The data structure `parallel_resubstitution_params` holds configurable
+ * parameters with default arguments for `parallel_resubstitution`.
+ */
+struct parallel_resubstitution_params
+{
+  /*! \brief Number of threads (0 uses all hardware threads). */
+  uint32_t num_threads{0u};
+
+  /*! \brief Maximum number of gates in a region. */
+  uint32_t max_region_size{5000u};
+
+  /*! \brief Number of passes, region boundaries are shifted in each pass. */
+  uint32_t num_passes{2u};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for parallel_resubstitution.
+ *
+ * The data structure `parallel_resubstitution_stats` provides data collected
+ * by running `parallel_resubstitution`.
+ */
+struct parallel_resubstitution_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Runtime to extract regions and to stitch them back. */
+  stopwatch<>::duration time_partition{0};
+
+  /*! \brief Runtime of resubstitution on the regions (wall clock). */
+  stopwatch<>::duration time_resub{0};
+
+  /*! \brief Number of regions over all passes. */
+  uint32_t num_regions{0};
+
+  /*! \brief Initial number of gates. */
+  uint32_t initial_size{0};
+
+  /*! \brief Final number of gates. */
+  uint32_t final_size{0};
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] regions        = {:8d}\n", num_regions );
+    std::cout << fmt::format( "[i] gates          = {:8d} -> {:d}\n", initial_size, final_size );
+    std::cout << fmt::format( "[i] partition time = {:>5.2f} secs\n", to_seconds( time_partition ) );
+    std::cout << fmt::format( "[i] resub time     = {:>5.2f} secs\n", to_seconds( time_resub ) );
+    std::cout << fmt::format( "[i] total time     = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk, class ResubFn>
+class parallel_resubstitution_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  parallel_resubstitution_impl( Ntk& ntk, ResubFn& resub_fn, parallel_resubstitution_params const& ps, parallel_resubstitution_stats& st )
+      : ntk( ntk ),
+        resub_fn( resub_fn ),
+        ps( ps ),
+        st( st )
+  {
+  }
+
+  void run()
+  {
+    stopwatch t( st.time_total );
+
+    st.initial_size = ntk.num_gates();
+    for ( auto pass = 0u; pass < std::max( ps.num_passes, 1u ); ++pass )
+    {
+      run_pass( pass );
+    }
+    st.final_size = ntk.num_gates();
+  }
+
+private:
+  /* A region is a contiguous range of gates in topological order.  Its
+   * inputs are the fanins from earlier regions and its outputs are the gates
+   * referenced by later regions or by primary outputs. */
+  struct region
+  {
+    Ntk ntk;
+    std::vector<node> leaves;
+    std::vector<node> roots;
+  };
+
+  void run_pass( uint32_t pass )
+  {
+    std::vector<region> regions;
+    call_with_stopwatch( st.time_partition, [&]() { regions = extract_regions( pass ); } );
+    st.num_regions += static_cast<uint32_t>( regions.size() );
+
+    std::atomic<uint32_t> next_region{0u};
+    call_with_stopwatch( st.time_resub, [&]() {
+      run_on_threads( std::min<uint32_t>( resolve_num_threads( ps.num_threads ), std::max<uint32_t>( static_cast<uint32_t>( regions.size() ), 1u ) ), [&]( uint32_t ) {
+        for ( auto r = next_region++; r < regions.size(); r = next_region++ )
+        {
+          resub_fn( regions[r].ntk );
+        }
+      } );
+    } );
+
+    call_with_stopwatch( st.time_partition, [&]() { stitch_regions( regions ); } );
+  }
+
+  std::vector<region> extract_regions( uint32_t pass )
+  {
+    std::vector<node> gates;
+    topo_view topo{ntk};
+    topo.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+
+    /* boundaries are shifted by a fraction of the region size in each pass */
+    const auto num_gates = static_cast<uint32_t>( gates.size() );
+    const auto num_regions = std::max<uint32_t>( 1u, ( num_gates + ps.max_region_size - 1u ) / std::max( ps.max_region_size, 1u ) );
+    const auto region_size = ( num_gates + num_regions - 1u ) / num_regions;
+    const auto offset = region_size == 0u ? 0u : ( pass * region_size / std::max( ps.num_passes, 1u ) ) % region_size;
+
+    constexpr auto no_region = std::numeric_limits<uint32_t>::max();
+    node_map<uint32_t, Ntk> region_of( ntk, no_region );
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for ( auto begin = 0u; begin < num_gates; )
+    {
+      const auto end = std::min( num_gates, ranges.empty() && offset != 0u ? offset : begin + region_size );
+      for ( auto i = begin; i < end; ++i )
+      {
+        region_of[gates[i]] = static_cast<uint32_t>( ranges.size() );
+      }
+      ranges.emplace_back( begin, end );
+      begin = end;
+    }
+
+    /* gates used outside of their region become region outputs */
+    node_map<bool, Ntk> is_root( ntk, false );
+    for ( auto const& n : gates )
+    {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        const auto c = ntk.get_node( f );
+        if ( region_of[c] != no_region && region_of[c] != region_of[n] )
+        {
+          is_root[c] = true;
+        }
+      } );
+    }
+    ntk.foreach_po( [&]( auto const& f ) {
+      is_root[ntk.get_node( f )] = true;
+    } );
+
+    std::vector<region> regions( ranges.size() );
+    node_map<signal, Ntk> old_to_new( ntk );
+    for ( auto r = 0u; r < ranges.size(); ++r )
+    {
+      auto& reg = regions[r];
+      std::unordered_map<node, signal> leaf_to_pi;
+
+      for ( auto i = ranges[r].first; i < ranges[r].second; ++i )
+      {
+        const auto n = gates[i];
+
+        std::vector<signal> children;
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          const auto c = ntk.get_node( f );
+          signal child;
+          if ( region_of[c] == r )
+          {
+            child = old_to_new[c];
+          }
+          else if ( ntk.is_constant( c ) )
+          {
+            child = reg.ntk.get_constant( ntk.constant_value( c ) );
+          }
+          else if ( const auto it = leaf_to_pi.find( c ); it != leaf_to_pi.end() )
+          {
+            child = it->second;
+          }
+          else
+          {
+            child = leaf_to_pi[c] = reg.ntk.create_pi();
+            reg.leaves.push_back( c );
+          }
+          children.push_back( ntk.is_complemented( f ) ? reg.ntk.create_not( child ) : child );
+        } );
+        old_to_new[n] = reg.ntk.clone_node( ntk, n, children );
+
+        if ( is_root[n] )
+        {
+          reg.ntk.create_po( old_to_new[n] );
+          reg.roots.push_back( n );
+        }
+      }
+    }
+
+    return regions;
+  }
+
+  void stitch_regions( std::vector<region> const& regions )
+  {
+    Ntk res;
+    node_map<signal, Ntk> old_to_new( ntk );
+    old_to_new[ntk.get_constant( false )] = res.get_constant( false );
+    if ( ntk.get_node( ntk.get_constant( true ) ) != ntk.get_node( ntk.get_constant( false ) ) )
+    {
+      old_to_new[ntk.get_constant( true )] = res.get_constant( true );
+    }
+    ntk.foreach_pi( [&]( auto const& n ) {
+      old_to_new[n] = res.create_pi();
+    } );
+
+    /* regions are in topological order */
+    for ( auto const& reg : regions )
+    {
+      std::vector<signal> leaves;
+      for ( auto const& l : reg.leaves )
+      {
+        leaves.push_back( old_to_new[l] );
+      }
+      const auto outputs = cleanup_dangling( reg.ntk, res, leaves.begin(), leaves.end() );
+      for ( auto i = 0u; i < outputs.size(); ++i )
+      {
+        old_to_new[reg.roots[i]] = outputs[i];
+      }
+    }
+
+    ntk.foreach_po( [&]( auto const& f ) {
+      res.create_po( ntk.is_complemented( f ) ? res.create_not( old_to_new[f] ) : old_to_new[f] );
+    } );
+
+    ntk = res;
+  }
+
+private:
+  Ntk& ntk;
+  ResubFn& resub_fn;
+  parallel_resubstitution_params const& ps;
+  parallel_resubstitution_stats& st;
+};
+
+} /* namespace detail */
+
+/*! \brief Partition-parallel resubstitution.
+ *
+ * Splits the network into regions of consecutive gates in topological order
+ * and calls `resub_fn` on each region concurrently.  Each region is a
+ * separate network whose primary inputs are the signals entering the region
+ * and whose primary outputs are the gates used outside of the region.  These
+ * boundaries are frozen during resubstitution, and the optimized regions are
+ * stitched back into a new network that replaces `ntk`.  The boundaries are
+ * shifted in each pass, such that nodes close to a boundary in one pass are
+ * inside a region in the next one.
+ *
+ * The function `resub_fn` is called with a `Ntk&` and can run any in-place
+ * resubstitution, e.g., `aig_resubstitution`, `mig_resubstitution`,
+ * `xmg_resubstitution`, or `sim_resubstitution`.  Since regions have their
+ * own primary inputs, simulation patterns from a file cannot be used.
+ *
+ * **Required network functions:**
+ * - `clone_node`
+ * - `create_pi`
+ * - `create_po`
+ * - `foreach_fanin`
+ * - `foreach_gate`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `get_constant`
+ * - `get_node`
+ * - `is_complemented`
+ * - `is_constant`
+ *
+ * \param ntk Network (will be replaced)
+ * \param resub_fn Resubstitution function, called with each region
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk, class ResubFn>
+void parallel_resubstitution( Ntk& ntk, ResubFn&& resub_fn, parallel_resubstitution_params const& ps = {}, parallel_resubstitution_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( std::is_same_v<Ntk, typename Ntk::base_type>, "Ntk must not be a view, since it is replaced by a new network" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi method" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+
+  parallel_resubstitution_stats st;
+  detail::parallel_resubstitution_impl<Ntk, std::remove_reference_t<ResubFn>> impl( ntk, resub_fn, ps, st );
+  impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+}
+
+} /* namespace mockturtle */
@@ -32,11 +32,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <cmath>
+#include <memory>
 
 #include "../generators/sorting.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/topo_view.hpp"
@@ -45,6 +48,8 @@
 #include "cut_enumeration/mf_cut.hpp"
 
 #include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
 
 namespace mockturtle
 {
@@ -75,6 +80,14 @@ struct satlut_mapping_params
    */
   uint32_t conflict_limit{0u};
 
+  /*! \brief Number of threads in the windowed variant (0 uses all hardware threads).
+   *
+   * With a value other than 1, each round selects windows with disjoint gates,
+   * solves them concurrently, and applies the improved mappings afterwards.
+   * The result only depends on the number of threads.
+   */
+  uint32_t num_threads{1u};
+
   /*! \brief Show progress. */
   bool progress{false};
 
@@ -182,6 +195,13 @@ public:
   using network_cuts_t = network_cuts<Ntk, StoreFunction, CutData>;
   using cut_t = typename network_cuts_t::cut_t;
 
+  struct mapped_cell
+  {
+    node<Ntk> root;
+    std::vector<node<Ntk>> leaves;
+    kitty::dynamic_truth_table function;
+  };
+
 public:
   satlut_mapping_impl( Ntk& ntk, satlut_mapping_params const& ps, satlut_mapping_stats& st )
       : ntk( ntk ),
@@ -195,6 +215,15 @@ public:
   {
     stopwatch t( st.time_total );
 
+    if ( solve() )
+    {
+      apply();
+    }
+  }
+
+  /* finds the smallest mapping without modifying the network; returns false if none was found */
+  bool solve()
+  {
     std::vector<int> card_inp;
     node_map<int, Ntk> gate_var( ntk );
     node_map<std::vector<int>, Ntk> cut_vars( ntk );
@@ -247,6 +276,7 @@ public:
     st.num_clauses = solver.nr_clauses();
 
     auto best_size = ntk.has_mapping() ? ntk.num_cells() + 1 : card_inp.size();
+    bool found{false};
 
     progress_bar pbar{"satlut iteration = {0}   try size = {1}", ps.progress};
     auto iteration = 0u;
@@ -264,7 +294,8 @@ public:
       const auto result = call_with_stopwatch( st.time_sat, [&]() { return solver.solve( &assump, &assump + 1, ps.conflict_limit ); } );
       if ( result == percy::success )
       {
-        ntk.clear_mapping();
+        found = true;
+        best_mapping.clear();
         ntk.foreach_gate( [&]( auto n ) {
           if ( solver.var_value( gate_var[n] ) )
           {
@@ -273,16 +304,16 @@ public:
               if ( solver.var_value( cut_vars[n][i] ) )
               {
                 const auto index = ntk.node_to_index( n );
-                std::vector<node<Ntk>> nodes;
+                auto& cell = best_mapping.emplace_back();
+                cell.root = n;
                 for ( auto const& l : cuts.cuts( index )[i] )
                 {
-                  nodes.push_back( ntk.index_to_node( l ) );
+                  cell.leaves.push_back( ntk.index_to_node( l ) );
                 }
-                ntk.add_to_mapping( n, nodes.begin(), nodes.end() );
 
                 if constexpr ( StoreFunction )
                 {
-                  ntk.set_cell_function( n, cuts.truth_table( cuts.cuts( index )[i] ) );
+                  cell.function = cuts.truth_table( cuts.cuts( index )[i] );
                 }
                 break;
               }
@@ -290,19 +321,36 @@ public:
           }
         } );
 
-        if ( ntk.num_cells() == ntk.num_pos() )
+        if ( best_mapping.size() == ntk.num_pos() )
         {
           /* no further improvement possible */
           break;
         }
 
-        best_size = ntk.num_cells();
+        best_size = static_cast<uint32_t>( best_mapping.size() );
       }
       else
       {
         break;
       }
     }
+
+    return found;
+  }
+
+  /* replaces the mapping by the one found in `solve` */
+  void apply()
+  {
+    ntk.clear_mapping();
+    for ( auto const& cell : best_mapping )
+    {
+      ntk.add_to_mapping( cell.root, cell.leaves.begin(), cell.leaves.end() );
+
+      if constexpr ( StoreFunction )
+      {
+        ntk.set_cell_function( cell.root, cell.function );
+      }
+    }
   }
 
 private:
@@ -310,8 +358,132 @@ private:
   satlut_mapping_params const& ps;
   satlut_mapping_stats& st;
   network_cuts_t cuts;
+  std::vector<mapped_cell> best_mapping;
 };
 
+/* Windowed SAT-LUT mapping with several threads.  Each round computes windows
+ * for the next pivots and selects those whose gates are disjoint from the
+ * windows selected before in the round; a pivot whose window overlaps is
+ * retried in the next round.  The selected windows are solved concurrently,
+ * each with its own solver, and the improved mappings are applied after all
+ * windows of the round are solved.  Windows of one round do not interfere:
+ * a new mapping only uses leaves of its window, and these remain roots of
+ * any other window that contains them. */
+template<class Ntk, bool StoreFunction, typename CutData>
+void satlut_mapping_windows_parallel( Ntk& ntk, uint32_t window_size, uint32_t num_threads, satlut_mapping_params const& ps, satlut_mapping_stats& st )
+{
+  using window_t = topo_view<cell_window<Ntk>>;
+  using impl_t = satlut_mapping_impl<window_t, StoreFunction, CutData>;
+
+  stopwatch t( st.time_total );
+
+  auto window_ps = ps;
+  window_ps.progress = false; /* do not show inner progress */
+
+  std::vector<cell_window<Ntk>> windows;
+  windows.reserve( num_threads );
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    windows.emplace_back( ntk, window_size );
+  }
+  phmap::flat_hash_set<std::array<uint64_t, 2>> visited_windows;
+  std::vector<uint32_t> claimed( ntk.size(), 0u ); /* round in which a gate was assigned to a window */
+
+  std::vector<node<Ntk>> pivots;
+  ntk.foreach_gate( [&]( auto n ) {
+    pivots.push_back( n );
+  } );
+
+  progress_bar pbar{static_cast<uint32_t>( pivots.size() ), "satlut (parallel) |{0}| node = {1:>4} / " + std::to_string( pivots.size() ), ps.progress};
+  std::vector<node<Ntk>> deferred, next_deferred;
+  std::vector<window_t> selected;
+  auto next = 0u;
+  auto round = 0u;
+  while ( next < pivots.size() || !deferred.empty() )
+  {
+    pbar( next, next );
+    ++round;
+    selected.clear();
+    next_deferred.clear();
+
+    const auto try_pivot = [&]( node<Ntk> const& n ) {
+      if ( !ntk.is_cell_root( n ) )
+      {
+        return;
+      }
+
+      auto& window = windows[selected.size()];
+      window.compute_window_for( n );
+      if ( visited_windows.count( window.window_hash() ) )
+      {
+        return;
+      }
+
+      bool disjoint{true};
+      window.foreach_gate( [&]( auto const& g ) {
+        disjoint = claimed[ntk.node_to_index( g )] != round;
+        return disjoint;
+      } );
+      if ( !disjoint )
+      {
+        next_deferred.push_back( n );
+        return;
+      }
+
+      visited_windows.insert( window.window_hash() );
+      if ( window.num_cells() == window.num_pos() || window.num_pos() == 0 )
+      {
+        return;
+      }
+
+      window.foreach_gate( [&]( auto const& g ) {
+        claimed[ntk.node_to_index( g )] = round;
+      } );
+      selected.emplace_back( window );
+    };
+
+    /* overlapping windows are not computed over and over in one round */
+    const auto round_full = [&]() {
+      return selected.size() == num_threads || next_deferred.size() >= num_threads;
+    };
+    auto it = deferred.begin();
+    for ( ; it != deferred.end() && !round_full(); ++it )
+    {
+      try_pivot( *it );
+    }
+    next_deferred.insert( next_deferred.end(), it, deferred.end() );
+    while ( next < pivots.size() && !round_full() )
+    {
+      try_pivot( pivots[next++] );
+    }
+    std::swap( deferred, next_deferred );
+
+    /* solve windows concurrently */
+    std::vector<std::unique_ptr<impl_t>> impls( selected.size() );
+    std::vector<satlut_mapping_stats> stats( selected.size() );
+    std::vector<uint8_t> found( selected.size(), 0u );
+    std::atomic<uint32_t> next_window{0u};
+    run_on_threads( std::min( num_threads, static_cast<uint32_t>( selected.size() ) ), [&]( uint32_t ) {
+      for ( auto i = next_window++; i < selected.size(); i = next_window++ )
+      {
+        impls[i] = std::make_unique<impl_t>( selected[i], window_ps, stats[i] );
+        found[i] = impls[i]->solve();
+      }
+    } );
+
+    for ( auto i = 0u; i < selected.size(); ++i )
+    {
+      if ( found[i] )
+      {
+        impls[i]->apply();
+      }
+      st.time_sat += stats[i].time_sat;
+      st.num_vars = stats[i].num_vars;
+      st.num_clauses = stats[i].num_clauses;
+    }
+  }
+}
+
 } // namespace detail
 
 /*! \brief SAT-LUT mapping.
@@ -383,6 +555,9 @@ void satlut_mapping( Ntk& ntk, satlut_mapping_params const& ps = {}, satlut_mapp
  * The initial network must already contain a mapping, e.g., found with
  * `lut_mapping`.
  *
+ * If `ps.num_threads` is not 1, windows with disjoint gates are solved
+ * concurrently.
+ *
  * **Required network functions:**
  * - `is_pi`
  * - `index_to_node`
@@ -426,6 +601,22 @@ void satlut_mapping( Ntk& ntk, uint32_t window_size, satlut_mapping_params ps =
   }
 
   satlut_mapping_stats st;
+  if ( const auto num_threads = resolve_num_threads( ps.num_threads ); num_threads > 1u )
+  {
+    detail::satlut_mapping_windows_parallel<Ntk, StoreFunction, CutData>( ntk, window_size, num_threads, ps, st );
+
+    if ( ps.verbose )
+    {
+      st.report();
+    }
+
+    if ( pst )
+    {
+      *pst = st;
+    }
+    return;
+  }
+
   stopwatch<>::duration time_total{};
   cell_window window( ntk, window_size );
   progress_bar pbar{ntk.size(), "satlut (windowed) |{0}| node = {1:>4} / " + std::to_string( ntk.size() ), ps.progress};
@@ -0,0 +1,557 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simulation_engine.hpp
+  \brief Bit-parallel simulation of AND/XOR/MAJ networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined( __AVX2__ ) || defined( __AVX512F__ )
+#include <immintrin.h>
+#endif
+
+#include <kitty/partial_truth_table.hpp>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/parallel.hpp"
+#include "simulation.hpp"
+
+namespace mockturtle
+{
+
+struct simulation_engine_params
+{
+  /*! \brief Number of threads (0 uses all hardware threads). */
+  uint32_t num_threads{1u};
+
+  /*! \brief Minimum number of gates in a level to split it among threads. */
+  uint32_t min_parallel_gates{128u};
+};
+
+namespace detail
+{
+
+/*! \brief Allocator for cache-line aligned simulation words */
+template<typename T>
+struct cache_aligned_allocator
+{
+  using value_type = T;
+  static constexpr std::size_t alignment = 64u;
+
+  cache_aligned_allocator() = default;
+  template<typename U>
+  cache_aligned_allocator( cache_aligned_allocator<U> const& ) {}
+
+  T* allocate( std::size_t n )
+  {
+    return static_cast<T*>( ::operator new( n * sizeof( T ), std::align_val_t( alignment ) ) );
+  }
+
+  void deallocate( T* p, std::size_t )
+  {
+    ::operator delete( p, std::align_val_t( alignment ) );
+  }
+
+  template<typename U>
+  bool operator==( cache_aligned_allocator<U> const& ) const { return true; }
+  template<typename U>
+  bool operator!=( cache_aligned_allocator<U> const& ) const { return false; }
+};
+
+enum class simulation_op : uint8_t
+{
+  and2,
+  xor2,
+  maj3,
+  xor3
+};
+
+/* Kernels operate on rows whose length is a multiple of 8 words and which
+ * start at 64-byte boundaries.  Complemented fanins are passed as all-zero
+ * or all-one masks. */
+inline void simulate_and2( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t ma, uint64_t mb, uint32_t num_words )
+{
+#if defined( __AVX512F__ )
+  const auto va = _mm512_set1_epi64( ma ), vb = _mm512_set1_epi64( mb );
+  for ( auto i = 0u; i < num_words; i += 8u )
+  {
+    const auto x = _mm512_xor_si512( _mm512_load_si512( a + i ), va );
+    const auto y = _mm512_xor_si512( _mm512_load_si512( b + i ), vb );
+    _mm512_store_si512( out + i, _mm512_and_si512( x, y ) );
+  }
+#elif defined( __AVX2__ )
+  const auto va = _mm256_set1_epi64x( ma ), vb = _mm256_set1_epi64x( mb );
+  for ( auto i = 0u; i < num_words; i += 4u )
+  {
+    const auto x = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    const auto y = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    _mm256_store_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_and_si256( x, y ) );
+  }
+#else
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    out[i] = ( a[i] ^ ma ) & ( b[i] ^ mb );
+  }
+#endif
+}
+
+inline void simulate_xor2( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t m, uint32_t num_words )
+{
+#if defined( __AVX512F__ )
+  const auto vm = _mm512_set1_epi64( m );
+  for ( auto i = 0u; i < num_words; i += 8u )
+  {
+    const auto x = _mm512_xor_si512( _mm512_load_si512( a + i ), _mm512_load_si512( b + i ) );
+    _mm512_store_si512( out + i, _mm512_xor_si512( x, vm ) );
+  }
+#elif defined( __AVX2__ )
+  const auto vm = _mm256_set1_epi64x( m );
+  for ( auto i = 0u; i < num_words; i += 4u )
+  {
+    const auto x = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( a + i ) ), _mm256_load_si256( reinterpret_cast<__m256i const*>( b + i ) ) );
+    _mm256_store_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_xor_si256( x, vm ) );
+  }
+#else
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    out[i] = a[i] ^ b[i] ^ m;
+  }
+#endif
+}
+
+inline void simulate_maj3( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t const* c, uint64_t ma, uint64_t mb, uint64_t mc, uint32_t num_words )
+{
+#if defined( __AVX512F__ )
+  const auto va = _mm512_set1_epi64( ma ), vb = _mm512_set1_epi64( mb ), vc = _mm512_set1_epi64( mc );
+  for ( auto i = 0u; i < num_words; i += 8u )
+  {
+    const auto x = _mm512_xor_si512( _mm512_load_si512( a + i ), va );
+    const auto y = _mm512_xor_si512( _mm512_load_si512( b + i ), vb );
+    const auto z = _mm512_xor_si512( _mm512_load_si512( c + i ), vc );
+    /* 0xe8 is the truth table of MAJ(x, y, z) */
+    _mm512_store_si512( out + i, _mm512_ternarylogic_epi64( x, y, z, 0xe8 ) );
+  }
+#elif defined( __AVX2__ )
+  const auto va = _mm256_set1_epi64x( ma ), vb = _mm256_set1_epi64x( mb ), vc = _mm256_set1_epi64x( mc );
+  for ( auto i = 0u; i < num_words; i += 4u )
+  {
+    const auto x = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    const auto y = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    const auto z = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( c + i ) ), vc );
+    const auto r = _mm256_or_si256( _mm256_and_si256( x, y ), _mm256_and_si256( z, _mm256_or_si256( x, y ) ) );
+    _mm256_store_si256( reinterpret_cast<__m256i*>( out + i ), r );
+  }
+#else
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    const auto x = a[i] ^ ma, y = b[i] ^ mb, z = c[i] ^ mc;
+    out[i] = ( x & y ) | ( z & ( x | y ) );
+  }
+#endif
+}
+
+inline void simulate_xor3( uint64_t* out, uint64_t const* a, uint64_t const* b, uint64_t const* c, uint64_t m, uint32_t num_words )
+{
+#if defined( __AVX512F__ )
+  const auto vm = _mm512_set1_epi64( m );
+  for ( auto i = 0u; i < num_words; i += 8u )
+  {
+    /* 0x96 is the truth table of XOR(x, y, z) */
+    const auto x = _mm512_ternarylogic_epi64( _mm512_load_si512( a + i ), _mm512_load_si512( b + i ), _mm512_load_si512( c + i ), 0x96 );
+    _mm512_store_si512( out + i, _mm512_xor_si512( x, vm ) );
+  }
+#elif defined( __AVX2__ )
+  const auto vm = _mm256_set1_epi64x( m );
+  for ( auto i = 0u; i < num_words; i += 4u )
+  {
+    const auto x = _mm256_xor_si256( _mm256_load_si256( reinterpret_cast<__m256i const*>( a + i ) ), _mm256_load_si256( reinterpret_cast<__m256i const*>( b + i ) ) );
+    const auto y = _mm256_xor_si256( x, _mm256_load_si256( reinterpret_cast<__m256i const*>( c + i ) ) );
+    _mm256_store_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_xor_si256( y, vm ) );
+  }
+#else
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    out[i] = a[i] ^ b[i] ^ c[i] ^ m;
+  }
+#endif
+}
+
+} // namespace detail
+
+/*! \brief Bit-parallel simulation engine.
+ *
+ * Simulates all nodes of a network with AND, XOR, MAJ, and XOR3 gates (such
+ * as AIGs, XAGs, MIGs, and XMGs) for a set of partial simulation patterns.
+ * In contrast to `simulate_nodes` with a `partial_simulator`, all node
+ * signatures are stored in one contiguous matrix with one cache-line aligned
+ * row per node, and gates are evaluated with AVX-512 or AVX2 kernels if the
+ * library is compiled for a target that supports them.
+ *
+ * The gates are scheduled by logic level when the engine is constructed.
+ * With `num_threads > 1`, the gates of each level are split among threads.
+ * The network must not be modified while the engine is used.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `get_constant`
+ * - `node_to_index`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `is_complemented`
+ * - `is_and`
+ * - `is_xor`
+ * - `is_maj`
+ * - `is_xor3`
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      xag_network xag = ...;
+      partial_simulator sim( xag.num_pis(), 1024 );
+
+      simulation_engine engine( xag );
+      engine.run( sim );
+
+      xag.foreach_po( [&]( auto const& f ) {
+        auto const tt = engine.get_signature( f );
+      } );
+   \endverbatim
+ */
+template<class Ntk>
+class simulation_engine
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit simulation_engine( Ntk const& ntk, simulation_engine_params const& ps = {} )
+      : ntk( ntk ), ps( ps )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_is_and_v<Ntk>, "Ntk does not implement the is_and method" );
+    static_assert( has_is_xor_v<Ntk>, "Ntk does not implement the is_xor method" );
+    static_assert( has_is_maj_v<Ntk>, "Ntk does not implement the is_maj method" );
+    static_assert( has_is_xor3_v<Ntk>, "Ntk does not implement the is_xor3 method" );
+
+    schedule();
+  }
+
+  /*! \brief Simulates all nodes for the patterns of `sim`.
+   *
+   * `Simulator` must implement `num_bits()` and return partial truth tables
+   * in `compute_pi` (e.g., `partial_simulator` and `bit_packed_simulator`).
+   */
+  template<class Simulator = partial_simulator>
+  void run( Simulator const& sim )
+  {
+    _num_bits = sim.num_bits();
+    _num_blocks = ( _num_bits + 63u ) >> 6u;
+    /* rows are padded to full cache lines, which also keeps the kernels free of tail loops */
+    _stride = std::max<uint32_t>( 8u, ( _num_blocks + 7u ) & ~7u );
+    words.assign( static_cast<std::size_t>( ntk.size() ) * _stride, 0u );
+
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      auto const tt = sim.compute_pi( i );
+      std::copy( tt.cbegin(), tt.cend(), row( ntk.node_to_index( n ) ) );
+    } );
+
+    const auto num_threads = resolve_num_threads( ps.num_threads );
+    if ( num_threads == 1u || gates.size() < ps.min_parallel_gates )
+    {
+      simulate_range( 0u, gates.size() );
+      return;
+    }
+
+    spin_barrier barrier( num_threads );
+    run_on_threads( num_threads, [&]( uint32_t t ) {
+      for ( auto l = 0u; l + 1u < level_offsets.size(); ++l )
+      {
+        const auto begin = level_offsets[l], end = level_offsets[l + 1u];
+        if ( end - begin < ps.min_parallel_gates )
+        {
+          if ( t == 0u )
+          {
+            simulate_range( begin, end );
+          }
+        }
+        else
+        {
+          const auto [first, last] = thread_range( end - begin, t, num_threads );
+          simulate_range( begin + static_cast<uint32_t>( first ), begin + static_cast<uint32_t>( last ) );
+        }
+        barrier.wait();
+      }
+    } );
+  }
+
+  /*! \brief Returns the number of simulated patterns. */
+  uint32_t num_bits() const
+  {
+    return _num_bits;
+  }
+
+  /*! \brief Returns the number of logic levels of gates in the schedule. */
+  uint32_t num_levels() const
+  {
+    return static_cast<uint32_t>( level_offsets.size() ) - 2u;
+  }
+
+  /*! \brief Returns a pointer to the `num_bits()` simulated bits of node `n`.
+   *
+   * Bits beyond `num_bits()` in the last word are unspecified.
+   */
+  uint64_t const* words_of( node const& n ) const
+  {
+    return row( ntk.node_to_index( n ) );
+  }
+
+  /*! \brief Returns the signature of node `n`. */
+  kitty::partial_truth_table get_signature( node const& n ) const
+  {
+    kitty::partial_truth_table tt( _num_bits );
+    auto const* r = words_of( n );
+    std::copy( r, r + _num_blocks, tt.begin() );
+    tt.mask_bits();
+    return tt;
+  }
+
+  /*! \brief Returns the signature of signal `f`. */
+  kitty::partial_truth_table get_signature( signal const& f ) const
+  {
+    auto tt = get_signature( ntk.get_node( f ) );
+    return ntk.is_complemented( f ) ? ~tt : tt;
+  }
+
+  /*! \brief Copies the signatures of all nodes into `node_to_value`. */
+  void get_signatures( unordered_node_map<kitty::partial_truth_table, Ntk>& node_to_value ) const
+  {
+    node_to_value[ntk.get_node( ntk.get_constant( false ) )] = get_signature( ntk.get_node( ntk.get_constant( false ) ) );
+    ntk.foreach_pi( [&]( auto const& n ) {
+      node_to_value[n] = get_signature( n );
+    } );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      node_to_value[n] = get_signature( n );
+    } );
+  }
+
+private:
+  struct gate
+  {
+    uint32_t out;
+    std::array<uint32_t, 3u> fanins;
+    detail::simulation_op op;
+    /* bit i is set if fanin i is complemented */
+    uint8_t complements;
+  };
+
+  uint64_t* row( uint64_t index )
+  {
+    return words.data() + index * _stride;
+  }
+
+  uint64_t const* row( uint64_t index ) const
+  {
+    return words.data() + index * _stride;
+  }
+
+  /* computes the gate records sorted by level (counting sort) */
+  void schedule()
+  {
+    assert( ntk.size() < std::numeric_limits<uint32_t>::max() );
+
+    std::vector<uint32_t> level( ntk.size(), 0u );
+    std::vector<uint8_t> scheduled( ntk.size(), 0u );
+    std::vector<gate> unsorted;
+    uint32_t max_level{0u};
+
+    scheduled[ntk.node_to_index( ntk.get_node( ntk.get_constant( false ) ) )] = 1u;
+    ntk.foreach_pi( [&]( auto const& n ) {
+      scheduled[ntk.node_to_index( n )] = 1u;
+    } );
+
+    /* iterative post-order, since node indexes need not be topological after substitutions */
+    std::vector<std::pair<node, bool>> stack;
+    ntk.foreach_gate( [&]( auto const& root ) {
+      if ( scheduled[ntk.node_to_index( root )] )
+      {
+        return;
+      }
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        auto const index = ntk.node_to_index( n );
+        if ( scheduled[index] )
+        {
+          stack.pop_back();
+          continue;
+        }
+        if ( !expanded )
+        {
+          stack.back().second = true;
+          ntk.foreach_fanin( n, [&]( auto const& f ) {
+            if ( !scheduled[ntk.node_to_index( ntk.get_node( f ) )] )
+            {
+              stack.emplace_back( ntk.get_node( f ), false );
+            }
+          } );
+          continue;
+        }
+        stack.pop_back();
+        scheduled[index] = 1u;
+
+        gate g{};
+        g.out = static_cast<uint32_t>( index );
+        ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          auto const fi = ntk.node_to_index( ntk.get_node( f ) );
+          g.fanins[i] = static_cast<uint32_t>( fi );
+          g.complements |= static_cast<uint8_t>( ntk.is_complemented( f ) ) << i;
+          level[index] = std::max( level[index], level[fi] + 1u );
+        } );
+
+        if ( ntk.is_and( n ) )
+        {
+          g.op = detail::simulation_op::and2;
+        }
+        else if ( ntk.is_xor( n ) )
+        {
+          g.op = detail::simulation_op::xor2;
+        }
+        else if ( ntk.is_maj( n ) )
+        {
+          g.op = detail::simulation_op::maj3;
+        }
+        else
+        {
+          assert( ntk.is_xor3( n ) );
+          g.op = detail::simulation_op::xor3;
+        }
+        max_level = std::max( max_level, level[index] );
+        unsorted.push_back( g );
+      }
+    } );
+
+    level_offsets.assign( max_level + 2u, 0u );
+    for ( auto const& g : unsorted )
+    {
+      ++level_offsets[level[g.out]];
+    }
+    uint32_t sum{0u};
+    for ( auto& o : level_offsets )
+    {
+      sum += std::exchange( o, sum );
+    }
+    /* level 0 only contains the constant and CIs */
+    gates.resize( unsorted.size() );
+    auto next = level_offsets;
+    for ( auto const& g : unsorted )
+    {
+      gates[next[level[g.out]]++] = g;
+    }
+  }
+
+  void simulate_range( uint32_t begin, uint32_t end )
+  {
+    const auto mask = []( uint8_t complements, uint32_t i ) -> uint64_t { return ( complements >> i ) & 1 ? ~uint64_t( 0 ) : uint64_t( 0 ); };
+
+    for ( auto i = begin; i < end; ++i )
+    {
+      auto const& g = gates[i];
+      switch ( g.op )
+      {
+      case detail::simulation_op::and2:
+        detail::simulate_and2( row( g.out ), row( g.fanins[0] ), row( g.fanins[1] ), mask( g.complements, 0u ), mask( g.complements, 1u ), _stride );
+        break;
+      case detail::simulation_op::xor2:
+        detail::simulate_xor2( row( g.out ), row( g.fanins[0] ), row( g.fanins[1] ), mask( g.complements, 0u ) ^ mask( g.complements, 1u ), _stride );
+        break;
+      case detail::simulation_op::maj3:
+        detail::simulate_maj3( row( g.out ), row( g.fanins[0] ), row( g.fanins[1] ), row( g.fanins[2] ), mask( g.complements, 0u ), mask( g.complements, 1u ), mask( g.complements, 2u ), _stride );
+        break;
+      case detail::simulation_op::xor3:
+        detail::simulate_xor3( row( g.out ), row( g.fanins[0] ), row( g.fanins[1] ), row( g.fanins[2] ), mask( g.complements, 0u ) ^ mask( g.complements, 1u ) ^ mask( g.complements, 2u ), _stride );
+        break;
+      }
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  simulation_engine_params const ps;
+
+  std::vector<gate> gates;
+  std::vector<uint32_t> level_offsets;
+
+  uint32_t _num_bits{0u};
+  uint32_t _num_blocks{0u};
+  uint32_t _stride{8u};
+  std::vector<uint64_t, detail::cache_aligned_allocator<uint64_t>> words;
+};
+
+/*! \brief Simulates a network with the bit-parallel simulation engine.
+ *
+ * Computes the same signatures as `simulate_nodes` with `simulate_whole_tt =
+ * true`, but evaluates all gates in a `simulation_engine` and copies the
+ * results into `node_to_value` afterwards.
+ *
+ * \param ntk Network with AND, XOR, MAJ, and XOR3 gates
+ * \param node_to_value A map from nodes to signatures
+ * \param sim Simulator providing the simulation patterns
+ * \param ps Parameters of the simulation engine
+ */
+template<class Ntk, class Simulator = partial_simulator>
+void simulate_nodes( Ntk const& ntk, unordered_node_map<kitty::partial_truth_table, Ntk>& node_to_value, Simulator const& sim, simulation_engine_params const& ps )
+{
+  simulation_engine<Ntk> engine( ntk, ps );
+  engine.run( sim );
+  engine.get_signatures( node_to_value );
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,592 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file sweeping_equivalence_checking.hpp
+  \brief Combinational equivalence checking with simulation and SAT sweeping
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "circuit_validator.hpp"
+#include "parallel_equivalence_checking.hpp"
+#include "simulation.hpp"
+#include "simulation_engine.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for sweeping_equivalence_checking.
+ *
+ * The data structure `sweeping_equivalence_checking_params` holds
+ * configurable parameters with default arguments for
+ * `sweeping_equivalence_checking`.
+ */
+struct sweeping_equivalence_checking_params
+{
+  /*! \brief Number of random patterns to compute the initial candidate classes. */
+  uint32_t num_patterns{1024u};
+
+  /*! \brief Seed for the random patterns. */
+  uint32_t random_seed{1u};
+
+  /*! \brief Conflict limit to prove internal equivalences (0 means no limit). */
+  uint32_t conflict_limit{1000u};
+
+  /*! \brief Conflict limit to prove that outputs are constant (0 means no limit). */
+  uint32_t output_conflict_limit{0u};
+
+  /*! \brief Maximum number of clauses before the SAT solver is restarted. */
+  uint32_t max_clauses{100000u};
+
+  /*! \brief Number of threads for the initial simulation and to prove the outputs (0 uses all hardware threads).
+   *
+   * With a value other than 1, the outputs are proven with
+   * `parallel_equivalence_checking` on the swept network.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Be verbose. */
+  bool verbose{false};
+};
+
+/*! \brief Statistics for sweeping_equivalence_checking.
+ *
+ * The data structure `sweeping_equivalence_checking_stats` provides data
+ * collected by running `sweeping_equivalence_checking`.
+ */
+struct sweeping_equivalence_checking_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Time for simulation. */
+  stopwatch<>::duration time_sim{0};
+
+  /*! \brief Time for SAT solving. */
+  stopwatch<>::duration time_sat{0};
+
+  /*! \brief Number of initial candidate classes with at least two nodes. */
+  uint32_t num_classes{0};
+
+  /*! \brief Number of proven and merged internal equivalences. */
+  uint32_t num_merged{0};
+
+  /*! \brief Number of disproved candidates (counter-examples). */
+  uint32_t num_cex{0};
+
+  /*! \brief Number of SAT solver timeouts. */
+  uint32_t num_timeouts{0};
+
+  /*! \brief Counter-example, in case the miter is not equivalent. */
+  std::vector<bool> counter_example;
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] classes    = {:8d}\n", num_classes );
+    std::cout << fmt::format( "[i] merged     = {:8d}\n", num_merged );
+    std::cout << fmt::format( "[i] cex        = {:8d}\n", num_cex );
+    std::cout << fmt::format( "[i] timeouts   = {:8d}\n", num_timeouts );
+    std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i]   sim time = {:>5.2f} secs\n", to_seconds( time_sim ) );
+    std::cout << fmt::format( "[i]   SAT time = {:>5.2f} secs\n", to_seconds( time_sat ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class sweeping_equivalence_checking_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using validator_t = circuit_validator<Ntk, bill::solvers::bsat2>;
+
+  static constexpr uint32_t no_class = std::numeric_limits<uint32_t>::max();
+
+  sweeping_equivalence_checking_impl( Ntk const& miter, sweeping_equivalence_checking_params const& ps, sweeping_equivalence_checking_stats& st )
+      : miter( miter ),
+        ps( ps ),
+        st( st ),
+        old_to_new( miter ),
+        rng( ps.random_seed )
+  {
+  }
+
+  std::optional<bool> run()
+  {
+    stopwatch t( st.time_total );
+
+    if ( !compute_classes() )
+    {
+      return false;
+    }
+
+    /* the swept network is a copy of the miter in which proven equivalent nodes are merged */
+    old_to_new[miter.get_constant( false )] = swept.get_constant( false );
+    miter.foreach_pi( [&]( auto const& n ) {
+      old_to_new[n] = swept.create_pi();
+    } );
+
+    validator_params vps;
+    vps.max_clauses = ps.max_clauses;
+    vps.conflict_limit = ps.conflict_limit;
+    validator_t validator( swept, vps );
+
+    std::vector<signal> children;
+    miter.foreach_gate( [&]( auto const& n ) {
+      children.clear();
+      miter.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( old_to_new[f] ^ miter.is_complemented( f ) );
+      } );
+      old_to_new[n] = swept.clone_node( miter, n, children );
+      sweep( validator, n );
+    } );
+
+    return check_outputs();
+  }
+
+private:
+  /* Partitions all nodes into candidate classes based on random simulation.
+   * Nodes are compared up to complementation; the phase of a node is its
+   * value for the first pattern.  Returns false, if some output evaluates to
+   * 1 for some pattern. */
+  bool compute_classes()
+  {
+    stopwatch t( st.time_sim );
+
+    const auto num_patterns = std::max( 64u, ( ps.num_patterns + 63u ) & ~63u );
+    partial_simulator sim( miter.num_pis(), num_patterns, ps.random_seed );
+
+    simulation_engine_params sps;
+    sps.num_threads = ps.num_threads;
+    simulation_engine<Ntk> engine( miter, sps );
+    engine.run( sim );
+
+    const auto num_words = num_patterns >> 6;
+    auto cex_found = false;
+    miter.foreach_po( [&]( auto const& f ) {
+      auto const* words = engine.words_of( miter.get_node( f ) );
+      const auto mask = miter.is_complemented( f ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        if ( ( words[w] ^ mask ) != 0u )
+        {
+          const auto bit = 64u * w + static_cast<uint32_t>( kitty::find_first_bit_in_word( words[w] ^ mask ) );
+          const auto patterns = sim.get_patterns();
+          st.counter_example.clear();
+          for ( auto const& pattern : patterns )
+          {
+            st.counter_example.push_back( kitty::get_bit( pattern, bit ) );
+          }
+          cex_found = true;
+          return false;
+        }
+      }
+      return true;
+    } );
+    if ( cex_found )
+    {
+      return false;
+    }
+
+    phase.resize( miter.size() );
+    class_of.assign( miter.size(), no_class );
+    column.resize( miter.size() );
+    pi_words.resize( miter.num_pis() );
+
+    std::vector<uint32_t> nodes;
+    miter.foreach_node( [&]( auto const& n ) {
+      const auto index = miter.node_to_index( n );
+      phase[index] = engine.words_of( n )[0] & 1;
+      nodes.push_back( index );
+    } );
+
+    const auto normalized = [&]( uint32_t index, uint32_t w ) {
+      return engine.words_of( miter.index_to_node( index ) )[w] ^ ( phase[index] ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    };
+    const auto compare = [&]( uint32_t a, uint32_t b ) {
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        if ( normalized( a, w ) != normalized( b, w ) )
+        {
+          return normalized( a, w ) < normalized( b, w ) ? -1 : 1;
+        }
+      }
+      return 0;
+    };
+    std::sort( nodes.begin(), nodes.end(), [&]( uint32_t a, uint32_t b ) {
+      const auto c = compare( a, b );
+      return c != 0 ? c < 0 : a < b;
+    } );
+
+    for ( auto i = 0u; i < nodes.size(); )
+    {
+      auto j = i + 1u;
+      while ( j < nodes.size() && compare( nodes[i], nodes[j] ) == 0 )
+      {
+        ++j;
+      }
+      if ( j - i > 1u )
+      {
+        add_class( std::vector<uint32_t>( nodes.begin() + i, nodes.begin() + j ) );
+      }
+      i = j;
+    }
+    st.num_classes = static_cast<uint32_t>( classes.size() );
+
+    return true;
+  }
+
+  void add_class( std::vector<uint32_t> members )
+  {
+    for ( auto index : members )
+    {
+      class_of[index] = static_cast<uint32_t>( classes.size() );
+    }
+    classes.emplace_back( std::move( members ) );
+  }
+
+  /* Proves node `n` against the first node in its class, which has been
+   * processed before.  A counter-example refines the classes, after which
+   * `n` is tried against the first node of its new class. */
+  void sweep( validator_t& validator, node const& n )
+  {
+    const auto index = miter.node_to_index( n );
+    while ( class_of[index] != no_class )
+    {
+      const auto repr = classes[class_of[index]].front();
+      if ( repr == index )
+      {
+        return;
+      }
+
+      const auto target = old_to_new[miter.index_to_node( repr )] ^ ( phase[index] != phase[repr] );
+      const auto f = old_to_new[n];
+      if ( swept.get_node( f ) == swept.get_node( target ) )
+      {
+        /* merged by structural hashing */
+        old_to_new[n] = target;
+        return;
+      }
+
+      const auto res = call_with_stopwatch( st.time_sat, [&]() {
+        return validator.validate( f, target );
+      } );
+      if ( !res )
+      {
+        ++st.num_timeouts;
+        return;
+      }
+      else if ( *res )
+      {
+        ++st.num_merged;
+        old_to_new[n] = target;
+        return;
+      }
+
+      add_counter_example( validator.cex );
+      if ( class_of[index] != no_class && classes[class_of[index]].front() == repr )
+      {
+        assert( false && "counter-example does not refine the class" );
+        return;
+      }
+    }
+  }
+
+  /* Simulates 64 patterns of which the next one is the counter-example and
+   * the remaining ones are the counter-example with one flipped input, and
+   * refines the classes with them. */
+  void add_counter_example( std::vector<bool> const& cex )
+  {
+    stopwatch t( st.time_sim );
+    ++st.num_cex;
+
+    std::uniform_int_distribution<uint32_t> dist( 0u, miter.num_pis() - 1u );
+    for ( auto slot = cex_slot; slot < 64u; ++slot )
+    {
+      const auto flipped = slot == cex_slot ? miter.num_pis() : dist( rng );
+      for ( auto i = 0u; i < miter.num_pis(); ++i )
+      {
+        if ( cex[i] != ( i == flipped ) )
+        {
+          pi_words[i] |= UINT64_C( 1 ) << slot;
+        }
+        else
+        {
+          pi_words[i] &= ~( UINT64_C( 1 ) << slot );
+        }
+      }
+    }
+    cex_slot = ( cex_slot + 1u ) & 63u;
+
+    simulate_column();
+    refine_classes();
+  }
+
+  void simulate_column()
+  {
+    column[miter.node_to_index( miter.get_node( miter.get_constant( false ) ) )]._bits = 0u;
+    miter.foreach_pi( [&]( auto const& n, auto i ) {
+      column[miter.node_to_index( n )]._bits = pi_words[i];
+    } );
+
+    std::vector<kitty::static_truth_table<6>> fanin_tts;
+    miter.foreach_gate( [&]( auto const& n ) {
+      fanin_tts.clear();
+      miter.foreach_fanin( n, [&]( auto const& f ) {
+        fanin_tts.push_back( column[miter.node_to_index( miter.get_node( f ) )] );
+      } );
+      column[miter.node_to_index( n )] = miter.compute( n, fanin_tts.begin(), fanin_tts.end() );
+    } );
+  }
+
+  /* splits every class by the normalized values of the last simulated patterns */
+  void refine_classes()
+  {
+    const auto key = [&]( uint32_t index ) {
+      return column[index]._bits ^ ( phase[index] ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    };
+
+    std::vector<uint32_t> kept, moved;
+    const auto num_classes = classes.size();
+    for ( auto c = 0u; c < num_classes; ++c )
+    {
+      auto& members = classes[c];
+      if ( members.size() < 2u )
+      {
+        continue;
+      }
+
+      const auto first = key( members.front() );
+      kept.clear();
+      moved.clear();
+      for ( auto index : members )
+      {
+        ( key( index ) == first ? kept : moved ).push_back( index );
+      }
+      if ( moved.empty() )
+      {
+        continue;
+      }
+
+      members.swap( kept );
+      if ( members.size() == 1u )
+      {
+        class_of[members.front()] = no_class;
+        members.clear();
+      }
+
+      /* the moved nodes keep their topological order inside new classes */
+      std::stable_sort( moved.begin(), moved.end(), [&]( uint32_t a, uint32_t b ) {
+        return key( a ) < key( b );
+      } );
+      for ( auto i = 0u; i < moved.size(); )
+      {
+        auto j = i + 1u;
+        while ( j < moved.size() && key( moved[j] ) == key( moved[i] ) )
+        {
+          ++j;
+        }
+        if ( j - i > 1u )
+        {
+          add_class( std::vector<uint32_t>( moved.begin() + i, moved.begin() + j ) );
+        }
+        else
+        {
+          class_of[moved[i]] = no_class;
+        }
+        i = j;
+      }
+    }
+  }
+
+  /* proves that all outputs of the swept network are constant 0 */
+  std::optional<bool> check_outputs()
+  {
+    if ( ps.num_threads != 1u )
+    {
+      miter.foreach_po( [&]( auto const& f ) {
+        swept.create_po( old_to_new[f] ^ miter.is_complemented( f ) );
+      } );
+
+      parallel_equivalence_checking_params pps;
+      pps.num_threads = ps.num_threads;
+      pps.conflict_limit = ps.output_conflict_limit;
+      parallel_equivalence_checking_stats pst;
+      const auto result = parallel_equivalence_checking( swept, pps, &pst );
+
+      st.time_sat += pst.time_total;
+      st.num_timeouts += static_cast<uint32_t>( std::count( pst.output_status.begin(), pst.output_status.end(), miter_output_status::timeout ) );
+      st.counter_example = pst.counter_example;
+      return result;
+    }
+
+    validator_params vps;
+    vps.max_clauses = ps.max_clauses;
+    vps.conflict_limit = ps.output_conflict_limit;
+    validator_t validator( swept, vps );
+
+    std::optional<bool> result = true;
+    miter.foreach_po( [&]( auto const& f ) {
+      const auto g = old_to_new[f] ^ miter.is_complemented( f );
+      if ( g == swept.get_constant( false ) )
+      {
+        return true;
+      }
+
+      const auto res = call_with_stopwatch( st.time_sat, [&]() {
+        return validator.validate( g, false );
+      } );
+      if ( !res )
+      {
+        ++st.num_timeouts;
+        result = std::nullopt;
+      }
+      else if ( !*res )
+      {
+        st.counter_example = validator.cex;
+        result = false;
+        return false;
+      }
+      return true;
+    } );
+
+    return result;
+  }
+
+private:
+  Ntk const& miter;
+  sweeping_equivalence_checking_params const& ps;
+  sweeping_equivalence_checking_stats& st;
+
+  Ntk swept;
+  node_map<signal, Ntk> old_to_new;
+
+  /* candidate classes, each sorted in topological order */
+  std::vector<std::vector<uint32_t>> classes;
+  std::vector<uint32_t> class_of;
+  std::vector<uint8_t> phase;
+
+  /* last 64 simulated patterns for counter-examples */
+  std::vector<kitty::static_truth_table<6>> column;
+  std::vector<uint64_t> pi_words;
+  uint32_t cex_slot{0};
+  std::default_random_engine rng;
+};
+
+} // namespace detail
+
+/*! \brief Combinational equivalence checking with simulation and SAT sweeping.
+ *
+ * This function expects as input a miter circuit that can be generated, e.g.,
+ * with the function `miter`.  The miter is equivalent if all its outputs are
+ * constant 0.  Like `equivalence_checking`, it returns `nullopt` if a resource
+ * limit prevents a result, `true` if the miter is equivalent, and `false` if
+ * it is not, in which case a counter-example is written to the statistics.
+ *
+ * Random simulation partitions the nodes of the miter into candidate classes
+ * of nodes that may be equivalent up to complementation.  Then the nodes are
+ * copied into a swept network in topological order.  Each node is proven
+ * against the first node of its class with an incremental SAT solver, and
+ * merged into it if they are equivalent.  A counter-example is simulated
+ * together with 63 patterns that differ from it in one input, and refines all
+ * classes.  Finally, the outputs of the swept network are proven to be
+ * constant 0.
+ *
+ * **Required network functions:**
+ * - `clone_node`
+ * - `compute`
+ * - `create_pi`
+ * - `create_po`
+ * - `foreach_fanin`
+ * - `foreach_gate`
+ * - `foreach_node`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `get_constant`
+ * - `get_node`
+ * - `is_complemented`
+ * - `node_to_index`
+ *
+ * \param miter Miter network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk>
+std::optional<bool> sweeping_equivalence_checking( Ntk const& miter, sweeping_equivalence_checking_params const& ps = {}, sweeping_equivalence_checking_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+  static_assert( has_compute_v<Ntk, kitty::static_truth_table<6>>, "Ntk does not implement the compute method for kitty::static_truth_table" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi method" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+
+  sweeping_equivalence_checking_stats st;
+  detail::sweeping_equivalence_checking_impl<Ntk> impl( miter, ps, st );
+  const auto result = impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return result;
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,774 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file binary_network.hpp
+  \brief Versioned binary snapshots of networks
+
+  This file implements a binary format to checkpoint AIGs, XAGs, MIGs,
+  XMGs, and k-LUT networks (including dangling and dead nodes).  The
+  file starts with a fixed-size header followed by 64-byte aligned
+  sections, each of which is a flat array in the in-memory layout of
+  the network's storage.  Reading maps the file into memory and copies
+  each section with a single `memcpy`; no per-node parsing takes place.
+  The structural hash tables of AIGs, XAGs, MIGs, and XMGs are stored
+  in the raw layout of the hash map and are loaded in the same way; for
+  compact AIGs and k-LUT networks they are rebuilt from the nodes.
+
+  Like `serialize_network`, the format uses the native byte order and
+  node layout, i.e., files are not meant to be exchanged between
+  different platforms (use, e.g., `write_aiger` instead).  The header
+  records the layout such that mismatching files are rejected.
+*/
+
+#pragma once
+
+#include "../networks/aig.hpp"
+#include "../networks/klut.hpp"
+#include "../networks/mig.hpp"
+#include "../networks/xag.hpp"
+#include "../networks/xmg.hpp"
+
+#include <parallel_hashmap/phmap_dump.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_BINARY_NETWORK_MMAP
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Version of the binary network format */
+inline constexpr uint32_t binary_network_version = 1u;
+
+/*! \brief Network types that can be stored in the binary network format */
+enum class binary_network_type : uint32_t
+{
+  aig = 1u,
+  xag = 2u,
+  mig = 3u,
+  xmg = 4u,
+  klut = 5u,
+  compact_aig = 6u,
+  compact_klut = 7u
+};
+
+/*! \brief Sections of the binary network format
+ *
+ * Sections that are not used by a network type are empty.
+ */
+enum class binary_network_section : uint32_t
+{
+  nodes = 0u,            /* node array (for k-LUT networks: node data only) */
+  refs,                  /* fan-out counters and values of compact AIGs */
+  visited,               /* visited flags of compact AIGs and k-LUT networks */
+  fanin_offsets,         /* k-LUT networks: first fanin of each node */
+  fanins,                /* k-LUT networks: fanins of all nodes (compact: fanin arena) */
+  functions,             /* k-LUT networks: truth table caches */
+  inputs,
+  outputs,
+  latches,
+  latch_information,
+  hash,                  /* raw layout of the structural hash table */
+  num_sections
+};
+
+/*! \brief Header of the binary network format */
+struct binary_network_header
+{
+  static constexpr uint32_t magic_number = 0x4e42544du; /* "MTBN" in little-endian */
+
+  uint32_t magic{magic_number};
+  uint32_t version{binary_network_version};
+  uint32_t type{0u};
+  uint32_t node_size{0u};
+
+  uint64_t num_nodes{0u};
+  uint32_t num_pis{0u};
+  uint32_t num_pos{0u};
+  uint32_t trav_id{0u};
+
+  /* group width of the hash map implementation, the raw hash table
+   * layout is only loaded if it matches */
+  uint32_t hash_group_width{0u};
+
+  std::array<uint64_t, static_cast<uint32_t>( binary_network_section::num_sections )> offsets{};
+  std::array<uint64_t, static_cast<uint32_t>( binary_network_section::num_sections )> sizes{};
+};
+
+namespace detail
+{
+
+template<class Ntk>
+constexpr binary_network_type binary_network_type_of()
+{
+  using base_type = typename Ntk::base_type;
+  if constexpr ( std::is_same_v<base_type, aig_network> )
+  {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    return binary_network_type::compact_aig;
+#else
+    return binary_network_type::aig;
+#endif
+  }
+  else if constexpr ( std::is_same_v<base_type, xag_network> )
+  {
+    return binary_network_type::xag;
+  }
+  else if constexpr ( std::is_same_v<base_type, mig_network> )
+  {
+    return binary_network_type::mig;
+  }
+  else if constexpr ( std::is_same_v<base_type, xmg_network> )
+  {
+    return binary_network_type::xmg;
+  }
+  else
+  {
+    static_assert( std::is_same_v<base_type, klut_network>, "network type is not supported by the binary network format" );
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    return binary_network_type::compact_klut;
+#else
+    return binary_network_type::klut;
+#endif
+  }
+}
+
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+template<class Ntk>
+inline constexpr bool is_klut_storage_v = false;
+
+template<class Ntk>
+inline constexpr bool is_compact_klut_storage_v = std::is_same_v<typename Ntk::base_type, klut_network>;
+#else
+template<class Ntk>
+inline constexpr bool is_klut_storage_v = std::is_same_v<typename Ntk::base_type, klut_network>;
+
+template<class Ntk>
+inline constexpr bool is_compact_klut_storage_v = false;
+#endif
+
+#if defined( MOCKTURTLE_COMPACT_AIG )
+template<class Ntk>
+inline constexpr bool is_compact_storage_v = std::is_same_v<typename Ntk::base_type, aig_network>;
+#else
+template<class Ntk>
+inline constexpr bool is_compact_storage_v = false;
+#endif
+
+/*! \brief Output archive used to dump raw hash tables */
+struct binary_network_output_archive
+{
+  bool dump( const char* p, size_t size )
+  {
+    os.write( p, size );
+    return os.good();
+  }
+
+  template<typename V>
+  bool dump( V const& v )
+  {
+    return dump( reinterpret_cast<const char*>( &v ), sizeof( V ) );
+  }
+
+  std::ostream& os;
+};
+
+/*! \brief Input archive used to load raw hash tables from memory */
+struct binary_network_input_archive
+{
+  bool load( char* p, size_t size )
+  {
+    if ( static_cast<size_t>( end - pos ) < size )
+    {
+      return false;
+    }
+    std::memcpy( p, pos, size );
+    pos += size;
+    return true;
+  }
+
+  template<typename V>
+  bool load( V* v )
+  {
+    return load( reinterpret_cast<char*>( v ), sizeof( V ) );
+  }
+
+  char const* pos;
+  char const* end;
+};
+
+class binary_network_writer
+{
+public:
+  explicit binary_network_writer( std::ostream& os )
+      : os( os )
+  {
+    /* placeholder, rewritten by `finish` */
+    os.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+  }
+
+  void begin_section( binary_network_section section )
+  {
+    static const char zeros[alignment]{};
+    auto const pos = static_cast<uint64_t>( os.tellp() );
+    auto const padding = ( alignment - pos % alignment ) % alignment;
+    os.write( zeros, padding );
+    header.offsets[static_cast<uint32_t>( section )] = pos + padding;
+    current = section;
+  }
+
+  void end_section()
+  {
+    auto const index = static_cast<uint32_t>( current );
+    header.sizes[index] = static_cast<uint64_t>( os.tellp() ) - header.offsets[index];
+  }
+
+  template<typename T>
+  void write_array( binary_network_section section, T const* data, size_t size )
+  {
+    static_assert( std::is_trivially_copyable_v<T> );
+    begin_section( section );
+    os.write( reinterpret_cast<const char*>( data ), sizeof( T ) * size );
+    end_section();
+  }
+
+  template<typename T>
+  void write( T const& value )
+  {
+    os.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+  }
+
+  bool finish()
+  {
+    auto const end = os.tellp();
+    os.seekp( 0 );
+    os.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    os.seekp( end );
+    return os.good();
+  }
+
+public:
+  static constexpr uint64_t alignment = 64u;
+
+  binary_network_header header;
+  std::ostream& os;
+  binary_network_section current{binary_network_section::nodes};
+};
+
+/*! \brief Read-only view of a binary network file in memory */
+class binary_network_file
+{
+public:
+  explicit binary_network_file( std::string const& filename )
+  {
+#if defined( MOCKTURTLE_BINARY_NETWORK_MMAP )
+    const auto fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+    struct stat st;
+    if ( ::fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+      auto* mapped = ::mmap( nullptr, static_cast<size_t>( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( mapped != MAP_FAILED )
+      {
+        _data = static_cast<char const*>( mapped );
+        _size = static_cast<uint64_t>( st.st_size );
+      }
+    }
+    ::close( fd );
+#else
+    std::ifstream in( filename, std::ios::binary | std::ios::ate );
+    if ( !in.is_open() )
+    {
+      return;
+    }
+    _buffer.resize( static_cast<size_t>( in.tellg() ) );
+    in.seekg( 0 );
+    in.read( _buffer.data(), _buffer.size() );
+    _data = _buffer.data();
+    _size = _buffer.size();
+#endif
+  }
+
+  binary_network_file( binary_network_file const& ) = delete;
+  binary_network_file& operator=( binary_network_file const& ) = delete;
+
+  ~binary_network_file()
+  {
+#if defined( MOCKTURTLE_BINARY_NETWORK_MMAP )
+    if ( _data )
+    {
+      ::munmap( const_cast<char*>( _data ), _size );
+    }
+#endif
+  }
+
+  /*! \brief Returns the header if the file is a valid binary network */
+  binary_network_header const* header() const
+  {
+    if ( _size < sizeof( binary_network_header ) )
+    {
+      return nullptr;
+    }
+
+    auto const* h = reinterpret_cast<binary_network_header const*>( _data );
+    if ( h->magic != binary_network_header::magic_number || h->version != binary_network_version )
+    {
+      return nullptr;
+    }
+    for ( auto i = 0u; i < h->offsets.size(); ++i )
+    {
+      if ( h->offsets[i] > _size || h->sizes[i] > _size - h->offsets[i] )
+      {
+        return nullptr;
+      }
+    }
+    return h;
+  }
+
+  /*! \brief Returns a pointer to the elements of a section */
+  template<typename T>
+  T const* section( binary_network_section section ) const
+  {
+    return reinterpret_cast<T const*>( _data + header()->offsets[static_cast<uint32_t>( section )] );
+  }
+
+  /*! \brief Returns the number of elements in a section */
+  template<typename T>
+  uint64_t section_size( binary_network_section section ) const
+  {
+    return header()->sizes[static_cast<uint32_t>( section )] / sizeof( T );
+  }
+
+  /*! \brief Copies a section into a vector */
+  template<typename T>
+  void read_array( binary_network_section section, std::vector<T>& v ) const
+  {
+    static_assert( std::is_trivially_copyable_v<T> );
+    v.resize( section_size<T>( section ) );
+    if ( !v.empty() )
+    {
+      std::memcpy( static_cast<void*>( v.data() ), this->section<char>( section ), sizeof( T ) * v.size() );
+    }
+  }
+
+  binary_network_input_archive archive( binary_network_section section ) const
+  {
+    auto const* begin = this->section<char>( section );
+    return {begin, begin + header()->sizes[static_cast<uint32_t>( section )]};
+  }
+
+private:
+  char const* _data{nullptr};
+  uint64_t _size{0u};
+#if !defined( MOCKTURTLE_BINARY_NETWORK_MMAP )
+  std::vector<char> _buffer;
+#endif
+};
+
+inline void write_binary_string( binary_network_writer& writer, std::string const& s )
+{
+  writer.write( static_cast<uint64_t>( s.size() ) );
+  writer.os.write( s.data(), s.size() );
+}
+
+inline bool read_binary_string( binary_network_input_archive& ar, std::string& s )
+{
+  uint64_t size;
+  if ( !ar.load( &size ) || static_cast<uint64_t>( ar.end - ar.pos ) < size )
+  {
+    return false;
+  }
+  s.assign( ar.pos, size );
+  ar.pos += size;
+  return true;
+}
+
+} /* namespace detail */
+
+/*! \brief Writes a network in the binary network format to a stream
+ *
+ * Supported network types are `aig_network`, `xag_network`,
+ * `mig_network`, `xmg_network`, and `klut_network` (and views on top of
+ * them).  The stream must be opened in binary mode and be seekable.
+ *
+ * \param ntk Network
+ * \param os Output stream
+ * \return True, if the network has been written successfully
+ */
+template<class Ntk>
+bool write_binary( Ntk const& ntk, std::ostream& os )
+{
+  using section = binary_network_section;
+  using node_type = typename Ntk::storage::element_type::node_type;
+
+  auto const& storage = *ntk._storage;
+  detail::binary_network_writer writer( os );
+
+  auto& header = writer.header;
+  header.type = static_cast<uint32_t>( detail::binary_network_type_of<Ntk>() );
+  header.num_nodes = storage.nodes.size();
+  header.num_pis = storage.data.num_pis;
+  header.num_pos = storage.data.num_pos;
+  header.trav_id = storage.data.trav_id;
+
+  if constexpr ( detail::is_klut_storage_v<Ntk> )
+  {
+    header.node_size = sizeof( typename node_type::pointer_type );
+
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> fanins;
+    std::vector<cauint64_t> data;
+    offsets.reserve( storage.nodes.size() + 1u );
+    data.reserve( 2u * storage.nodes.size() );
+    for ( auto const& n : storage.nodes )
+    {
+      offsets.push_back( fanins.size() );
+      for ( auto const& c : n.children )
+      {
+        fanins.push_back( c.data );
+      }
+      data.insert( data.end(), n.data.begin(), n.data.end() );
+    }
+    offsets.push_back( fanins.size() );
+
+    writer.write_array( section::nodes, data.data(), data.size() );
+    writer.write_array( section::fanin_offsets, offsets.data(), offsets.size() );
+    writer.write_array( section::fanins, fanins.data(), fanins.size() );
+
+    writer.begin_section( section::functions );
+    writer.write( static_cast<uint64_t>( storage.data.cache.size() ) );
+    for ( auto i = 0u; i < storage.data.cache.size(); ++i )
+    {
+      auto const tt = storage.data.cache[2u * i];
+      writer.write( static_cast<uint64_t>( tt.num_vars() ) );
+      os.write( reinterpret_cast<const char*>( &*tt.cbegin() ), sizeof( uint64_t ) * tt.num_blocks() );
+    }
+    writer.end_section();
+  }
+  else
+  {
+    header.node_size = sizeof( node_type );
+    writer.write_array( section::nodes, storage.nodes.data(), storage.nodes.size() );
+
+    if constexpr ( detail::is_compact_storage_v<Ntk> )
+    {
+      writer.write_array( section::refs, storage.refs.data(), storage.refs.size() );
+      writer.write_array( section::visited, storage.visited.data(), storage.visited.size() );
+    }
+    else if constexpr ( detail::is_compact_klut_storage_v<Ntk> )
+    {
+      writer.write_array( section::visited, storage.visited.data(), storage.visited.size() );
+      writer.write_array( section::fanins, storage.fanin_arena.data(), storage.fanin_arena.size() );
+
+      writer.begin_section( section::functions );
+      writer.write( static_cast<uint64_t>( storage.small_functions.size() ) );
+      for ( auto i = 0u; i < storage.small_functions.size(); ++i )
+      {
+        writer.write( storage.small_functions[2u * i] );
+      }
+      writer.write( static_cast<uint64_t>( storage.data.cache.size() ) );
+      for ( auto i = 0u; i < storage.data.cache.size(); ++i )
+      {
+        auto const tt = storage.data.cache[2u * i];
+        writer.write( static_cast<uint64_t>( tt.num_vars() ) );
+        os.write( reinterpret_cast<const char*>( &*tt.cbegin() ), sizeof( uint64_t ) * tt.num_blocks() );
+      }
+      writer.end_section();
+    }
+  }
+
+  writer.write_array( section::inputs, storage.inputs.data(), storage.inputs.size() );
+  writer.write_array( section::outputs, storage.outputs.data(), storage.outputs.size() );
+  writer.write_array( section::latches, storage.data.latches.data(), storage.data.latches.size() );
+
+  writer.begin_section( section::latch_information );
+  writer.write( static_cast<uint64_t>( storage.latch_information.size() ) );
+  for ( auto const& [n, info] : storage.latch_information )
+  {
+    writer.write( static_cast<uint64_t>( n ) );
+    writer.write( static_cast<uint64_t>( info.init ) );
+    detail::write_binary_string( writer, info.control );
+    detail::write_binary_string( writer, info.type );
+  }
+  writer.end_section();
+
+  if constexpr ( !detail::is_klut_storage_v<Ntk> && !detail::is_compact_storage_v<Ntk> && !detail::is_compact_klut_storage_v<Ntk> )
+  {
+    header.hash_group_width = static_cast<uint32_t>( phmap::priv::Group::kWidth );
+    writer.begin_section( section::hash );
+    detail::binary_network_output_archive ar{os};
+    if ( !storage.hash.dump( ar ) )
+    {
+      return false;
+    }
+    writer.end_section();
+  }
+
+  return writer.finish();
+}
+
+/*! \brief Writes a network in the binary network format to a file
+ *
+ * \param ntk Network
+ * \param filename Filename
+ * \return True, if the network has been written successfully
+ */
+template<class Ntk>
+bool write_binary( Ntk const& ntk, std::string const& filename )
+{
+  std::ofstream os( filename, std::ios::binary | std::ios::trunc );
+  return os.is_open() && write_binary( ntk, os );
+}
+
+/*! \brief Reads a network in the binary network format from a file
+ *
+ * The file is mapped into memory and every section is copied into the
+ * storage of the network in one go.  Returns `std::nullopt` if the file
+ * does not exist, is not a binary network file, has a different
+ * version, or stores a network of a different type or layout.
+ *
+ * \param filename Filename
+ * \return Network
+ */
+template<class Ntk>
+std::optional<Ntk> read_binary( std::string const& filename )
+{
+  using section = binary_network_section;
+  using node_type = typename Ntk::storage::element_type::node_type;
+
+  detail::binary_network_file file( filename );
+  auto const* header = file.header();
+  if ( !header || header->type != static_cast<uint32_t>( detail::binary_network_type_of<Ntk>() ) )
+  {
+    return std::nullopt;
+  }
+
+  Ntk ntk;
+  auto& storage = *ntk._storage;
+
+  if constexpr ( detail::is_klut_storage_v<Ntk> )
+  {
+    if ( header->node_size != sizeof( typename node_type::pointer_type ) ||
+         file.section_size<uint64_t>( section::fanin_offsets ) != header->num_nodes + 1u ||
+         file.section_size<cauint64_t>( section::nodes ) != 2u * header->num_nodes )
+    {
+      return std::nullopt;
+    }
+
+    auto const* offsets = file.section<uint64_t>( section::fanin_offsets );
+    auto const* fanins = file.section<uint64_t>( section::fanins );
+    auto const* data = file.section<cauint64_t>( section::nodes );
+    if ( offsets[header->num_nodes] != file.section_size<uint64_t>( section::fanins ) )
+    {
+      return std::nullopt;
+    }
+
+    storage.nodes.resize( header->num_nodes );
+    for ( auto i = 0u; i < header->num_nodes; ++i )
+    {
+      auto& n = storage.nodes[i];
+      n.children.reserve( offsets[i + 1u] - offsets[i] );
+      for ( auto j = offsets[i]; j < offsets[i + 1u]; ++j )
+      {
+        n.children.emplace_back( fanins[j] );
+      }
+      n.data[0] = data[2u * i];
+      n.data[1] = data[2u * i + 1u];
+    }
+
+    auto ar = file.archive( section::functions );
+    uint64_t num_functions;
+    if ( !ar.load( &num_functions ) )
+    {
+      return std::nullopt;
+    }
+    storage.data.cache = decltype( storage.data.cache )( static_cast<uint32_t>( num_functions ) );
+    for ( auto i = 0u; i < num_functions; ++i )
+    {
+      uint64_t num_vars;
+      if ( !ar.load( &num_vars ) )
+      {
+        return std::nullopt;
+      }
+      kitty::dynamic_truth_table tt( static_cast<uint32_t>( num_vars ) );
+      if ( !ar.load( reinterpret_cast<char*>( &*tt.begin() ), sizeof( uint64_t ) * tt.num_blocks() ) )
+      {
+        return std::nullopt;
+      }
+      storage.data.cache.insert( tt );
+    }
+
+    storage.hash.clear();
+    storage.hash.reserve( storage.nodes.size() );
+    for ( auto i = 0u; i < storage.nodes.size(); ++i )
+    {
+      if ( !storage.nodes[i].children.empty() )
+      {
+        storage.hash.emplace( storage.nodes[i], i );
+      }
+    }
+  }
+  else
+  {
+    if ( header->node_size != sizeof( node_type ) || file.section_size<node_type>( section::nodes ) != header->num_nodes )
+    {
+      return std::nullopt;
+    }
+    file.read_array( section::nodes, storage.nodes );
+
+    if constexpr ( detail::is_compact_storage_v<Ntk> )
+    {
+      file.read_array( section::refs, storage.refs );
+      file.read_array( section::visited, storage.visited );
+      if ( storage.refs.size() != header->num_nodes || storage.visited.size() != header->num_nodes )
+      {
+        return std::nullopt;
+      }
+    }
+    else if constexpr ( detail::is_compact_klut_storage_v<Ntk> )
+    {
+      file.read_array( section::visited, storage.visited );
+      file.read_array( section::fanins, storage.fanin_arena );
+      if ( storage.visited.size() != header->num_nodes )
+      {
+        return std::nullopt;
+      }
+
+      auto ar = file.archive( section::functions );
+      uint64_t num_functions;
+      if ( !ar.load( &num_functions ) )
+      {
+        return std::nullopt;
+      }
+      storage.small_functions.clear();
+      for ( auto i = 0u; i < num_functions; ++i )
+      {
+        uint64_t word;
+        if ( !ar.load( &word ) )
+        {
+          return std::nullopt;
+        }
+        storage.small_functions.insert( word );
+      }
+
+      if ( !ar.load( &num_functions ) )
+      {
+        return std::nullopt;
+      }
+      storage.data.cache = decltype( storage.data.cache )( static_cast<uint32_t>( num_functions ) );
+      for ( auto i = 0u; i < num_functions; ++i )
+      {
+        uint64_t num_vars;
+        if ( !ar.load( &num_vars ) )
+        {
+          return std::nullopt;
+        }
+        kitty::dynamic_truth_table tt( static_cast<uint32_t>( num_vars ) );
+        if ( !ar.load( reinterpret_cast<char*>( &*tt.begin() ), sizeof( uint64_t ) * tt.num_blocks() ) )
+        {
+          return std::nullopt;
+        }
+        storage.data.cache.insert( tt );
+      }
+
+      storage.hash.clear();
+      storage.hash.reserve( storage.nodes.size() );
+      for ( auto i = 0u; i < storage.nodes.size(); ++i )
+      {
+        if ( storage.nodes[i].num_fanins != 0u )
+        {
+          storage.hash.insert( i );
+        }
+      }
+    }
+  }
+
+  file.read_array( section::inputs, storage.inputs );
+  file.read_array( section::outputs, storage.outputs );
+  file.read_array( section::latches, storage.data.latches );
+  storage.data.num_pis = header->num_pis;
+  storage.data.num_pos = header->num_pos;
+  storage.data.trav_id = header->trav_id;
+
+  auto ar = file.archive( section::latch_information );
+  uint64_t num_latches;
+  if ( !ar.load( &num_latches ) )
+  {
+    return std::nullopt;
+  }
+  for ( auto i = 0u; i < num_latches; ++i )
+  {
+    uint64_t n;
+    latch_info info;
+    if ( !ar.load( &n ) || !ar.load( &info.init ) || !detail::read_binary_string( ar, info.control ) || !detail::read_binary_string( ar, info.type ) )
+    {
+      return std::nullopt;
+    }
+    storage.latch_information[n] = info;
+  }
+
+  if constexpr ( detail::is_compact_storage_v<Ntk> )
+  {
+    storage.hash.clear();
+    storage.hash.reserve( storage.nodes.size() );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      storage.hash.insert( static_cast<uint32_t>( n ) );
+    } );
+  }
+  else if constexpr ( !detail::is_klut_storage_v<Ntk> && !detail::is_compact_klut_storage_v<Ntk> )
+  {
+    auto hash_ar = file.archive( section::hash );
+    if ( header->hash_group_width != phmap::priv::Group::kWidth || !storage.hash.load( hash_ar ) )
+    {
+      /* different hash map layout, rebuild the hash table instead */
+      storage.hash.clear();
+      storage.hash.reserve( storage.nodes.size() );
+      ntk.foreach_gate( [&]( auto const& n ) {
+        storage.hash[storage.nodes[n]] = n;
+      } );
+    }
+  }
+
+  return ntk;
+}
+
+} /* namespace mockturtle */
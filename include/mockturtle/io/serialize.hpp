@@ -77,6 +77,28 @@ public:
     return ar_input.load( (char*)&ptr->data, sizeof( ptr->data ) );
   }
   
+  template<int PointerFieldSize>
+  bool operator()( phmap::BinaryOutputArchive& os, compact_node_pointer<PointerFieldSize> const& ptr ) const
+  {
+    return os.dump( (char*)&ptr.data, sizeof( ptr.data ) );
+  }
+
+  template<int PointerFieldSize>
+  bool operator()( phmap::BinaryInputArchive& ar_input, compact_node_pointer<PointerFieldSize>* ptr ) const
+  {
+    return ar_input.load( (char*)&ptr->data, sizeof( ptr->data ) );
+  }
+
+  bool operator()( phmap::BinaryOutputArchive& os, compact_aig_node const& n ) const
+  {
+    return this->operator()( os, n.children[0] ) && this->operator()( os, n.children[1] );
+  }
+
+  bool operator()( phmap::BinaryInputArchive& ar_input, compact_aig_node* n ) const
+  {
+    return this->operator()( ar_input, &n->children[0] ) && this->operator()( ar_input, &n->children[1] );
+  }
+
   bool operator()( phmap::BinaryOutputArchive& os, cauint64_t const& data ) const
   {
     return os.dump( (char*)&data.n, sizeof( data.n ) );
@@ -147,6 +169,7 @@ public:
     return true;
   }
 
+#if !defined( MOCKTURTLE_COMPACT_AIG )
   bool operator()( phmap::BinaryOutputArchive& os, std::pair<const node_type, uint64_t> const& value ) const
   {
     return this->operator()( os, value.first ) && this->operator()( os, value.second );
@@ -156,6 +179,7 @@ public:
   {
     return this->operator()( ar_input, &value->first ) && this->operator()( ar_input, &value->second );
   }
+#endif
 
   bool operator()( phmap::BinaryOutputArchive& os, aig_storage const& storage ) const
   {
@@ -192,11 +216,23 @@ public:
       }
     }
 
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    /* node data (the hash table is rebuilt when loading) */
+    for ( const auto& r : storage.refs )
+    {
+      if ( !this->operator()( os, r ) )
+      {
+        return false;
+      }
+    }
+    os.dump( (char*)storage.visited.data(), sizeof( uint32_t ) * storage.visited.size() );
+#else
     /* hash */
     if (! const_cast<aig_storage&>( storage ).hash.dump( os ) )
     {
       return false;
     }
+#endif
 
     /* storage data */
     os.dump( (char*)&storage.data.num_pis, sizeof( uint32_t ) );
@@ -247,11 +283,35 @@ public:
       storage->outputs.push_back( ptr );
     }
 
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    /* node data */
+    storage->refs.resize( storage->nodes.size() );
+    for ( auto& r : storage->refs )
+    {
+      if ( !this->operator()( ar_input, &r ) )
+      {
+        return false;
+      }
+    }
+    storage->visited.resize( storage->nodes.size() );
+    ar_input.load( (char*)storage->visited.data(), sizeof( uint32_t ) * storage->visited.size() );
+
+    /* hash */
+    for ( uint64_t i = 1; i < storage->nodes.size(); ++i )
+    {
+      auto const& n = storage->nodes[i];
+      if ( n.children[0].data != n.children[1].data && !( ( storage->refs[i].h1 >> 31 ) & 1 ) )
+      {
+        storage->hash.insert( static_cast<uint32_t>( i ) );
+      }
+    }
+#else
     /* hash */
     if ( !storage->hash.load( ar_input ) )
     {
       return false;
     }
+#endif
   
     /* aig_storage_data */
     ar_input.load( (char*)&storage->data.num_pis, sizeof( uint32_t ) );
@@ -305,6 +365,10 @@ inline aig_network deserialize_network( phmap::BinaryInputArchive& ar_input )
   detail::serializer _serializer;
   auto storage = std::make_shared<aig_storage>();
   storage->nodes.clear();
+#if defined( MOCKTURTLE_COMPACT_AIG )
+  storage->refs.clear();
+  storage->visited.clear();
+#endif
   storage->inputs.clear();
   storage->outputs.clear();
   storage->latch_information.clear();
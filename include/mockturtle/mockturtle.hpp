@@ -98,6 +98,7 @@
 #include "mockturtle/utils/stopwatch.hpp"
 #include "mockturtle/utils/index_list.hpp"
 #include "mockturtle/utils/truth_table_cache.hpp"
+#include "mockturtle/utils/names_storage.hpp"
 #include "mockturtle/utils/string_utils.hpp"
 #include "mockturtle/utils/algorithm.hpp"
 #include "mockturtle/utils/progress_bar.hpp"
@@ -35,6 +35,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -43,11 +44,20 @@
 #include <kitty/partial_truth_table.hpp>
 #include <kitty/operators.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <thread>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
 
 namespace mockturtle
 {
@@ -67,14 +77,146 @@ struct aig_hash
   }
 };
 
+/*! \brief Compact AIG node
+ *
+ * Stores only the two fanins as 32-bit pointers.  Fan-out sizes,
+ * application-specific values, and visited flags are kept in separate
+ * arrays of the `compact_aig_storage`.
+ */
+struct compact_aig_node
+{
+  using pointer_type = compact_node_pointer<1>;
+
+  std::array<pointer_type, 2> children;
+
+  bool operator==( compact_aig_node const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
+/*! \brief Hash function for index-based structural hashing of compact AIGs
+ *
+ * The hash table only stores node indexes, which are resolved through the
+ * node array of the storage.  Lookups can also be done with a node.
+ */
+struct compact_aig_hash
+{
+  using is_transparent = void;
+
+  uint64_t operator()( uint32_t index ) const
+  {
+    return aig_hash<compact_aig_node>{}( ( *nodes )[index] );
+  }
+
+  uint64_t operator()( compact_aig_node const& n ) const
+  {
+    return aig_hash<compact_aig_node>{}( n );
+  }
+
+  std::vector<compact_aig_node> const* nodes{nullptr};
+};
+
+/*! \brief Equality for index-based structural hashing of compact AIGs */
+struct compact_aig_equal
+{
+  using is_transparent = void;
+
+  bool operator()( uint32_t a, uint32_t b ) const
+  {
+    return a == b || ( *nodes )[a] == ( *nodes )[b];
+  }
+
+  bool operator()( uint32_t a, compact_aig_node const& b ) const
+  {
+    return ( *nodes )[a] == b;
+  }
+
+  bool operator()( compact_aig_node const& a, uint32_t b ) const
+  {
+    return a == ( *nodes )[b];
+  }
+
+  std::vector<compact_aig_node> const* nodes{nullptr};
+};
+
+struct aig_concurrent_strash;
+
 struct aig_storage_data
 {
   uint32_t num_pis = 0u;
   uint32_t num_pos = 0u;
   std::vector<int8_t> latches;
   uint32_t trav_id = 0u;
+  std::shared_ptr<aig_concurrent_strash> concurrent;
+};
+
+/*! \brief Compact AIG storage container
+
+  Nodes are stored with 32-bit fanin pointers (8 bytes per node), the
+  structural hash table only contains node indexes.  Additional data is
+  kept in separate arrays:
+
+  `refs[n].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
+  `refs[n].h2`: Application-specific value
+  `visited[n]`: Visited flag
+
+  The hash functions refer to the node array of the storage, therefore the
+  storage cannot be assigned, and copying it rebuilds the hash table.
+*/
+struct compact_aig_storage
+{
+  compact_aig_storage()
+      : hash( 0u, compact_aig_hash{&nodes}, compact_aig_equal{&nodes} )
+  {
+    nodes.reserve( 10000u );
+    refs.reserve( 10000u );
+    visited.reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+    refs.emplace_back();
+    visited.emplace_back();
+  }
+
+  compact_aig_storage( compact_aig_storage const& other )
+      : nodes( other.nodes ),
+        refs( other.refs ),
+        visited( other.visited ),
+        inputs( other.inputs ),
+        outputs( other.outputs ),
+        latch_information( other.latch_information ),
+        hash( other.hash.begin(), other.hash.end(), other.hash.size(), compact_aig_hash{&nodes}, compact_aig_equal{&nodes} ),
+        fanout( other.fanout ),
+        journal( other.journal ),
+        data( other.data )
+  {
+  }
+
+  compact_aig_storage& operator=( compact_aig_storage const& ) = delete;
+
+  using node_type = compact_aig_node;
+
+  std::vector<node_type> nodes;
+  std::vector<cauint64_t> refs;
+  std::vector<uint32_t> visited;
+  std::vector<uint64_t> inputs;
+  std::vector<node_type::pointer_type> outputs;
+  std::unordered_map<uint64_t, latch_info> latch_information;
+
+  phmap::flat_hash_set<uint32_t, compact_aig_hash, compact_aig_equal> hash;
+
+  fanout_index fanout;
+
+  storage_journal<std::pair<node_type, cauint64_t>, node_type::pointer_type> journal;
+
+  aig_storage_data data;
 };
 
+#if defined( MOCKTURTLE_COMPACT_AIG )
+using aig_storage = compact_aig_storage;
+#else
 /*! \brief AIG storage container
 
   AIGs have nodes with fan-in 2.  We split of one bit of the index pointer to
@@ -84,10 +226,64 @@ struct aig_storage_data
   `data[0].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
   `data[0].h2`: Application-specific value
   `data[1].h1`: Visited flag
+
+  Define `MOCKTURTLE_COMPACT_AIG` (CMake option `MOCKTURTLE_COMPACT_AIG`) to
+  use `compact_aig_storage` instead.
 */
 using aig_storage = storage<regular_node<2, 2, 1>,
                             aig_storage_data,
                             aig_hash<regular_node<2, 2, 1>>>;
+#endif
+
+/*! \brief State of the concurrent structural hashing mode
+ *
+ * Nodes hashed before entering the concurrent mode remain in the
+ * (read-only) storage hash table; nodes created while the mode is active
+ * are hashed into a lock-protected parallel hash table and get their index
+ * from an atomic counter.  The table is merged back into the storage hash
+ * table when the mode is left.
+ */
+struct aig_concurrent_strash
+{
+  using node_type = aig_storage::node_type;
+
+  phmap::parallel_flat_hash_map<node_type, uint64_t,
+                                aig_hash<node_type>,
+                                phmap::priv::hash_default_eq<node_type>,
+                                phmap::priv::Allocator<phmap::priv::Pair<const node_type, uint64_t>>,
+                                6, std::mutex> hash;
+
+  /* index of the next node to be created */
+  std::atomic<uint64_t> next_index{0};
+
+  /* number of nodes, counted from index 0, whose slots are fully
+     initialized; nodes are published in index order */
+  std::atomic<uint64_t> published{0};
+
+  /* number of node slots that are allocated or about to be allocated */
+  std::atomic<uint64_t> reserved{0};
+
+  /* number of node slots available in the storage */
+  uint64_t capacity{0};
+
+  /* number of nodes before entering the concurrent mode */
+  uint64_t initial_size{0};
+};
+
+namespace detail
+{
+
+/*! \brief Atomically increments the fan-out size stored in a node's data word */
+inline void atomic_increment( cauint64_t& word )
+{
+#if defined( _MSC_VER )
+  _InterlockedIncrement64( reinterpret_cast<volatile int64_t*>( &word.n ) );
+#else
+  __atomic_fetch_add( &word.n, 1, __ATOMIC_RELAXED );
+#endif
+}
+
+} // namespace detail
 
 class aig_network
 {
@@ -193,7 +389,7 @@ public:
     (void)name;
 
     const auto index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto& node = _emplace_node();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
     ++_storage->data.num_pis;
@@ -205,7 +401,8 @@ public:
     (void)name;
 
     /* increase ref-count to children */
-    _storage->nodes[f.index].data[0].h1++;
+    _journal_node( f.index );
+    _ref( f.index ).h1++;
     auto const po_index = _storage->outputs.size();
     _storage->outputs.emplace_back( f.index, f.complement );
     ++_storage->data.num_pos;
@@ -217,7 +414,7 @@ public:
     (void)name;
 
     auto const index = _storage->nodes.size();
-    auto& node = _storage->nodes.emplace_back();
+    auto& node = _emplace_node();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
     return {index, 0};
@@ -228,7 +425,8 @@ public:
     (void)name;
 
     /* increase ref-count to children */
-    _storage->nodes[f.index].data[0].h1++;
+    _journal_node( f.index );
+    _ref( f.index ).h1++;
     auto const ri_index = _storage->outputs.size();
     _storage->outputs.emplace_back( f.index, f.complement );
     _storage->data.latches.emplace_back( reset );
@@ -310,28 +508,40 @@ public:
     node.children[1] = b;
 
     /* structural hashing */
-    const auto it = _storage->hash.find( node );
-    if ( it != _storage->hash.end() )
+    if ( const auto it = _strash_find( node ); it )
+    {
+      assert( !is_dead( *it ) );
+      return {*it, 0};
+    }
+
+    if ( _storage->data.concurrent )
     {
-      assert( !is_dead( it->second ) );
-      return {it->second, 0};
+      return create_and_concurrent( node );
     }
 
     const auto index = _storage->nodes.size();
 
     if ( index >= .9 * _storage->nodes.capacity() )
     {
-      _storage->nodes.reserve( static_cast<uint64_t>( 3.1415f * index ) );
+      _reserve_nodes( static_cast<uint64_t>( 3.1415f * index ) );
       _storage->hash.reserve( static_cast<uint64_t>( 3.1415f * index ) );
     }
 
-    _storage->nodes.push_back( node );
+    _emplace_node() = node;
 
-    _storage->hash[node] = index;
+    _strash_insert( node, index );
 
     /* increase ref-count to children */
-    _storage->nodes[a.index].data[0].h1++;
-    _storage->nodes[b.index].data[0].h1++;
+    _journal_node( a.index );
+    _ref( a.index ).h1++;
+    _journal_node( b.index );
+    _ref( b.index ).h1++;
+
+    if ( _storage->fanout.enabled() )
+    {
+      _storage->fanout.add( a.index, index );
+      _storage->fanout.add( b.index, index );
+    }
 
     for ( auto const& fn : _events->on_add )
     {
@@ -437,6 +647,138 @@ public:
   }
 #pragma endregion
 
+#pragma region Concurrent structural hashing
+  /*! \brief Enters the concurrent structural hashing mode.
+   *
+   * While the mode is active, `create_and` (and all functions that are
+   * based on it) can be called from several threads at the same time and
+   * still returns unique, structurally hashed nodes.  All other
+   * modifications of the network (creating primary inputs and outputs,
+   * substitution, deletion) are not allowed until the mode is left with
+   * `end_concurrent_strash`.  Functions registered to `on_add` events are
+   * called from the creating threads.
+   *
+   * The node storage is pre-allocated for `max_new_nodes`, but `size`,
+   * `foreach_node`, and `foreach_gate` only cover nodes that are already
+   * published, i.e., whose creation has completed together with the
+   * creation of all nodes with smaller index.
+   *
+   * \param max_new_nodes Maximum number of nodes created while the mode is
+   *                      active; exceeding it throws `std::length_error`
+   */
+  void begin_concurrent_strash( uint64_t max_new_nodes )
+  {
+    assert( !_storage->data.concurrent && "concurrent structural hashing mode is already active" );
+    assert( !has_checkpoint() && "cannot use concurrent structural hashing while the network has a checkpoint" );
+
+    auto cs = std::make_shared<aig_concurrent_strash>();
+    cs->initial_size = _storage->nodes.size();
+    cs->capacity = cs->initial_size + max_new_nodes;
+    cs->next_index = cs->initial_size;
+    cs->published = cs->initial_size;
+    cs->reserved = cs->initial_size;
+
+    _resize_nodes( cs->capacity );
+    _storage->data.concurrent = cs;
+  }
+
+  /*! \brief Leaves the concurrent structural hashing mode.
+   *
+   * Must not be called while other threads are still creating nodes.
+   */
+  void end_concurrent_strash()
+  {
+    assert( _storage->data.concurrent && "concurrent structural hashing mode is not active" );
+
+    auto& cs = *_storage->data.concurrent;
+    auto const size = cs.next_index.load();
+
+    _resize_nodes( size );
+    _storage->hash.reserve( _storage->hash.size() + cs.hash.size() );
+    for ( auto const& [key, index] : cs.hash )
+    {
+      _strash_insert( key, index );
+    }
+
+    if ( _storage->fanout.enabled() )
+    {
+      for ( auto index = cs.initial_size; index < size; ++index )
+      {
+        _storage->fanout.add( _storage->nodes[index].children[0].index, index );
+        _storage->fanout.add( _storage->nodes[index].children[1].index, index );
+      }
+    }
+
+    _storage->data.concurrent.reset();
+  }
+
+  bool is_concurrent_strash() const
+  {
+    return static_cast<bool>( _storage->data.concurrent );
+  }
+
+  signal create_and_concurrent( storage::element_type::node_type const& node )
+  {
+    auto& cs = *_storage->data.concurrent;
+
+    uint64_t index{};
+    const auto lookup = [&]() {
+      return cs.hash.if_contains( node, [&]( auto const& existing ) { index = existing; } );
+    };
+
+    if ( lookup() )
+    {
+      return {index, 0};
+    }
+
+    /* reserve a slot before hashing, such that concurrently created nodes
+       never exceed the capacity of the storage */
+    if ( cs.reserved.fetch_add( 1u ) >= cs.capacity )
+    {
+      cs.reserved.fetch_sub( 1u );
+      if ( lookup() )
+      {
+        return {index, 0};
+      }
+      throw std::length_error( "too many nodes created in concurrent structural hashing mode" );
+    }
+
+    const auto created = cs.hash.lazy_emplace_l(
+        node,
+        [&]( auto const& existing ) { index = existing; },
+        [&]( auto const& ctor ) {
+          index = cs.next_index.fetch_add( 1u );
+          _storage->nodes[index].children = node.children;
+          ctor( node, index );
+        } );
+
+    if ( !created )
+    {
+      cs.reserved.fetch_sub( 1u );
+      return {index, 0};
+    }
+
+    /* increase ref-count to children */
+    detail::atomic_increment( _ref( node.children[0].index ) );
+    detail::atomic_increment( _ref( node.children[1].index ) );
+
+    /* publish in index order, such that all nodes below `published` are
+       initialized; only waits for threads that already got a smaller index */
+    while ( cs.published.load( std::memory_order_acquire ) != index )
+    {
+      std::this_thread::yield();
+    }
+    cs.published.store( index + 1u, std::memory_order_release );
+
+    for ( auto const& fn : _events->on_add )
+    {
+      fn( index );
+    }
+
+    return {index, 0};
+  }
+#pragma endregion
+
 #pragma region Restructuring
   std::optional<std::pair<node, signal>> replace_in_node( node const& n, node const& old_node, signal new_signal )
   {
@@ -482,25 +824,34 @@ public:
     storage::element_type::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
-    if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
+    if ( const auto it = _strash_find( _hash_obj ); it && *it != old_node )
     {
-      return std::make_pair( n, signal( it->second, 0 ) );
+      return std::make_pair( n, signal( *it, 0 ) );
     }
 
     // remember before
     const auto old_child0 = signal{node.children[0]};
     const auto old_child1 = signal{node.children[1]};
 
+    _journal_node( n );
+
     // erase old node in hash table
-    _storage->hash.erase( node );
+    _strash_erase( node );
 
     // insert updated node into hash table
     node.children[0] = child0;
     node.children[1] = child1;
-    _storage->hash[node] = n;
+    _strash_insert( node, n );
 
     // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
+    _journal_node( new_signal.index );
+    _ref( new_signal.index ).h1++;
+
+    if ( _storage->fanout.enabled() )
+    {
+      _storage->fanout.remove( old_node, n );
+      _storage->fanout.add( new_signal.index, n );
+    }
 
     for ( auto const& fn : _events->on_modified )
     {
@@ -519,13 +870,15 @@ public:
     {
       if ( output.index == old_node )
       {
+        _journal_output( static_cast<uint64_t>( &output - _storage->outputs.data() ) );
         output.index = new_signal.index;
         output.weight ^= new_signal.complement;
 
         if ( old_node != new_signal.index )
         {
           /* increment fan-in of new node */
-          _storage->nodes[new_signal.index].data[0].h1++;
+          _journal_node( new_signal.index );
+          _ref( new_signal.index ).h1++;
         }
       }
     }
@@ -538,9 +891,10 @@ public:
       return;
 
     /* delete the node (ignoring it's current fanout_size) */
+    _journal_node( n );
     auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
-    _storage->hash.erase( nobj );
+    _ref( n ).h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
+    _strash_erase( nobj );
 
     for ( auto const& fn : _events->on_delete )
     {
@@ -551,6 +905,7 @@ public:
        fanins and try to take them out if their fanout_size become 0 */
     for ( auto i = 0u; i < 2u; ++i )
     {
+      _storage->fanout.remove( nobj.children[i].index, n );
       if ( fanout_size( nobj.children[i].index ) == 0 )
       {
         continue;
@@ -564,7 +919,7 @@ public:
 
   inline bool is_dead( node const& n ) const
   {
-    return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
+    return ( _ref( n ).h1 >> 31 ) & 1;
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -577,16 +932,12 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
-        if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
-
+      foreach_substitution_candidate( _old, [&]( auto const& idx ) {
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -645,16 +996,11 @@ public:
       auto const [old_node, new_signal] = substitutions.front();
       substitutions.pop_front();
 
-      for ( auto index = 1u; index < _storage->nodes.size(); ++index )
-      {
-        /* skip CIs and dead nodes */
-        if ( is_ci( index ) || is_dead( index ) )
-          continue;
-
+      foreach_substitution_candidate( old_node, [&]( auto const& index ) {
         /* skip nodes that will be deleted */
         if ( std::find_if( std::begin( substitutions ), std::end( substitutions ),
                            [&index]( auto s ){ return s.first == index; } ) != std::end( substitutions ) )
-          continue;
+          return;
 
         /* replace in node */
         if ( const auto repl = replace_in_node( index, old_node, new_signal ); repl )
@@ -662,7 +1008,7 @@ public:
           incr_fanout_size( get_node( repl->second ) );
           substitutions.emplace_back( *repl );
         }
-      }
+      } );
 
       /* replace in outputs */
       replace_in_outputs( old_node, new_signal );
@@ -692,10 +1038,217 @@ public:
   }
 #pragma endregion
 
+#pragma region Checkpoints
+  /*! \brief Creates a checkpoint to which the network can be rolled back.
+   *
+   * Afterwards, the network journals the original state of every node
+   * and output before changing it.  `rollback` undoes all structural
+   * changes since the checkpoint (created nodes, modified fanins, fan-out
+   * counters, deleted nodes, and outputs) in time proportional to the
+   * number of changed nodes, whereas `release_checkpoint` keeps them.
+   * Application-specific values and visited flags are not journaled, and
+   * views that maintain data through network events need to be updated
+   * after a rollback.
+   */
+  void checkpoint()
+  {
+    assert( !has_checkpoint() && "network already has a checkpoint" );
+    assert( !is_concurrent_strash() && "cannot create a checkpoint in concurrent structural hashing mode" );
+    _storage->journal.begin( *_storage );
+  }
+
+  bool has_checkpoint() const
+  {
+    return _storage->journal.active;
+  }
+
+  /*! \brief Keeps all changes since the checkpoint and stops journaling. */
+  void release_checkpoint()
+  {
+    _storage->journal.clear();
+  }
+
+  /*! \brief Undoes all changes since the checkpoint and stops journaling. */
+  void rollback()
+  {
+    assert( has_checkpoint() && "network has no checkpoint" );
+    auto& journal = _storage->journal;
+
+    /* remove hash table and fanout index entries of changed nodes */
+    const auto unlink = [&]( node const& n ) {
+      if ( n == 0 || is_ci( n ) )
+      {
+        return;
+      }
+      if ( const auto it = _strash_find( _storage->nodes[n] ); it && *it == n )
+      {
+        _strash_erase( _storage->nodes[n] );
+      }
+      if ( _storage->fanout.enabled() )
+      {
+        for ( auto const& c : _storage->nodes[n].children )
+        {
+          _storage->fanout.remove( c.index, n );
+        }
+      }
+    };
+    for ( auto n = journal.num_nodes; n < _storage->nodes.size(); ++n )
+    {
+      unlink( n );
+    }
+    for ( auto const& [n, record] : journal.nodes )
+    {
+      unlink( n );
+    }
+
+    /* restore original nodes and outputs */
+    for ( auto const& [n, record] : journal.nodes )
+    {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+      _storage->nodes[n] = record.first;
+      _storage->refs[n] = record.second;
+#else
+      _storage->nodes[n] = record;
+#endif
+    }
+    journal.restore( *_storage );
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    _storage->refs.resize( journal.num_nodes );
+    _storage->visited.resize( journal.num_nodes );
+#endif
+
+    for ( auto const& [n, record] : journal.nodes )
+    {
+      if ( n == 0 || is_ci( n ) || is_dead( n ) )
+      {
+        continue;
+      }
+      if ( !_strash_find( _storage->nodes[n] ) )
+      {
+        _strash_insert( _storage->nodes[n], n );
+      }
+      if ( _storage->fanout.enabled() )
+      {
+        for ( auto const& c : _storage->nodes[n].children )
+        {
+          _storage->fanout.add( c.index, n );
+        }
+      }
+    }
+
+    journal.clear();
+  }
+#pragma endregion
+
+#pragma region Compaction
+  /*! \brief Removes dead nodes from the storage.
+   *
+   * Renumbers the remaining nodes in topological order (constant, CIs,
+   * then gates) and rebuilds the structural hash table as well as the
+   * fanout index, if it has been built.  Returns a map from old to new
+   * node indexes, in which dead nodes are mapped to
+   * `std::numeric_limits<node>::max()`.  Node indexes kept outside of
+   * the network, e.g., in node maps or views, must be updated with it.
+   */
+  std::vector<node> compact()
+  {
+    assert( !is_concurrent_strash() && "cannot compact in concurrent structural hashing mode" );
+    assert( !has_checkpoint() && "cannot compact while the network has a checkpoint" );
+
+    auto const old_to_new = detail::compaction_map( *_storage, [this]( auto const& n ) { return is_dead( n ); } );
+    auto const size = static_cast<uint64_t>( std::count_if( old_to_new.begin(), old_to_new.end(), []( auto const& i ) { return i != detail::compact_removed; } ) );
+
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    detail::permute_by_map( _storage->refs, old_to_new, size );
+    detail::permute_by_map( _storage->visited, old_to_new, size );
+#endif
+    detail::apply_compaction_map( *_storage, old_to_new, size, [&]( auto& nobj, auto const& n ) {
+      if ( n != 0 && !is_ci( n ) )
+      {
+        detail::remap_children( nobj, old_to_new );
+      }
+    } );
+
+    _storage->hash.clear();
+    _storage->hash.reserve( size );
+    foreach_gate( [&]( auto const& n ) {
+      _strash_insert( _storage->nodes[n], n );
+    } );
+
+    if ( has_fanout_index() )
+    {
+      build_fanout_index();
+    }
+
+    return old_to_new;
+  }
+#pragma endregion
+
+#pragma region Fanout index
+  /*! \brief Builds the fanout index of the network.
+   *
+   * Once built, the index is maintained by the network and restricts
+   * `substitute_node` and `substitute_nodes` to the actual fanouts of
+   * the substituted node instead of scanning all nodes.
+   */
+  void build_fanout_index()
+  {
+    _storage->fanout.clear();
+    _storage->fanout.fanouts.resize( _storage->nodes.size() );
+    foreach_gate( [&]( auto const& n ) {
+      foreach_fanin( n, [&]( auto const& f ) {
+        _storage->fanout.add( f.index, n );
+      } );
+    } );
+  }
+
+  bool has_fanout_index() const
+  {
+    return _storage->fanout.enabled();
+  }
+
+  void clear_fanout_index()
+  {
+    _storage->fanout.clear();
+  }
+
+  /*! \brief Calls `fn` on every live gate that may have `n` as fanin.
+   *
+   * Gates are visited in increasing index order.  Without a fanout
+   * index, all gates are candidates.
+   */
+  template<typename Fn>
+  void foreach_substitution_candidate( node const& n, Fn&& fn )
+  {
+    if ( _storage->fanout.enabled() )
+    {
+      /* copy, since substitution modifies the fanout index */
+      auto parents = _storage->fanout.at( n );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        if ( !is_dead( p ) )
+        {
+          fn( p );
+        }
+      }
+      return;
+    }
+
+    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+    {
+      if ( is_ci( idx ) || is_dead( idx ) )
+        continue; /* ignore CIs */
+
+      fn( idx );
+    }
+  }
+#pragma endregion
+
 #pragma region Structural properties
   auto size() const
   {
-    return static_cast<uint32_t>( _storage->nodes.size() );
+    return static_cast<uint32_t>( _num_nodes() );
   }
 
   auto num_cis() const
@@ -743,17 +1296,19 @@ public:
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return _ref( n ).h1 & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t incr_fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    _journal_node( n );
+    return _ref( n ).h1++ & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    _journal_node( n );
+    return --_ref( n ).h1 & UINT32_C( 0x7FFFFFFF );
   }
 
   bool is_and( node const& n ) const
@@ -961,7 +1516,7 @@ public:
   template<typename Fn>
   void foreach_node( Fn&& fn ) const
   {
-    auto r = range<uint64_t>( _storage->nodes.size() );
+    auto r = range<uint64_t>( _num_nodes() );
     detail::foreach_element_if( r.begin(), r.end(),
                                 [this]( auto n ) { return !is_dead( n ); },
                                 fn );
@@ -1051,7 +1606,7 @@ public:
   template<typename Fn>
   void foreach_gate( Fn&& fn ) const
   {
-    auto r = range<uint64_t>( 1u, _storage->nodes.size() ); /* start from 1 to avoid constant */
+    auto r = range<uint64_t>( 1u, _num_nodes() ); /* start from 1 to avoid constant */
     detail::foreach_element_if( r.begin(), r.end(),
                                 [this]( auto n ) { return !is_ci( n ) && !is_dead( n ); },
                                 fn );
@@ -1158,44 +1713,60 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    std::for_each( _storage->refs.begin(), _storage->refs.end(), []( auto& r ) { r.h2 = 0; } );
+#else
     std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+#endif
   }
 
   auto value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return _ref( n ).h2;
   }
 
   void set_value( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[0].h2 = v;
+    _ref( n ).h2 = v;
   }
 
   auto incr_value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2++;
+    return _ref( n ).h2++;
   }
 
   auto decr_value( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h2;
+    return --_ref( n ).h2;
   }
 #pragma endregion
 
 #pragma region Visited flags
   void clear_visited() const
   {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    std::fill( _storage->visited.begin(), _storage->visited.end(), 0u );
+#else
     std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+#endif
   }
 
   auto visited( node const& n ) const
   {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    return _storage->visited[n];
+#else
     return _storage->nodes[n].data[1].h1;
+#endif
   }
 
   void set_visited( node const& n, uint32_t v ) const
   {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    _storage->visited[n] = v;
+#else
     _storage->nodes[n].data[1].h1 = v;
+#endif
   }
 
   uint32_t trav_id() const
@@ -1216,6 +1787,108 @@ public:
   }
 #pragma endregion
 
+#pragma region Storage access
+  /*! \brief Fan-out size (`h1`, MSB indicates dead nodes) and value (`h2`) of a node */
+  cauint64_t& _ref( node const& n ) const
+  {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    return _storage->refs[n];
+#else
+    return _storage->nodes[n].data[0];
+#endif
+  }
+
+  storage::element_type::node_type& _emplace_node()
+  {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    _storage->refs.emplace_back();
+    _storage->visited.emplace_back();
+#endif
+    return _storage->nodes.emplace_back();
+  }
+
+  void _reserve_nodes( uint64_t size )
+  {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    _storage->refs.reserve( size );
+    _storage->visited.reserve( size );
+#endif
+    _storage->nodes.reserve( size );
+  }
+
+  /*! \brief Number of node slots that are safe to read (see `begin_concurrent_strash`) */
+  uint64_t _num_nodes() const
+  {
+    if ( _storage->data.concurrent )
+    {
+      return _storage->data.concurrent->published.load( std::memory_order_acquire );
+    }
+    return _storage->nodes.size();
+  }
+
+  void _resize_nodes( uint64_t size )
+  {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    _storage->refs.resize( size );
+    _storage->visited.resize( size );
+#endif
+    _storage->nodes.resize( size );
+  }
+
+  std::optional<node> _strash_find( storage::element_type::node_type const& key ) const
+  {
+    if ( const auto it = _storage->hash.find( key ); it != _storage->hash.end() )
+    {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+      return *it;
+#else
+      return it->second;
+#endif
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Hashes `key` to `n`, overriding a previous entry for `key`
+   *
+   * In compact storages, `key` must already be stored at index `n`.
+   */
+  void _strash_insert( storage::element_type::node_type const& key, node const& n )
+  {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+    assert( _storage->nodes[n] == key );
+    _storage->hash.erase( key );
+    _storage->hash.insert( static_cast<uint32_t>( n ) );
+#else
+    _storage->hash[key] = n;
+#endif
+  }
+
+  void _strash_erase( storage::element_type::node_type const& key )
+  {
+    _storage->hash.erase( key );
+  }
+
+  void _journal_node( node const& n ) const
+  {
+    if ( _storage->journal.record_node( n ) )
+    {
+#if defined( MOCKTURTLE_COMPACT_AIG )
+      _storage->journal.nodes.emplace_back( n, std::make_pair( _storage->nodes[n], _storage->refs[n] ) );
+#else
+      _storage->journal.nodes.emplace_back( n, _storage->nodes[n] );
+#endif
+    }
+  }
+
+  void _journal_output( uint64_t index ) const
+  {
+    if ( _storage->journal.record_output( index ) )
+    {
+      _storage->journal.outputs.emplace_back( index, _storage->outputs[index] );
+    }
+  }
+#pragma endregion
+
 public:
   std::shared_ptr<aig_storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
@@ -0,0 +1,176 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compact.hpp
+  \brief In-place removal of dead nodes from storages
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mockturtle::detail
+{
+
+/*! \brief Index assigned to dead nodes in compaction maps */
+inline constexpr uint64_t compact_removed = std::numeric_limits<uint64_t>::max();
+
+/*! \brief Computes a topological renumbering of all live nodes
+ *
+ * The constant keeps index 0, followed by the CIs in the order of their CI
+ * index.  All other live nodes are numbered in depth-first post-order,
+ * starting the traversal from the nodes in index order, such that networks
+ * whose indexes already are topological keep their order.  Dead nodes are
+ * mapped to `compact_removed`.
+ */
+template<class Storage, class IsDead>
+std::vector<uint64_t> compaction_map( Storage const& storage, IsDead&& is_dead )
+{
+  std::vector<uint64_t> old_to_new( storage.nodes.size(), compact_removed );
+  uint64_t next{0};
+
+  old_to_new[0] = next++;
+  for ( auto const& i : storage.inputs )
+  {
+    old_to_new[i] = next++;
+  }
+
+  std::vector<std::pair<uint64_t, uint32_t>> stack;
+  for ( uint64_t root = 1u; root < storage.nodes.size(); ++root )
+  {
+    if ( old_to_new[root] != compact_removed || is_dead( root ) )
+    {
+      continue;
+    }
+
+    stack.emplace_back( root, 0u );
+    while ( !stack.empty() )
+    {
+      auto& [n, i] = stack.back();
+      auto const& children = storage.nodes[n].children;
+      if ( i < children.size() )
+      {
+        auto const child = children[i++].index;
+        assert( !is_dead( child ) );
+        if ( old_to_new[child] == compact_removed )
+        {
+          stack.emplace_back( child, 0u );
+        }
+        continue;
+      }
+
+      old_to_new[n] = next++;
+      stack.pop_back();
+    }
+  }
+
+  return old_to_new;
+}
+
+/*! \brief Moves the live elements of `v` to their new indexes */
+template<class T>
+void permute_by_map( std::vector<T>& v, std::vector<uint64_t> const& old_to_new, uint64_t new_size )
+{
+  std::vector<T> permuted( new_size );
+  for ( auto i = 0u; i < v.size(); ++i )
+  {
+    if ( old_to_new[i] != compact_removed )
+    {
+      permuted[old_to_new[i]] = std::move( v[i] );
+    }
+  }
+  v.swap( permuted );
+}
+
+/*! \brief Applies a compaction map to the nodes and I/Os of a storage
+ *
+ * Nodes are moved to their new position, after which `remap_node` is
+ * called for each of them with its new index to update its fanins.  The
+ * structural hash table is not touched and needs to be rebuilt by the
+ * caller.
+ */
+template<class Storage, class Fn>
+void apply_compaction_map( Storage& storage, std::vector<uint64_t> const& old_to_new, uint64_t new_size, Fn&& remap_node )
+{
+  permute_by_map( storage.nodes, old_to_new, new_size );
+  for ( auto i = 0u; i < storage.nodes.size(); ++i )
+  {
+    remap_node( storage.nodes[i], i );
+  }
+
+  for ( auto& i : storage.inputs )
+  {
+    i = old_to_new[i];
+  }
+  for ( auto& o : storage.outputs )
+  {
+    assert( old_to_new[o.index] != compact_removed );
+    o.index = old_to_new[o.index];
+  }
+
+  std::unordered_map<uint64_t, typename decltype( storage.latch_information )::mapped_type> latch_information;
+  for ( auto& [n, info] : storage.latch_information )
+  {
+    if ( old_to_new[n] != compact_removed )
+    {
+      latch_information.emplace( old_to_new[n], std::move( info ) );
+    }
+  }
+  storage.latch_information.swap( latch_information );
+}
+
+/*! \brief Remaps the fanins of a gate and restores their canonical order
+ *
+ * Fanins are sorted by increasing index, or by decreasing index if
+ * `descending` is true (networks such as XAGs encode the gate type in the
+ * order of the fanins).
+ */
+template<class Node>
+void remap_children( Node& node, std::vector<uint64_t> const& old_to_new, bool descending = false )
+{
+  for ( auto& c : node.children )
+  {
+    assert( old_to_new[c.index] != compact_removed );
+    c.index = old_to_new[c.index];
+  }
+
+  if ( descending )
+  {
+    std::sort( node.children.begin(), node.children.end(), []( auto const& a, auto const& b ) { return a.index > b.index; } );
+  }
+  else
+  {
+    std::sort( node.children.begin(), node.children.end(), []( auto const& a, auto const& b ) { return a.index < b.index; } );
+  }
+}
+
+} // namespace mockturtle::detail
@@ -42,7 +42,9 @@
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
 
+#include <array>
 #include <memory>
 
 namespace mockturtle
@@ -72,11 +74,202 @@ struct klut_storage_node : mixed_fanin_node<2>
   }
 };
 
+/*! \brief Compact k-LUT node
+ *
+ * Stores up to 6 fanins inline as 32-bit pointers.  Nodes with more fanins
+ * keep them in the fanin arena of the `compact_klut_storage`, in which case
+ * the first inline pointer holds the offset of the fanins in the arena.
+ *
+ * `function`: Function literal in the truth table cache for functions with
+ *             up to 6 variables (if `num_vars <= 6`) or in the one for
+ *             larger functions
+ * `data.h1`: Fan-out size
+ * `data.h2`: Application-specific value
+ */
+struct compact_klut_node
+{
+  using pointer_type = compact_node_pointer<0>;
+
+  static constexpr uint32_t max_inline_fanins = 6u;
+
+  uint16_t num_fanins{0};
+  uint16_t num_vars{0};
+  uint32_t function{0};
+  std::array<pointer_type, max_inline_fanins> fanins{};
+  cauint64_t data;
+
+  bool operator==( compact_klut_node const& other ) const
+  {
+    return num_fanins == other.num_fanins && num_vars == other.num_vars && function == other.function && fanins == other.fanins;
+  }
+};
+
+/*! \brief Lookup key for structural hashing of compact k-LUTs */
+struct compact_klut_key
+{
+  uint64_t const* fanins;
+  uint32_t num_fanins;
+  uint32_t num_vars;
+  uint32_t function;
+};
+
+namespace detail
+{
+
+/*! \brief Fanins of a compact k-LUT node, which are inline or in the arena */
+inline compact_klut_node::pointer_type const* compact_klut_fanins( compact_klut_node const& n, std::vector<compact_klut_node::pointer_type> const& arena )
+{
+  return n.num_fanins > compact_klut_node::max_inline_fanins ? arena.data() + n.fanins[0].data : n.fanins.data();
+}
+
+} // namespace detail
+
+/*! \brief Hash function for index-based structural hashing of compact k-LUTs
+ *
+ * The hash table only stores node indexes, which are resolved through the
+ * node array and the fanin arena of the storage.  Lookups can also be done
+ * with a key.
+ */
+struct compact_klut_hash
+{
+  using is_transparent = void;
+
+  uint64_t operator()( uint32_t index ) const
+  {
+    auto const& n = ( *nodes )[index];
+    auto const* fanins = detail::compact_klut_fanins( n, *arena );
+
+    auto seed = hash_block( n.function );
+    for ( auto i = 0u; i < n.num_fanins; ++i )
+    {
+      hash_combine( seed, hash_block( fanins[i].index ) );
+    }
+    return seed;
+  }
+
+  uint64_t operator()( compact_klut_key const& key ) const
+  {
+    auto seed = hash_block( key.function );
+    for ( auto i = 0u; i < key.num_fanins; ++i )
+    {
+      hash_combine( seed, hash_block( key.fanins[i] ) );
+    }
+    return seed;
+  }
+
+  std::vector<compact_klut_node> const* nodes{nullptr};
+  std::vector<compact_klut_node::pointer_type> const* arena{nullptr};
+};
+
+/*! \brief Equality for index-based structural hashing of compact k-LUTs */
+struct compact_klut_equal
+{
+  using is_transparent = void;
+
+  bool operator()( uint32_t a, uint32_t b ) const
+  {
+    if ( a == b )
+    {
+      return true;
+    }
+
+    auto const& na = ( *nodes )[a];
+    auto const& nb = ( *nodes )[b];
+    if ( na.num_fanins != nb.num_fanins || na.num_vars != nb.num_vars || na.function != nb.function )
+    {
+      return false;
+    }
+    auto const* fa = detail::compact_klut_fanins( na, *arena );
+    return std::equal( fa, fa + na.num_fanins, detail::compact_klut_fanins( nb, *arena ) );
+  }
+
+  bool operator()( uint32_t a, compact_klut_key const& b ) const
+  {
+    auto const& na = ( *nodes )[a];
+    if ( na.num_fanins != b.num_fanins || na.num_vars != b.num_vars || na.function != b.function )
+    {
+      return false;
+    }
+    auto const* fa = detail::compact_klut_fanins( na, *arena );
+    return std::equal( fa, fa + na.num_fanins, b.fanins, []( auto const& f, auto const& g ) { return f.index == g; } );
+  }
+
+  bool operator()( compact_klut_key const& a, uint32_t b ) const
+  {
+    return ( *this )( b, a );
+  }
+
+  std::vector<compact_klut_node> const* nodes{nullptr};
+  std::vector<compact_klut_node::pointer_type> const* arena{nullptr};
+};
+
+/*! \brief Compact k-LUT storage container
+
+  Nodes are stored with up to 6 inline 32-bit fanin pointers (40 bytes per
+  node), larger fanin lists are appended to a shared fanin arena.  Node
+  functions with up to 6 variables are stored as 64-bit words in a flat
+  truth table cache (`small_functions`), larger ones in `data.cache`.  The
+  structural hash table only contains node indexes, and visited flags are
+  kept in a separate array.
+
+  The hash functions refer to the node array and the fanin arena of the
+  storage, therefore the storage cannot be assigned, and copying it rebuilds
+  the hash table.
+*/
+struct compact_klut_storage
+{
+  compact_klut_storage()
+      : hash( 0u, compact_klut_hash{&nodes, &fanin_arena}, compact_klut_equal{&nodes, &fanin_arena} )
+  {
+    nodes.reserve( 10000u );
+    visited.reserve( 10000u );
+    hash.reserve( 10000u );
+
+    /* we generally reserve the first node for a constant */
+    nodes.emplace_back();
+    visited.emplace_back();
+  }
+
+  compact_klut_storage( compact_klut_storage const& other )
+      : nodes( other.nodes ),
+        visited( other.visited ),
+        fanin_arena( other.fanin_arena ),
+        inputs( other.inputs ),
+        outputs( other.outputs ),
+        latch_information( other.latch_information ),
+        hash( other.hash.begin(), other.hash.end(), other.hash.size(), compact_klut_hash{&nodes, &fanin_arena}, compact_klut_equal{&nodes, &fanin_arena} ),
+        small_functions( other.small_functions ),
+        data( other.data )
+  {
+  }
+
+  compact_klut_storage& operator=( compact_klut_storage const& ) = delete;
+
+  using node_type = compact_klut_node;
+
+  std::vector<node_type> nodes;
+  std::vector<uint32_t> visited;
+  std::vector<node_type::pointer_type> fanin_arena;
+  std::vector<uint64_t> inputs;
+  std::vector<node_type::pointer_type> outputs;
+  std::unordered_map<uint64_t, latch_info> latch_information;
+
+  phmap::flat_hash_set<uint32_t, compact_klut_hash, compact_klut_equal> hash;
+
+  truth_table_cache<uint64_t> small_functions;
+  klut_storage_data data;
+};
+
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+using klut_storage = compact_klut_storage;
+#else
 /*! \brief k-LUT storage container
 
-  ...
+  Define `MOCKTURTLE_COMPACT_KLUT` (CMake option `MOCKTURTLE_COMPACT_KLUT`)
+  to use `compact_klut_storage` instead.
 */
 using klut_storage = storage<klut_storage_node, klut_storage_data>;
+#endif
 
 class klut_network
 {
@@ -108,60 +301,60 @@ private:
   inline void _init()
   {
     /* reserve the second node for constant 1 */
-    _storage->nodes.emplace_back();
+    _emplace_node( {}, 0, 0 );
 
     /* reserve some truth tables for nodes */
     kitty::dynamic_truth_table tt_zero( 0 );
-    _storage->data.cache.insert( tt_zero );
+    _insert_function( tt_zero );
 
     static uint64_t _not = 0x1;
     kitty::dynamic_truth_table tt_not( 1 );
     kitty::create_from_words( tt_not, &_not, &_not + 1 );
-    _storage->data.cache.insert( tt_not );
+    _insert_function( tt_not );
 
     static uint64_t _and = 0x8;
     kitty::dynamic_truth_table tt_and( 2 );
     kitty::create_from_words( tt_and, &_and, &_and + 1 );
-    _storage->data.cache.insert( tt_and );
+    _insert_function( tt_and );
 
     static uint64_t _or = 0xe;
     kitty::dynamic_truth_table tt_or( 2 );
     kitty::create_from_words( tt_or, &_or, &_or + 1 );
-    _storage->data.cache.insert( tt_or );
+    _insert_function( tt_or );
 
     static uint64_t _lt = 0x4;
     kitty::dynamic_truth_table tt_lt( 2 );
     kitty::create_from_words( tt_lt, &_lt, &_lt + 1 );
-    _storage->data.cache.insert( tt_lt );
+    _insert_function( tt_lt );
 
     static uint64_t _le = 0xd;
     kitty::dynamic_truth_table tt_le( 2 );
     kitty::create_from_words( tt_le, &_le, &_le + 1 );
-    _storage->data.cache.insert( tt_le );
+    _insert_function( tt_le );
 
     static uint64_t _xor = 0x6;
     kitty::dynamic_truth_table tt_xor( 2 );
     kitty::create_from_words( tt_xor, &_xor, &_xor + 1 );
-    _storage->data.cache.insert( tt_xor );
+    _insert_function( tt_xor );
 
     static uint64_t _maj = 0xe8;
     kitty::dynamic_truth_table tt_maj( 3 );
     kitty::create_from_words( tt_maj, &_maj, &_maj + 1 );
-    _storage->data.cache.insert( tt_maj );
+    _insert_function( tt_maj );
 
     static uint64_t _ite = 0xd8;
     kitty::dynamic_truth_table tt_ite( 3 );
     kitty::create_from_words( tt_ite, &_ite, &_ite + 1 );
-    _storage->data.cache.insert( tt_ite );
+    _insert_function( tt_ite );
 
     static uint64_t _xor3 = 0x96;
     kitty::dynamic_truth_table tt_xor3( 3 );
     kitty::create_from_words( tt_xor3, &_xor3, &_xor3 + 1 );
-    _storage->data.cache.insert( tt_xor3 );
+    _insert_function( tt_xor3 );
 
     /* truth tables for constants */
-    _storage->nodes[0].data[1].h1 = 0;
-    _storage->nodes[1].data[1].h1 = 1;
+    _set_function_literal( 0, 0 );
+    _set_function_literal( 1, 1 );
   }
 #pragma endregion
 
@@ -177,9 +370,8 @@ public:
     (void)name;
 
     const auto index = _storage->nodes.size();
-    _storage->nodes.emplace_back();
+    _emplace_node( {}, 2, 1 );
     _storage->inputs.emplace_back( index );
-    _storage->nodes[index].data[1].h1 = 2;
     ++_storage->data.num_pis;
     return index;
   }
@@ -189,7 +381,7 @@ public:
     (void)name;
 
     /* increase ref-count to children */
-    _storage->nodes[f].data[0].h1++;
+    _ref( f ).h1++;
 
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f );
@@ -202,9 +394,8 @@ public:
     (void)name;
 
     auto const index = static_cast<uint32_t>( _storage->nodes.size() );
-    _storage->nodes.emplace_back();
+    _emplace_node( {}, 2, 1 );
     _storage->inputs.emplace_back( index );
-    _storage->nodes[index].data[1].h1 = 2;
     return index;
   }
 
@@ -213,7 +404,7 @@ public:
     (void)name;
 
     /* increase ref-count to children */
-    _storage->nodes[f].data[0].h1++;
+    _ref( f ).h1++;
     auto const ri_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f );
     _storage->data.latches.emplace_back( reset );
@@ -361,6 +552,18 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Create arbitrary functions
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    const compact_klut_key key{children.data(), static_cast<uint32_t>( children.size() ), static_cast<uint32_t>( children.size() ), literal};
+    const auto it = _storage->hash.find( key );
+    if ( it != _storage->hash.end() )
+    {
+      return *it;
+    }
+
+    const auto index = _storage->nodes.size();
+    _emplace_node( children, literal, static_cast<uint32_t>( children.size() ) );
+    _storage->hash.insert( static_cast<uint32_t>( index ) );
+#else
     storage::element_type::node_type node;
     std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
     node.data[1].h1 = literal;
@@ -374,11 +577,12 @@ signal create_maj( signal a, signal b, signal c )
     const auto index = _storage->nodes.size();
     _storage->nodes.push_back( node );
     _storage->hash[node] = index;
+#endif
 
     /* increase ref-count to children */
     for ( auto c : children )
     {
-      _storage->nodes[c].data[0].h1++;
+      _ref( c ).h1++;
     }
 
     set_value( index, 0 );
@@ -398,14 +602,14 @@ signal create_maj( signal a, signal b, signal c )
       assert( function.num_vars() == 0u );
       return get_constant( !kitty::is_const0( function ) );
     }
-    return _create_node( children, _storage->data.cache.insert( function ) );
+    assert( function.num_vars() == children.size() );
+    return _create_node( children, _insert_function( function ) );
   }
 
   signal clone_node( klut_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( !children.empty() );
-    const auto tt = other._storage->data.cache[other._storage->nodes[source].data[1].h1];
-    return create_node( children, tt );
+    return create_node( children, other.node_function( source ) );
   }
 #pragma endregion
 
@@ -415,17 +619,17 @@ signal create_maj( signal a, signal b, signal c )
     /* find all parents from old_node */
     for ( auto i = 0u; i < _storage->nodes.size(); ++i )
     {
-      auto& n = _storage->nodes[i];
-      for ( auto& child : n.children )
+      const auto begin = _fanin_begin( i ), end = begin + fanin_size( i );
+      for ( auto it = begin; it != end; ++it )
       {
-        if ( child == old_node )
+        if ( *it == old_node )
         {
-          std::vector<signal> old_children( n.children.size() );
-          std::transform( n.children.begin(), n.children.end(), old_children.begin(), []( auto c ) { return c.index; } );
-          child = new_signal;
+          std::vector<signal> old_children( end - begin );
+          std::transform( begin, end, old_children.begin(), []( auto c ) { return c.index; } );
+          *it = new_signal;
 
           // increment fan-out of new node
-          _storage->nodes[new_signal].data[0].h1++;
+          _ref( new_signal ).h1++;
 
           for ( auto const& fn : _events->on_modified )
           {
@@ -443,12 +647,12 @@ signal create_maj( signal a, signal b, signal c )
         output = new_signal;
 
         // increment fan-out of new node
-        _storage->nodes[new_signal].data[0].h1++;
+        _ref( new_signal ).h1++;
       }
     }
 
     // reset fan-out of old node
-    _storage->nodes[old_node].data[0].h1 = 0;
+    _ref( old_node ).h1 = 0;
   }
 #pragma endregion
 
@@ -496,12 +700,16 @@ signal create_maj( signal a, signal b, signal c )
 
   uint32_t fanin_size( node const& n ) const
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    return _storage->nodes[n].num_fanins;
+#else
     return static_cast<uint32_t>( _storage->nodes[n].children.size() );
+#endif
   }
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1;
+    return _ref( n ).h1;
   }
 
   bool is_function( node const& n ) const
@@ -513,7 +721,20 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Functional properties
   kitty::dynamic_truth_table node_function( const node& n ) const
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    auto const& nobj = _storage->nodes[n];
+    if ( nobj.num_vars <= 6u )
+    {
+      const auto word = _storage->small_functions[nobj.function];
+      kitty::dynamic_truth_table tt( nobj.num_vars );
+      kitty::create_from_words( tt, &word, &word + 1 );
+      tt.mask_bits();
+      return tt;
+    }
+    return _storage->data.cache[nobj.function];
+#else
     return _storage->data.cache[_storage->nodes[n].data[1].h1];
+#endif
   }
 #pragma endregion
 
@@ -582,8 +803,8 @@ signal create_maj( signal a, signal b, signal c )
 
   uint32_t ci_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data );
+    assert( _fanin_begin( n )[0].data == _fanin_begin( n )[1].data );
+    return static_cast<uint32_t>( _fanin_begin( n )[0].data );
   }
 
   uint32_t co_index( signal const& s ) const
@@ -602,8 +823,8 @@ signal create_maj( signal a, signal b, signal c )
 
   uint32_t pi_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data );
+    assert( _fanin_begin( n )[0].data == _fanin_begin( n )[1].data );
+    return static_cast<uint32_t>( _fanin_begin( n )[0].data );
   }
 
   uint32_t po_index( signal const& s ) const
@@ -622,8 +843,8 @@ signal create_maj( signal a, signal b, signal c )
 
   uint32_t ro_index( node const& n ) const
   {
-    assert( _storage->nodes[n].children[0].data == _storage->nodes[n].children[1].data );
-    return static_cast<uint32_t>( _storage->nodes[n].children[0].data - _storage->data.num_pis );
+    assert( _fanin_begin( n )[0].data == _fanin_begin( n )[1].data );
+    return static_cast<uint32_t>( _fanin_begin( n )[0].data - _storage->data.num_pis );
   }
 
   uint32_t ri_index( signal const& s ) const
@@ -642,7 +863,7 @@ signal create_maj( signal a, signal b, signal c )
 
   signal ro_to_ri( signal const& s ) const
   {
-    return ( _storage->outputs.begin() + _storage->data.num_pos + _storage->nodes[s].children[0].data - _storage->data.num_pis )->index;
+    return ( _storage->outputs.begin() + _storage->data.num_pos + _fanin_begin( s )[0].data - _storage->data.num_pis )->index;
   }
 
   node ri_to_ro( signal const& s ) const
@@ -758,8 +979,8 @@ signal create_maj( signal a, signal b, signal c )
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
-    detail::foreach_element_transform<IteratorType, uint32_t>( _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
+    auto begin = _fanin_begin( n );
+    detail::foreach_element_transform<decltype( begin ), uint32_t>( begin, begin + fanin_size( n ), []( auto f ) { return f.index; }, fn );
   }
 #pragma endregion
 
@@ -774,14 +995,14 @@ signal create_maj( signal a, signal b, signal c )
       index <<= 1;
       index ^= *begin++ ? 1 : 0;
     }
-    return kitty::get_bit( _storage->data.cache[_storage->nodes[n].data[1].h1], index );
+    return kitty::get_bit( node_function( n ), index );
   }
 
   template<typename Iterator>
   iterates_over_truth_table_t<Iterator>
   compute( node const& n, Iterator begin, Iterator end ) const
   {
-    const auto nfanin = _storage->nodes[n].children.size();
+    const auto nfanin = fanin_size( n );
     std::vector<typename Iterator::value_type> tts( begin, end );
 
     assert( nfanin != 0 );
@@ -789,7 +1010,7 @@ signal create_maj( signal a, signal b, signal c )
 
     /* resulting truth table has the same size as any of the children */
     auto result = tts.front().construct();
-    const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
+    const auto gate_tt = node_function( n );
 
     for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
     {
@@ -811,44 +1032,60 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Custom node values
   void clear_values() const
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data.h2 = 0; } );
+#else
     std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+#endif
   }
 
   uint32_t value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return _ref( n ).h2;
   }
 
   void set_value( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[0].h2 = v;
+    _ref( n ).h2 = v;
   }
 
   uint32_t incr_value( node const& n ) const
   {
-    return static_cast<uint32_t>( _storage->nodes[n].data[0].h2++ );
+    return static_cast<uint32_t>( _ref( n ).h2++ );
   }
 
   uint32_t decr_value( node const& n ) const
   {
-    return static_cast<uint32_t>( --_storage->nodes[n].data[0].h2 );
+    return static_cast<uint32_t>( --_ref( n ).h2 );
   }
 #pragma endregion
 
 #pragma region Visited flags
   void clear_visited() const
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    std::fill( _storage->visited.begin(), _storage->visited.end(), 0u );
+#else
     std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h2 = 0; } );
+#endif
   }
 
-  auto visited( node const& n ) const
+  uint32_t visited( node const& n ) const
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    return _storage->visited[n];
+#else
     return _storage->nodes[n].data[1].h2;
+#endif
   }
 
   void set_visited( node const& n, uint32_t v ) const
   {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    _storage->visited[n] = v;
+#else
     _storage->nodes[n].data[1].h2 = v;
+#endif
   }
 
   uint32_t trav_id() const
@@ -869,6 +1106,82 @@ signal create_maj( signal a, signal b, signal c )
   }
 #pragma endregion
 
+#pragma region Storage access
+  /*! \brief Fan-out size (`h1`) and value (`h2`) of a node */
+  cauint64_t& _ref( node const& n ) const
+  {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    return _storage->nodes[n].data;
+#else
+    return _storage->nodes[n].data[0];
+#endif
+  }
+
+  /*! \brief Pointer to the first fanin of a node */
+  storage::element_type::node_type::pointer_type* _fanin_begin( node const& n ) const
+  {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    auto& nobj = _storage->nodes[n];
+    return nobj.num_fanins > compact_klut_node::max_inline_fanins ? _storage->fanin_arena.data() + nobj.fanins[0].data : nobj.fanins.data();
+#else
+    return _storage->nodes[n].children.data();
+#endif
+  }
+
+  void _set_function_literal( node const& n, uint32_t literal ) const
+  {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    _storage->nodes[n].function = literal;
+#else
+    _storage->nodes[n].data[1].h1 = literal;
+#endif
+  }
+
+  /*! \brief Appends a node without structural hashing */
+  void _emplace_node( std::vector<signal> const& children, uint32_t literal, uint32_t num_vars )
+  {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    auto& nobj = _storage->nodes.emplace_back();
+    _storage->visited.emplace_back();
+    nobj.num_fanins = static_cast<uint16_t>( children.size() );
+    nobj.num_vars = static_cast<uint16_t>( num_vars );
+    nobj.function = literal;
+
+    auto* fanins = nobj.fanins.data();
+    if ( children.size() > compact_klut_node::max_inline_fanins )
+    {
+      nobj.fanins[0] = _storage->fanin_arena.size();
+      _storage->fanin_arena.resize( _storage->fanin_arena.size() + children.size() );
+      fanins = _storage->fanin_arena.data() + nobj.fanins[0].data;
+    }
+    std::copy( children.begin(), children.end(), fanins );
+#else
+    (void)num_vars;
+    auto& nobj = _storage->nodes.emplace_back();
+    std::copy( children.begin(), children.end(), std::back_inserter( nobj.children ) );
+    nobj.data[1].h1 = literal;
+#endif
+  }
+
+  /*! \brief Inserts a function into the truth table cache and returns its literal */
+  uint32_t _insert_function( kitty::dynamic_truth_table const& function ) const
+  {
+#if defined( MOCKTURTLE_COMPACT_KLUT )
+    if ( function.num_vars() <= 6u )
+    {
+      /* replicate functions with fewer variables to the whole word */
+      auto word = *function.cbegin();
+      for ( auto i = function.num_vars(); i < 6u; ++i )
+      {
+        word |= word << ( 1u << i );
+      }
+      return _storage->small_functions.insert( word );
+    }
+#endif
+    return _storage->data.cache.insert( function );
+  }
+#pragma endregion
+
 public:
   std::shared_ptr<klut_storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -42,6 +43,7 @@
 
 #include "../traits.hpp"
 #include "../utils/algorithm.hpp"
+#include "detail/compact.hpp"
 #include "detail/foreach.hpp"
 #include "events.hpp"
 #include "storage.hpp"
@@ -188,6 +190,7 @@ public:
     (void)name;
 
     /* increase ref-count to children */
+    _journal_node( f.index );
     _storage->nodes[f.index].data[0].h1++;
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
@@ -211,6 +214,7 @@ public:
     (void)name;
 
     /* increase ref-count to children */
+    _journal_node( f.index );
     _storage->nodes[f.index].data[0].h1++;
     auto const ri_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
@@ -336,10 +340,20 @@ public:
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
+    _journal_node( a.index );
     _storage->nodes[a.index].data[0].h1++;
+    _journal_node( b.index );
     _storage->nodes[b.index].data[0].h1++;
+    _journal_node( c.index );
     _storage->nodes[c.index].data[0].h1++;
 
+    if ( _storage->fanout.enabled() )
+    {
+      _storage->fanout.add( a.index, index );
+      _storage->fanout.add( b.index, index );
+      _storage->fanout.add( c.index, index );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       fn( index );
@@ -508,6 +522,8 @@ public:
     const auto old_child1 = signal{node.children[1]};
     const auto old_child2 = signal{node.children[2]};
 
+    _journal_node( n );
+
     // erase old node in hash table
     _storage->hash.erase( node );
 
@@ -518,8 +534,15 @@ public:
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
+    _journal_node( new_signal.index );
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    if ( _storage->fanout.enabled() )
+    {
+      _storage->fanout.remove( old_node, n );
+      _storage->fanout.add( new_signal.index, n );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       fn( n, {old_child0, old_child1, old_child2} );
@@ -534,10 +557,12 @@ public:
     {
       if ( output.index == old_node )
       {
+        _journal_output( static_cast<uint64_t>( &output - _storage->outputs.data() ) );
         output.index = new_signal.index;
         output.weight ^= new_signal.complement;
 
         // increment fan-in of new node
+        _journal_node( new_signal.index );
         _storage->nodes[new_signal.index].data[0].h1++;
       }
     }
@@ -549,6 +574,7 @@ public:
     if ( n == 0 || is_ci( n ) )
       return;
 
+    _journal_node( n );
     auto& nobj = _storage->nodes[n];
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
@@ -560,6 +586,7 @@ public:
 
     for ( auto i = 0u; i < 3u; ++i )
     {
+      _storage->fanout.remove( nobj.children[i].index, n );
       if ( fanout_size( nobj.children[i].index ) == 0 )
       {
         continue;
@@ -586,16 +613,12 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
-      {
-        if ( is_ci( idx ) )
-          continue; /* ignore CIs */
-
+      foreach_substitution_candidate( _old, [&]( auto const& idx ) {
         if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
         {
           to_substitute.push( *repl );
         }
-      }
+      } );
 
       /* check outputs */
       replace_in_outputs( _old, _new );
@@ -614,14 +637,23 @@ public:
       {
         if ( child.index == old_node )
         {
+          _journal_node( p );
           child.index = new_signal.index;
           child.weight ^= new_signal.complement;
 
           // increment fan-in of new node
+          _journal_node( new_signal.index );
           _storage->nodes[new_signal.index].data[0].h1++;
 
           // decrement fan-in of old node
+          _journal_node( old_node );
           _storage->nodes[old_node].data[0].h1--;
+
+          if ( _storage->fanout.enabled() )
+          {
+            _storage->fanout.remove( old_node, p );
+            _storage->fanout.add( new_signal.index, p );
+          }
         }
       }
     }
@@ -631,19 +663,208 @@ public:
     {
       if ( output.index == old_node )
       {
+        _journal_output( static_cast<uint64_t>( &output - _storage->outputs.data() ) );
         output.index = new_signal.index;
         output.weight ^= new_signal.complement;
 
         // increment fan-in of new node
+        _journal_node( new_signal.index );
         _storage->nodes[new_signal.index].data[0].h1++;
 
         // decrement fan-in of old node
+        _journal_node( old_node );
         _storage->nodes[old_node].data[0].h1--;
       }
     }
   }
 #pragma endregion
 
+#pragma region Checkpoints
+  /*! \brief Creates a checkpoint to which the network can be rolled back.
+   *
+   * Afterwards, the network journals the original state of every node
+   * and output before changing it.  `rollback` undoes all structural
+   * changes since the checkpoint (created nodes, modified fanins, fan-out
+   * counters, deleted nodes, and outputs) in time proportional to the
+   * number of changed nodes, whereas `release_checkpoint` keeps them.
+   * Application-specific values and visited flags are not journaled, and
+   * views that maintain data through network events need to be updated
+   * after a rollback.
+   */
+  void checkpoint()
+  {
+    assert( !has_checkpoint() && "network already has a checkpoint" );
+    _storage->journal.begin( *_storage );
+  }
+
+  bool has_checkpoint() const
+  {
+    return _storage->journal.active;
+  }
+
+  /*! \brief Keeps all changes since the checkpoint and stops journaling. */
+  void release_checkpoint()
+  {
+    _storage->journal.clear();
+  }
+
+  /*! \brief Undoes all changes since the checkpoint and stops journaling. */
+  void rollback()
+  {
+    assert( has_checkpoint() && "network has no checkpoint" );
+    auto& journal = _storage->journal;
+
+    /* remove hash table and fanout index entries of changed nodes */
+    const auto unlink = [&]( node const& n ) {
+      if ( n == 0 || is_ci( n ) )
+      {
+        return;
+      }
+      if ( const auto it = _storage->hash.find( _storage->nodes[n] ); it != _storage->hash.end() && it->second == n )
+      {
+        _storage->hash.erase( it );
+      }
+      if ( _storage->fanout.enabled() )
+      {
+        for ( auto const& c : _storage->nodes[n].children )
+        {
+          _storage->fanout.remove( c.index, n );
+        }
+      }
+    };
+    for ( auto n = journal.num_nodes; n < _storage->nodes.size(); ++n )
+    {
+      unlink( n );
+    }
+    for ( auto const& [n, record] : journal.nodes )
+    {
+      unlink( n );
+    }
+
+    /* restore original nodes and outputs */
+    for ( auto const& [n, record] : journal.nodes )
+    {
+      _storage->nodes[n] = record;
+    }
+    journal.restore( *_storage );
+
+    for ( auto const& [n, record] : journal.nodes )
+    {
+      if ( n == 0 || is_ci( n ) || is_dead( n ) )
+      {
+        continue;
+      }
+      _storage->hash.emplace( _storage->nodes[n], n );
+      if ( _storage->fanout.enabled() )
+      {
+        for ( auto const& c : _storage->nodes[n].children )
+        {
+          _storage->fanout.add( c.index, n );
+        }
+      }
+    }
+
+    journal.clear();
+  }
+#pragma endregion
+
+#pragma region Compaction
+  /*! \brief Removes dead nodes from the storage.
+   *
+   * Renumbers the remaining nodes in topological order (constant, CIs,
+   * then gates) and rebuilds the structural hash table as well as the
+   * fanout index, if it has been built.  Returns a map from old to new
+   * node indexes, in which dead nodes are mapped to
+   * `std::numeric_limits<node>::max()`.  Node indexes kept outside of
+   * the network, e.g., in node maps or views, must be updated with it.
+   */
+  std::vector<node> compact()
+  {
+    assert( !has_checkpoint() && "cannot compact while the network has a checkpoint" );
+
+    auto const old_to_new = detail::compaction_map( *_storage, [this]( auto const& n ) { return is_dead( n ); } );
+    auto const size = static_cast<uint64_t>( std::count_if( old_to_new.begin(), old_to_new.end(), []( auto const& i ) { return i != detail::compact_removed; } ) );
+
+    detail::apply_compaction_map( *_storage, old_to_new, size, [&]( auto& nobj, auto const& n ) {
+      if ( n != 0 && !is_ci( n ) )
+      {
+        detail::remap_children( nobj, old_to_new );
+      }
+    } );
+
+    _storage->hash.clear();
+    _storage->hash.reserve( size );
+    foreach_gate( [&]( auto const& n ) {
+      _storage->hash[_storage->nodes[n]] = n;
+    } );
+
+    if ( has_fanout_index() )
+    {
+      build_fanout_index();
+    }
+
+    return old_to_new;
+  }
+#pragma endregion
+
+#pragma region Fanout index
+  /*! \brief Builds the fanout index of the network.
+   *
+   * Once built, the index is maintained by the network and restricts
+   * `substitute_node` to the actual fanouts of the substituted node
+   * instead of scanning all nodes.
+   */
+  void build_fanout_index()
+  {
+    _storage->fanout.clear();
+    _storage->fanout.fanouts.resize( _storage->nodes.size() );
+    foreach_gate( [&]( auto const& n ) {
+      foreach_fanin( n, [&]( auto const& f ) {
+        _storage->fanout.add( f.index, n );
+      } );
+    } );
+  }
+
+  bool has_fanout_index() const
+  {
+    return _storage->fanout.enabled();
+  }
+
+  void clear_fanout_index()
+  {
+    _storage->fanout.clear();
+  }
+
+  /*! \brief Calls `fn` on every gate that may have `n` as fanin.
+   *
+   * Gates are visited in increasing index order.  Without a fanout
+   * index, all gates are candidates.
+   */
+  template<typename Fn>
+  void foreach_substitution_candidate( node const& n, Fn&& fn )
+  {
+    if ( _storage->fanout.enabled() )
+    {
+      /* copy, since substitution modifies the fanout index */
+      auto parents = _storage->fanout.at( n );
+      std::sort( parents.begin(), parents.end() );
+      for ( auto const& p : parents )
+      {
+        fn( p );
+      }
+      return;
+    }
+
+    for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+    {
+      if ( is_ci( idx ) )
+        continue; /* ignore CIs */
+
+      fn( idx );
+    }
+  }
+#pragma endregion
+
 #pragma region Structural properties
   auto size() const
   {
@@ -700,11 +921,13 @@ public:
 
   uint32_t incr_fanout_size( node const& n ) const
   {
+    _journal_node( n );
     return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
+    _journal_node( n );
     return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
   }
 
@@ -1189,6 +1412,23 @@ public:
   }
 #pragma endregion
 
+private:
+  void _journal_node( node const& n ) const
+  {
+    if ( _storage->journal.record_node( n ) )
+    {
+      _storage->journal.nodes.emplace_back( n, _storage->nodes[n] );
+    }
+  }
+
+  void _journal_output( uint64_t index ) const
+  {
+    if ( _storage->journal.record_output( index ) )
+    {
+      _storage->journal.outputs.emplace_back( index, _storage->outputs[index] );
+    }
+  }
+
 public:
   std::shared_ptr<mig_storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
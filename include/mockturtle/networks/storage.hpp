@@ -33,9 +33,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <iostream>
+#include <iterator>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
@@ -86,6 +89,54 @@ public:
   }
 };
 
+/*! \brief 32-bit node pointer
+ *
+ * Compact variant of `node_pointer` for storages with less than
+ * 2^(32 - PointerFieldSize) nodes.
+ */
+template<int PointerFieldSize = 0>
+struct compact_node_pointer
+{
+private:
+  static constexpr auto _len = sizeof( uint32_t ) * 8;
+
+public:
+  compact_node_pointer() = default;
+  compact_node_pointer( uint64_t index, uint64_t weight ) : weight( static_cast<uint32_t>( weight ) ), index( static_cast<uint32_t>( index ) ) {}
+
+  union {
+    struct
+    {
+      uint32_t weight : PointerFieldSize;
+      uint32_t index : _len - PointerFieldSize;
+    };
+    uint32_t data;
+  };
+
+  bool operator==( compact_node_pointer<PointerFieldSize> const& other ) const
+  {
+    return data == other.data;
+  }
+};
+
+template<>
+struct compact_node_pointer<0>
+{
+public:
+  compact_node_pointer<0>() = default;
+  compact_node_pointer<0>( uint64_t index ) : index( static_cast<uint32_t>( index ) ) {}
+
+  union {
+    uint32_t index;
+    uint32_t data;
+  };
+
+  bool operator==( compact_node_pointer<0> const& other ) const
+  {
+    return data == other.data;
+  }
+};
+
 union cauint64_t {
   uint64_t n{0};
   struct
@@ -187,6 +238,148 @@ struct empty_storage_data
 {
 };
 
+/*! \brief Optional fanout index
+ *
+ * Stores for each node the indexes of all live nodes that have it as a
+ * fanin.  The index is empty (and does not allocate any memory) until a
+ * network explicitly builds it; afterwards the network keeps it
+ * up-to-date when nodes are created, modified, or taken out.
+ */
+struct fanout_index
+{
+  bool enabled() const
+  {
+    return !fanouts.empty();
+  }
+
+  void add( uint64_t n, uint64_t fanout )
+  {
+    if ( n >= fanouts.size() )
+    {
+      fanouts.resize( n + 1 );
+    }
+    fanouts[n].push_back( fanout );
+  }
+
+  void remove( uint64_t n, uint64_t fanout )
+  {
+    if ( n >= fanouts.size() )
+    {
+      return;
+    }
+
+    auto& fs = fanouts[n];
+    if ( const auto it = std::find( fs.begin(), fs.end(), fanout ); it != fs.end() )
+    {
+      *it = fs.back();
+      fs.pop_back();
+    }
+  }
+
+  std::vector<uint64_t> const& at( uint64_t n ) const
+  {
+    static const std::vector<uint64_t> empty;
+    return n < fanouts.size() ? fanouts[n] : empty;
+  }
+
+  void clear()
+  {
+    std::vector<std::vector<uint64_t>>().swap( fanouts );
+  }
+
+  std::vector<std::vector<uint64_t>> fanouts;
+};
+
+/*! \brief Journal of changes since a checkpoint
+ *
+ * While a checkpoint is active, a network records the original state of
+ * each node (`Record`) and output (`Pointer`) before it modifies it for
+ * the first time.  Nodes and outputs created after the checkpoint are not
+ * recorded; rolling back truncates the arrays to their sizes at the time
+ * of the checkpoint.
+ */
+template<typename Record, typename Pointer>
+struct storage_journal
+{
+  template<typename Storage>
+  void begin( Storage const& storage )
+  {
+    clear();
+    active = true;
+    num_nodes = storage.nodes.size();
+    num_inputs = storage.inputs.size();
+    num_outputs = storage.outputs.size();
+    num_latches = storage.data.latches.size();
+    num_pis = storage.data.num_pis;
+    num_pos = storage.data.num_pos;
+  }
+
+  /*! \brief Returns true, if node `n` needs to be recorded before modifying it */
+  bool record_node( uint64_t n )
+  {
+    return active && n < num_nodes && logged_nodes.insert( n ).second;
+  }
+
+  /*! \brief Returns true, if output `index` needs to be recorded before modifying it */
+  bool record_output( uint64_t index )
+  {
+    return active && index < num_outputs && logged_outputs.insert( index ).second;
+  }
+
+  /*! \brief Restores the outputs and truncates all arrays
+   *
+   * Recorded nodes need to be restored by the network, since it also
+   * needs to update its hash table.
+   */
+  template<typename Storage>
+  void restore( Storage& storage ) const
+  {
+    for ( auto const& [index, output] : outputs )
+    {
+      storage.outputs[index] = output;
+    }
+
+    storage.nodes.resize( num_nodes );
+    storage.inputs.resize( num_inputs );
+    storage.outputs.resize( num_outputs );
+    storage.data.latches.resize( num_latches );
+    storage.data.num_pis = num_pis;
+    storage.data.num_pos = num_pos;
+
+    for ( auto it = storage.latch_information.begin(); it != storage.latch_information.end(); )
+    {
+      it = it->first >= num_nodes ? storage.latch_information.erase( it ) : std::next( it );
+    }
+
+    if ( storage.fanout.fanouts.size() > num_nodes )
+    {
+      storage.fanout.fanouts.resize( num_nodes );
+    }
+  }
+
+  void clear()
+  {
+    active = false;
+    nodes.clear();
+    outputs.clear();
+    logged_nodes.clear();
+    logged_outputs.clear();
+  }
+
+  bool active{false};
+  uint64_t num_nodes{0u};
+  uint64_t num_inputs{0u};
+  uint64_t num_outputs{0u};
+  uint64_t num_latches{0u};
+  uint32_t num_pis{0u};
+  uint32_t num_pos{0u};
+
+  std::vector<std::pair<uint64_t, Record>> nodes;
+  std::vector<std::pair<uint64_t, Pointer>> outputs;
+  phmap::flat_hash_set<uint64_t> logged_nodes;
+  phmap::flat_hash_set<uint64_t> logged_outputs;
+};
+
 template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
 struct storage
 {
@@ -208,6 +401,10 @@ struct storage
 
   phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
 
+  fanout_index fanout;
+
+  storage_journal<node_type, typename node_type::pointer_type> journal;
+
   T data;
 };
 
@@ -0,0 +1,389 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file chain_store.hpp
+  \brief Persistent store for exact synthesis results
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+
+#include "include/percy.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Persistent store for exact synthesis results.
+ *
+ * The store maps NPN representatives to Boolean chains and keeps them in an
+ * append-only binary file, so that results accumulate across runs.  Entries
+ * are grouped by a *kind*, a short string that identifies the synthesis
+ * problem (e.g., gate basis and number of candidates), because chains of
+ * different kinds are not interchangeable.
+ *
+ * Each entry is written as one self-contained record with a checksum using a
+ * single append operation.  Several processes may therefore read and append
+ * to the same file; incomplete or corrupted records are skipped when reading,
+ * and `refresh` picks up records appended by other processes.  Numbers are
+ * stored in little-endian byte order so that files can be shared between
+ * machines.  Within a process, the store can be shared between threads.
+ *
+ * Functions with up to 6 variables are NPN canonized with
+ * `kitty::exact_npn_canonization` (see `canonization`); larger functions are
+ * stored as they are.  Functions with more than `max_num_vars` variables are
+ * not stored.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      exact_resynthesis_params ps;
+      ps.store = std::make_shared<chain_store>( "exact.chains" );
+      exact_aig_resynthesis<aig_network> resyn( false, ps );
+      aig = cut_rewriting( aig, resyn );
+   \endverbatim
+ */
+class chain_store
+{
+public:
+  using npn_config_t = std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>>;
+
+  /*! \brief Maximum number of variables of stored functions. */
+  static constexpr uint32_t max_num_vars = 16u;
+
+  /*! \brief Opens the store and reads all records from `filename`.
+   *
+   * The file is created when the first entry is inserted.
+   */
+  explicit chain_store( std::string const& filename )
+      : _filename( filename )
+  {
+    refresh();
+  }
+
+  /*! \brief Returns the NPN configuration under which functions are stored.
+   *
+   * The result has the same format as `kitty::exact_npn_canonization`: the
+   * representative, input and output negations (output in bit `n`), and
+   * the input permutation.  Input `i` of the representative is input
+   * `perm[i]` of the function, complemented if bit `perm[i]` of the phase is
+   * set.
+   */
+  static npn_config_t canonization( kitty::dynamic_truth_table const& function )
+  {
+    if ( function.num_vars() <= 6u )
+    {
+      return kitty::exact_npn_canonization( function );
+    }
+
+    std::vector<uint8_t> perm( function.num_vars() );
+    for ( auto i = 0u; i < perm.size(); ++i )
+    {
+      perm[i] = static_cast<uint8_t>( i );
+    }
+    return {function, 0u, perm};
+  }
+
+  /*! \brief Returns the chains stored for a representative, if any. */
+  std::optional<std::vector<percy::chain>> find( std::string const& kind, kitty::dynamic_truth_table const& repr ) const
+  {
+    std::shared_lock lock( _mutex );
+    if ( const auto it = _entries.find( make_key( kind, repr ) ); it != _entries.end() )
+    {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Stores chains for a representative and appends them to the file.
+   *
+   * Does nothing if the store already contains an entry for `repr`.  Returns
+   * false if the entry could not be written to the file (or `repr` has more
+   * than `max_num_vars` variables); the entry is then not added to the store.
+   */
+  bool insert( std::string const& kind, kitty::dynamic_truth_table const& repr, std::vector<percy::chain> const& chains )
+  {
+    if ( repr.num_vars() > max_num_vars )
+    {
+      return false;
+    }
+
+    auto key = make_key( kind, repr );
+
+    std::unique_lock lock( _mutex );
+    if ( _entries.count( key ) )
+    {
+      return true;
+    }
+
+    const auto record = encode_record( key, chains );
+    std::ofstream os( _filename, std::ios::binary | std::ios::app );
+    os.write( record.data(), record.size() );
+    os.flush();
+    if ( !os.good() )
+    {
+      return false;
+    }
+
+    _entries.emplace( std::move( key ), chains );
+    return true;
+  }
+
+  /*! \brief Reads records that were appended to the file since the last call. */
+  void refresh()
+  {
+    std::unique_lock lock( _mutex );
+
+    std::ifstream is( _filename, std::ios::binary );
+    if ( !is )
+    {
+      return;
+    }
+    is.seekg( 0, std::ios::end );
+    const auto file_size = static_cast<uint64_t>( is.tellg() );
+    if ( file_size <= _offset )
+    {
+      return;
+    }
+    std::string data( file_size - _offset, '\0' );
+    is.seekg( _offset );
+    is.read( data.data(), data.size() );
+    data.resize( is.gcount() );
+
+    uint64_t pos = 0u;
+    while ( pos + header_size <= data.size() )
+    {
+      if ( read_number<uint32_t>( data, pos ) != magic )
+      {
+        /* skip garbage up to the next record */
+        ++pos;
+        continue;
+      }
+      const auto length = read_number<uint32_t>( data, pos + 4u );
+      const auto checksum = read_number<uint32_t>( data, pos + 8u );
+      if ( pos + header_size + length > data.size() )
+      {
+        /* a record that is followed by another one has been torn, the last
+         * one may still be written */
+        if ( data.find( magic_bytes, pos + 1u ) != std::string::npos )
+        {
+          ++pos;
+          continue;
+        }
+        break;
+      }
+
+      std::string_view payload( data.data() + pos + header_size, length );
+      if ( fnv1a( payload ) != checksum || !decode_payload( payload ) )
+      {
+        ++pos;
+        continue;
+      }
+      pos += header_size + length;
+    }
+
+    _offset += pos;
+  }
+
+  /*! \brief Returns the number of stored entries. */
+  uint64_t size() const
+  {
+    std::shared_lock lock( _mutex );
+    return _entries.size();
+  }
+
+private:
+  static constexpr uint32_t magic = 0x5343544d;
+  static constexpr char const* magic_bytes = "MTCS";
+  static constexpr uint64_t header_size = 12u;
+
+  static std::string make_key( std::string const& kind, kitty::dynamic_truth_table const& repr )
+  {
+    std::string key;
+    write_number<uint8_t>( key, static_cast<uint8_t>( kind.size() ) );
+    key += kind;
+    write_number<uint8_t>( key, static_cast<uint8_t>( repr.num_vars() ) );
+    for ( auto it = repr.cbegin(); it != repr.cend(); ++it )
+    {
+      write_number<uint64_t>( key, *it );
+    }
+    return key;
+  }
+
+  static std::string encode_record( std::string const& key, std::vector<percy::chain> const& chains )
+  {
+    std::string payload = key;
+    write_number<uint8_t>( payload, static_cast<uint8_t>( chains.size() ) );
+    for ( auto const& c : chains )
+    {
+      write_number<uint8_t>( payload, static_cast<uint8_t>( c.get_nr_inputs() ) );
+      write_number<uint8_t>( payload, static_cast<uint8_t>( c.get_fanin() ) );
+      write_number<uint16_t>( payload, static_cast<uint16_t>( c.get_nr_steps() ) );
+      write_number<uint8_t>( payload, static_cast<uint8_t>( c.get_nr_outputs() ) );
+      for ( auto i = 0; i < c.get_nr_steps(); ++i )
+      {
+        for ( auto child : c.get_step( i ) )
+        {
+          write_number<uint16_t>( payload, static_cast<uint16_t>( child ) );
+        }
+        write_number<uint64_t>( payload, *c.get_operator( i ).cbegin() );
+      }
+      for ( auto output : c.get_outputs() )
+      {
+        write_number<uint32_t>( payload, static_cast<uint32_t>( output ) );
+      }
+    }
+
+    std::string record;
+    write_number<uint32_t>( record, magic );
+    write_number<uint32_t>( record, static_cast<uint32_t>( payload.size() ) );
+    write_number<uint32_t>( record, fnv1a( payload ) );
+    return record + payload;
+  }
+
+  /* adds the entry of a record payload unless it is already known; returns
+   * false if the payload is malformed */
+  bool decode_payload( std::string_view payload )
+  {
+    uint64_t pos = 0u;
+    const auto has = [&]( uint64_t bytes ) { return pos + bytes <= payload.size(); };
+
+    if ( !has( 1u ) )
+    {
+      return false;
+    }
+    pos += 1u + read_number<uint8_t>( payload, pos );
+    if ( !has( 1u ) )
+    {
+      return false;
+    }
+    const auto num_vars = read_number<uint8_t>( payload, pos );
+    if ( num_vars > max_num_vars )
+    {
+      return false;
+    }
+    pos += 1u + 8u * ( num_vars <= 6u ? 1u : ( 1u << ( num_vars - 6u ) ) );
+    if ( !has( 1u ) )
+    {
+      return false;
+    }
+    std::string key( payload.substr( 0u, pos ) );
+
+    const auto num_chains = read_number<uint8_t>( payload, pos++ );
+    std::vector<percy::chain> chains( num_chains );
+    for ( auto& c : chains )
+    {
+      if ( !has( 5u ) )
+      {
+        return false;
+      }
+      const auto nr_in = read_number<uint8_t>( payload, pos );
+      const auto fanin = read_number<uint8_t>( payload, pos + 1u );
+      const auto nr_steps = read_number<uint16_t>( payload, pos + 2u );
+      const auto nr_out = read_number<uint8_t>( payload, pos + 4u );
+      pos += 5u;
+      if ( fanin > 6u || !has( nr_steps * ( 2u * fanin + 8u ) + 4u * nr_out ) )
+      {
+        return false;
+      }
+
+      c.reset( nr_in, nr_out, nr_steps, fanin );
+      std::vector<int> step( fanin );
+      kitty::dynamic_truth_table op( fanin );
+      for ( auto i = 0; i < nr_steps; ++i )
+      {
+        for ( auto j = 0u; j < fanin; ++j, pos += 2u )
+        {
+          step[j] = read_number<uint16_t>( payload, pos );
+        }
+        *op.begin() = read_number<uint64_t>( payload, pos );
+        pos += 8u;
+        c.set_step( i, step, op );
+      }
+      for ( auto i = 0; i < nr_out; ++i, pos += 4u )
+      {
+        c.set_output( i, static_cast<int>( read_number<uint32_t>( payload, pos ) ) );
+      }
+    }
+
+    _entries.emplace( std::move( key ), std::move( chains ) );
+    return true;
+  }
+
+  template<typename T>
+  static void write_number( std::string& out, T value )
+  {
+    for ( auto i = 0u; i < sizeof( T ); ++i )
+    {
+      out.push_back( static_cast<char>( ( static_cast<uint64_t>( value ) >> ( 8u * i ) ) & 0xff ) );
+    }
+  }
+
+  template<typename T>
+  static T read_number( std::string_view in, uint64_t pos )
+  {
+    uint64_t value{0};
+    for ( auto i = 0u; i < sizeof( T ); ++i )
+    {
+      value |= static_cast<uint64_t>( static_cast<uint8_t>( in[pos + i] ) ) << ( 8u * i );
+    }
+    return static_cast<T>( value );
+  }
+
+  static uint32_t fnv1a( std::string_view data )
+  {
+    uint32_t hash = 2166136261u;
+    for ( auto c : data )
+    {
+      hash = ( hash ^ static_cast<uint8_t>( c ) ) * 16777619u;
+    }
+    return hash;
+  }
+
+private:
+  std::string _filename;
+  uint64_t _offset{0u};
+
+  mutable std::shared_mutex _mutex;
+  std::unordered_map<std::string, std::vector<percy::chain>> _entries;
+};
+
+} /* namespace mockturtle */
@@ -0,0 +1,232 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file names_storage.hpp
+  \brief Storage for interned names
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Storage for interned names.
+ *
+ * Each name is stored once and identified by an id.  The characters of all
+ * names are stored consecutively in one arena, and names are found with an
+ * open-addressing hash table that only stores ids.
+ *
+ * Names are hierarchical: a name consists of a prefix, which is the id of
+ * another name, and a local name.  The full name is the full name of the
+ * prefix, followed by a separator and the local name.  Names that are
+ * inserted as strings are split at each separator, such that common prefixes
+ * (e.g., module instance paths) are stored only once.  The id 0 is reserved
+ * for the root, i.e., the empty prefix, and never refers to a name.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      names_storage names;
+
+      auto a = names.insert( "top.u1.a" ); // interns "top", "top.u1", and "top.u1.a"
+      auto b = names.insert( "top.u1.b" ); // interns only "top.u1.b"
+
+      auto u1 = names.prefix( a );         // u1 == names.prefix( b )
+      auto n = names[b];                   // n is "top.u1.b"
+      auto l = names.local_name( b );      // l is "b"
+   \endverbatim
+ */
+class names_storage
+{
+public:
+  /*! \brief Id of the root, which is not a name. */
+  static constexpr uint32_t root = 0u;
+
+  /*! \brief Creates a storage and reserves memory.
+   *
+   * \param separator Separator between the components of hierarchical names
+   * \param capacity Number of names for which memory is reserved
+   */
+  explicit names_storage( char separator = '.', uint32_t capacity = 1000u ) : _separator( separator )
+  {
+    _entries.reserve( capacity + 1u );
+    _entries.push_back( {0u, 0u, root, 0u} );
+    resize_slots( capacity );
+  }
+
+  /*! \brief Interns a name and returns its id.
+   *
+   * The name is split at each separator, and each prefix is interned as well.
+   */
+  uint32_t insert( std::string_view name )
+  {
+    auto id = root;
+    for ( auto pos = name.find( _separator ); pos != std::string_view::npos; pos = name.find( _separator ) )
+    {
+      id = insert( id, name.substr( 0u, pos ) );
+      name.remove_prefix( pos + 1u );
+    }
+    return insert( id, name );
+  }
+
+  /*! \brief Interns a local name below a prefix and returns its id.
+   *
+   * The local name is not split at separators.
+   *
+   * \param prefix Id of the prefix, or `root`
+   * \param local_name Local name
+   */
+  uint32_t insert( uint32_t prefix, std::string_view local_name )
+  {
+    const auto h = hash( prefix, local_name );
+
+    auto slot = h & _slot_mask;
+    while ( _slots[slot] != 0u )
+    {
+      const auto& e = _entries[_slots[slot]];
+      if ( e.hash == h && e.prefix == prefix && this->local_name( _slots[slot] ) == local_name )
+      {
+        return _slots[slot];
+      }
+      slot = ( slot + 1u ) & _slot_mask;
+    }
+
+    const auto id = static_cast<uint32_t>( _entries.size() );
+    _entries.push_back( {_chars.size(), static_cast<uint32_t>( local_name.size() ), prefix, h} );
+    _chars.append( local_name );
+    _slots[slot] = id;
+    if ( 2u * _entries.size() > _slots.size() )
+    {
+      resize_slots( _entries.size() );
+    }
+    return id;
+  }
+
+  /*! \brief Returns the full name of an id. */
+  std::string operator[]( uint32_t id ) const
+  {
+    std::vector<uint32_t> path;
+    auto size = 0u;
+    for ( auto i = id; i != root; i = _entries[i].prefix )
+    {
+      path.push_back( i );
+      size += _entries[i].length + 1u;
+    }
+
+    std::string name;
+    name.reserve( size );
+    for ( auto it = path.rbegin(); it != path.rend(); ++it )
+    {
+      if ( it != path.rbegin() )
+      {
+        name += _separator;
+      }
+      name += local_name( *it );
+    }
+    return name;
+  }
+
+  /*! \brief Returns the local name of an id, i.e., its last component. */
+  std::string_view local_name( uint32_t id ) const
+  {
+    const auto& e = _entries[id];
+    return std::string_view( _chars.data() + e.offset, e.length );
+  }
+
+  /*! \brief Returns the id of the prefix of an id, or `root`. */
+  uint32_t prefix( uint32_t id ) const
+  {
+    return _entries[id].prefix;
+  }
+
+  /*! \brief Returns the separator between components of hierarchical names. */
+  char separator() const
+  {
+    return _separator;
+  }
+
+  /*! \brief Returns the number of interned names, including all prefixes. */
+  uint32_t size() const
+  {
+    return static_cast<uint32_t>( _entries.size() - 1u );
+  }
+
+private:
+  static uint32_t hash( uint32_t prefix, std::string_view local_name )
+  {
+    uint64_t h = std::hash<std::string_view>{}( local_name );
+    h = ( h ^ prefix ) * UINT64_C( 0x9e3779b97f4a7c15 );
+    return static_cast<uint32_t>( h >> 32 );
+  }
+
+  /* rehashes all names into at least `2 * num_entries` slots */
+  void resize_slots( uint64_t num_entries )
+  {
+    uint64_t num_slots = 16u;
+    while ( num_slots < 2u * num_entries )
+    {
+      num_slots <<= 1;
+    }
+
+    _slot_mask = num_slots - 1u;
+    _slots.assign( num_slots, 0u );
+    for ( auto i = 1u; i < _entries.size(); ++i )
+    {
+      auto slot = _entries[i].hash & _slot_mask;
+      while ( _slots[slot] != 0u )
+      {
+        slot = ( slot + 1u ) & _slot_mask;
+      }
+      _slots[slot] = i;
+    }
+  }
+
+private:
+  struct entry
+  {
+    uint64_t offset;
+    uint32_t length;
+    uint32_t prefix;
+    uint32_t hash;
+  };
+
+  char _separator;
+  std::string _chars;           /* local names of all entries, ordered by id */
+  std::vector<entry> _entries;  /* entry 0 is the root */
+  std::vector<uint32_t> _slots; /* entry id, or 0 for an empty slot */
+  uint64_t _slot_mask{};
+};
+
+} // namespace mockturtle
@@ -0,0 +1,243 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file npn4_table.hpp
+  \brief Precomputed NPN classification of all 4-input functions
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <kitty/detail/constants.hpp>
+#include <kitty/static_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Precomputed NPN classification of all 4-input functions.
+ *
+ * Stores for each of the 65,536 functions over 4 variables its NPN
+ * representative together with the transformation to obtain it.  The
+ * entries are identical to the result of `kitty::exact_npn_canonization`,
+ * but a lookup costs a single array access.
+ *
+ * The table is computed once per process on the first call to
+ * `instance()` by enumerating each NPN class from its representative,
+ * which takes a few milliseconds; afterwards it is read-only and can be
+ * shared by any number of threads.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      auto const& npn = npn4_table::instance();
+
+      kitty::static_truth_table<4> tt;
+      kitty::create_from_hex_string( tt, "cafe" );
+      const auto [repr, phase, perm] = npn.canonization( tt );
+   \endverbatim
+ */
+class npn4_table
+{
+public:
+  using config_t = std::tuple<kitty::static_truth_table<4u>, uint32_t, std::array<uint8_t, 4u>>;
+
+  /*! \brief Returns the process-wide table. */
+  static npn4_table const& instance()
+  {
+    static const npn4_table table;
+    return table;
+  }
+
+  /*! \brief Returns the NPN representative of a function. */
+  uint16_t representative( uint16_t func ) const
+  {
+    return _entries[func].repr;
+  }
+
+  /*! \brief Returns input and output negations (output is bit 4). */
+  uint32_t phase( uint16_t func ) const
+  {
+    return _entries[func].phase;
+  }
+
+  /*! \brief Returns the input permutation. */
+  std::array<uint8_t, 4u> permutation( uint16_t func ) const
+  {
+    const auto p = _entries[func].perm;
+    return {static_cast<uint8_t>( p & 3 ), static_cast<uint8_t>( p >> 2 & 3 ), static_cast<uint8_t>( p >> 4 & 3 ), static_cast<uint8_t>( p >> 6 & 3 )};
+  }
+
+  /*! \brief NPN canonization in the format of `kitty::exact_npn_canonization`. */
+  config_t canonization( kitty::static_truth_table<4u> const& tt ) const
+  {
+    const auto func = static_cast<uint16_t>( *tt.cbegin() );
+    kitty::static_truth_table<4u> repr;
+    repr._bits = representative( func );
+    return {repr, phase( func ), permutation( func )};
+  }
+
+  /*! \brief Returns the number of NPN classes (222). */
+  uint32_t num_classes() const
+  {
+    return _num_classes;
+  }
+
+private:
+  struct entry
+  {
+    uint16_t repr;
+    uint8_t phase;
+    uint8_t perm; /* two bits per input */
+  };
+
+  /* transformation after one step of the canonization sequence, as a map
+   * from minterms of the transformed function to minterms of the original
+   * one, together with the configuration reported for this step */
+  struct step
+  {
+    std::array<uint8_t, 16u> minterms;
+    uint8_t phase;
+    uint8_t perm;
+  };
+
+  npn4_table()
+  {
+    const auto steps = compute_steps();
+
+    std::vector<bool> assigned( 1u << 16u, false );
+    for ( auto r = 0u; r < ( 1u << 16u ); ++r )
+    {
+      if ( assigned[r] )
+      {
+        continue;
+      }
+
+      /* r is the smallest function in its class and hence its representative;
+       * visiting the steps in the order of `kitty::exact_npn_canonization`
+       * assigns each function the first configuration that reaches r */
+      ++_num_classes;
+      for ( auto const& s : steps )
+      {
+        uint32_t g = 0u;
+        for ( auto m = 0u; m < 16u; ++m )
+        {
+          g |= ( ( r >> m ) & 1u ) << s.minterms[m];
+        }
+
+        if ( !assigned[g] )
+        {
+          assigned[g] = true;
+          _entries[g] = {static_cast<uint16_t>( r ), s.phase, s.perm};
+        }
+        if ( !assigned[g ^ 0xffff] )
+        {
+          assigned[g ^ 0xffff] = true;
+          _entries[g ^ 0xffff] = {static_cast<uint16_t>( r ), static_cast<uint8_t>( s.phase | 16u ), s.perm};
+        }
+      }
+    }
+  }
+
+  /* replays the swap and flip sequence of `kitty::exact_npn_canonization` */
+  static std::vector<step> compute_steps()
+  {
+    auto const& swaps = kitty::detail::swaps[2u];
+    auto const& flips = kitty::detail::flips[2u];
+
+    std::vector<step> steps;
+    std::array<uint8_t, 16u> minterms;
+    for ( auto m = 0u; m < 16u; ++m )
+    {
+      minterms[m] = m;
+    }
+
+    const auto swap_adjacent = [&]( uint8_t var ) {
+      auto const copy = minterms;
+      for ( auto m = 0u; m < 16u; ++m )
+      {
+        const auto b = ( ( m >> var ) ^ ( m >> ( var + 1 ) ) ) & 1u;
+        minterms[m] = copy[m ^ ( b << var ) ^ ( b << ( var + 1 ) )];
+      }
+    };
+    const auto flip = [&]( uint8_t var ) {
+      auto const copy = minterms;
+      for ( auto m = 0u; m < 16u; ++m )
+      {
+        minterms[m] = copy[m ^ ( 1u << var )];
+      }
+    };
+    const auto add_step = [&]( int best_swap, int best_flip ) {
+      std::array<uint8_t, 4u> perm{0, 1, 2, 3};
+      for ( auto i = 0; i <= best_swap; ++i )
+      {
+        std::swap( perm[swaps[i]], perm[swaps[i] + 1] );
+      }
+      uint8_t phase{0};
+      for ( auto i = 0; i <= best_flip; ++i )
+      {
+        phase ^= 1 << flips[i];
+      }
+
+      step s;
+      s.minterms = minterms;
+      s.phase = phase;
+      s.perm = static_cast<uint8_t>( perm[0] | perm[1] << 2 | perm[2] << 4 | perm[3] << 6 );
+      steps.push_back( s );
+    };
+
+    add_step( -1, -1 );
+    for ( auto i = 0; i < static_cast<int>( swaps.size() ); ++i )
+    {
+      swap_adjacent( swaps[i] );
+      add_step( i, -1 );
+    }
+    for ( auto j = 0; j < static_cast<int>( flips.size() ); ++j )
+    {
+      swap_adjacent( 0 );
+      flip( flips[j] );
+      add_step( -1, j );
+      for ( auto i = 0; i < static_cast<int>( swaps.size() ); ++i )
+      {
+        swap_adjacent( swaps[i] );
+        add_step( i, j );
+      }
+    }
+
+    return steps;
+  }
+
+  std::array<entry, 1u << 16u> _entries;
+  uint32_t _num_classes{0u};
+};
+
+} /* namespace mockturtle */
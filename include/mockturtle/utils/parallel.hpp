@@ -0,0 +1,107 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2020  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parallel.hpp
+  \brief Helpers for multi-threaded algorithms
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Returns the number of threads to use for a `num_threads` parameter.
+ *
+ * A value of 0 requests all hardware threads.
+ */
+inline uint32_t resolve_num_threads( uint32_t num_threads )
+{
+  return num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads;
+}
+
+/*! \brief Reusable barrier for a fixed number of threads */
+class spin_barrier
+{
+public:
+  explicit spin_barrier( uint32_t num_threads ) : num_threads( num_threads ) {}
+
+  void wait()
+  {
+    const auto gen = generation.load( std::memory_order_acquire );
+    if ( waiting.fetch_add( 1u, std::memory_order_acq_rel ) + 1u == num_threads )
+    {
+      waiting.store( 0u, std::memory_order_relaxed );
+      generation.fetch_add( 1u, std::memory_order_acq_rel );
+      return;
+    }
+    while ( generation.load( std::memory_order_acquire ) == gen )
+    {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  uint32_t const num_threads;
+  std::atomic<uint32_t> waiting{0u};
+  std::atomic<uint32_t> generation{0u};
+};
+
+/*! \brief Calls `fn( t )` for `t = 0, ..., num_threads - 1` on separate threads.
+ *
+ * `fn( 0 )` runs on the calling thread.  Returns after all calls have
+ * finished.
+ */
+template<typename Fn>
+void run_on_threads( uint32_t num_threads, Fn&& fn )
+{
+  std::vector<std::thread> threads;
+  threads.reserve( num_threads > 0u ? num_threads - 1u : 0u );
+  for ( auto t = 1u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&fn, t]() { fn( t ); } );
+  }
+  fn( 0u );
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+}
+
+/*! \brief Returns the range of items `[begin, end)` of thread `t` when splitting `num_items` evenly. */
+inline std::pair<uint64_t, uint64_t> thread_range( uint64_t num_items, uint32_t t, uint32_t num_threads )
+{
+  const auto chunk = ( num_items + num_threads - 1u ) / num_threads;
+  return {std::min( num_items, t * chunk ), std::min( num_items, ( t + 1u ) * chunk )};
+}
+
+} // namespace mockturtle
@@ -32,10 +32,18 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#include <kitty/hash.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
@@ -57,6 +65,10 @@ namespace mockturtle
  * \f$2i\f$ points to the normal truth table at index \f$i\f$.  A negative
  * literal \f$2i + 1\f$ points to the same truth table but returns its
  * complement.
+ *
+ * The words of all truth tables are stored consecutively in one arena in the
+ * order of their indexes, and truth tables are found with an open-addressing
+ * hash table that only stores indexes.
  *
    \verbatim embed:rst
 
@@ -83,6 +95,15 @@ public:
   /*! \brief Creates a truth table cache and reserves memory. */
   truth_table_cache( uint32_t capacity = 1000u );
 
+  /*! \brief Copies the truth tables of another cache.
+   *
+   * The other cache must not be in concurrent insertion mode.
+   */
+  truth_table_cache( truth_table_cache const& other );
+  truth_table_cache( truth_table_cache&& other ) = default;
+  truth_table_cache& operator=( truth_table_cache const& other );
+  truth_table_cache& operator=( truth_table_cache&& other ) = default;
+
   /*! \brief Inserts a truth table and returns a literal.
    *
    * To save space, only normal functions are stored in the truth table cache.
@@ -101,28 +122,214 @@ public:
 
   /*! \brief Returns truth table for a given literal.
    *
-   * The funtion requires that `lit` is smaller than `size()`.
+   * The funtion requires that `lit` is smaller than `size()`.  It can be
+   * called from several threads while truth tables are inserted with
+   * `insert_concurrent`.
    */
   TT operator[]( uint32_t lit ) const;
 
   /*! \brief Returns number of normalized truth tables in the cache. */
-  auto size() const { return _data.size(); }
+  auto size() const
+  {
+    return _entries.size() + ( _concurrent ? _concurrent->size() : 0u );
+  }
+
+  /*! \brief Removes all truth tables from the cache. */
+  void clear();
+
+  /*! \brief Enables concurrent insertion of truth tables.
+   *
+   * Until `end_concurrent_insert` is called, truth tables must be inserted
+   * with `insert_concurrent`, which can be called from several threads at the
+   * same time.  Truth tables that are already in the cache are found without
+   * locking; new truth tables are hashed into one of several shards, each of
+   * which is protected by its own mutex and allocates the words of its truth
+   * tables in chunks whose addresses do not change.  Hence, `operator[]` can
+   * be called concurrently for all literals returned so far.
+   *
+   * Indexes of new truth tables are consecutive, but their order depends on
+   * the thread schedule.
+   */
+  void begin_concurrent_insert();
+
+  /*! \brief Inserts a truth table while concurrent insertion is enabled.
+   *
+   * This method is thread-safe and returns the same literal as `insert`
+   * would, if the truth tables had been inserted in the same order.
+   *
+   * \param tt Truth table to insert
+   * \return Literal of position in cache
+   */
+  uint32_t insert_concurrent( TT tt );
+
+  /*! \brief Disables concurrent insertion of truth tables.
+   *
+   * Moves the truth tables that were inserted concurrently into the word
+   * arena of the cache; their literals stay valid.
+   */
+  void end_concurrent_insert();
+
+private:
+  struct entry
+  {
+    uint64_t offset;
+    uint32_t num_vars;
+    uint32_t hash;
+  };
+
+  struct concurrent_state;
+
+  static constexpr uint32_t not_found = ~UINT32_C( 0 );
+
+  static TT create( uint32_t num_vars );
+  static uint32_t hash( TT const& tt );
+  uint32_t find( TT const& tt, uint32_t h, uint64_t& slot ) const;
+  void resize_slots( uint64_t num_entries );
 
 private:
-  std::unordered_map<TT, uint32_t, kitty::hash<TT>> _indexes;
-  std::vector<TT> _data;
+  std::vector<entry> _entries;
+  std::vector<uint64_t> _words;     /* words of all truth tables, ordered by index */
+  std::vector<uint32_t> _slots;     /* entry index + 1, or 0 for an empty slot */
+  uint64_t _slot_mask{};
+  std::unique_ptr<concurrent_state> _concurrent;
+};
+
+/* Truth tables that are inserted concurrently are stored as records, which
+ * point to the words of the truth table in one of the shards.  The records
+ * are kept in segments of increasing size, such that their addresses do not
+ * change when more records are added. */
+template<typename TT>
+struct truth_table_cache<TT>::concurrent_state
+{
+  static constexpr uint32_t shard_bits = 4u;
+  static constexpr uint32_t first_segment_bits = 10u;
+  static constexpr uint32_t num_segments = 32u - first_segment_bits;
+  static constexpr uint64_t chunk_words = UINT64_C( 1 ) << 14;
+
+  struct record
+  {
+    uint64_t const* words;
+    uint32_t num_words;
+    uint32_t num_vars;
+    uint32_t hash;
+  };
+
+  struct shard
+  {
+    std::mutex mutex;
+    std::vector<uint32_t> slots = std::vector<uint32_t>( 16u ); /* entry index + 1, or 0 for an empty slot */
+    uint64_t slot_mask{15u};
+    uint64_t num_entries{0u};
+
+    std::vector<std::unique_ptr<uint64_t[]>> chunks;
+    uint64_t* next_word{nullptr};
+    uint64_t remaining_words{0u};
+
+    uint64_t* allocate( uint64_t num_words )
+    {
+      if ( num_words > remaining_words )
+      {
+        const auto size = std::max( num_words, chunk_words );
+        chunks.emplace_back( new uint64_t[size] );
+        if ( size > chunk_words )
+        {
+          /* a large truth table gets a chunk of its own */
+          return chunks.back().get();
+        }
+        next_word = chunks.back().get();
+        remaining_words = size;
+      }
+      const auto words = next_word;
+      next_word += num_words;
+      remaining_words -= num_words;
+      return words;
+    }
+  };
+
+  explicit concurrent_state( uint32_t first_index ) : first_index( first_index ), next_index( first_index ) {}
+
+  uint32_t size() const
+  {
+    return next_index.load() - first_index;
+  }
+
+  /* returns segment and position for the i-th concurrently inserted record */
+  static std::pair<uint32_t, uint64_t> locate( uint64_t i )
+  {
+    const auto x = ( i >> first_segment_bits ) + 1u;
+    uint32_t k = 0u;
+    while ( ( x >> ( k + 1u ) ) != 0u )
+    {
+      ++k;
+    }
+    return {k, i - ( ( ( UINT64_C( 1 ) << k ) - 1u ) << first_segment_bits )};
+  }
+
+  record const& at( uint32_t index ) const
+  {
+    const auto [k, pos] = locate( index - first_index );
+    return segments[k].load( std::memory_order_acquire )[pos];
+  }
+
+  record& allocate_record( uint32_t index )
+  {
+    const auto [k, pos] = locate( index - first_index );
+    auto* segment = segments[k].load( std::memory_order_acquire );
+    if ( segment == nullptr )
+    {
+      std::lock_guard<std::mutex> lock( segment_mutex );
+      segment = segments[k].load( std::memory_order_relaxed );
+      if ( segment == nullptr )
+      {
+        storage[k].reset( new record[UINT64_C( 1 ) << ( first_segment_bits + k )] );
+        segment = storage[k].get();
+        segments[k].store( segment, std::memory_order_release );
+      }
+    }
+    return segment[pos];
+  }
+
+  uint32_t first_index;
+  std::atomic<uint32_t> next_index;
+  std::array<std::atomic<record*>, num_segments> segments{};
+  std::array<std::unique_ptr<record[]>, num_segments> storage;
+  std::mutex segment_mutex;
+  std::array<shard, 1u << shard_bits> shards;
 };
 
 template<typename TT>
 truth_table_cache<TT>::truth_table_cache( uint32_t capacity )
 {
-  _indexes.reserve( capacity );
-  _data.reserve( capacity );
+  _entries.reserve( capacity );
+  resize_slots( capacity );
+}
+
+template<typename TT>
+truth_table_cache<TT>::truth_table_cache( truth_table_cache const& other )
+    : _entries( other._entries ),
+      _words( other._words ),
+      _slots( other._slots ),
+      _slot_mask( other._slot_mask )
+{
+  assert( !other._concurrent );
+}
+
+template<typename TT>
+truth_table_cache<TT>& truth_table_cache<TT>::operator=( truth_table_cache const& other )
+{
+  assert( !_concurrent && !other._concurrent );
+  _entries = other._entries;
+  _words = other._words;
+  _slots = other._slots;
+  _slot_mask = other._slot_mask;
+  return *this;
 }
 
 template<typename TT>
 uint32_t truth_table_cache<TT>::insert( TT tt )
 {
+  assert( !_concurrent && "call insert_concurrent while concurrent insertion is enabled" );
+
   uint32_t is_compl{0};
 
   if ( kitty::get_bit( tt, 0 ) )
@@ -132,25 +339,319 @@ uint32_t truth_table_cache<TT>::insert( TT tt )
   }
 
   /* is truth table already in cache? */
-  const auto it = _indexes.find( tt );
-  if ( it != _indexes.end() )
+  const auto h = hash( tt );
+  uint64_t slot;
+  if ( const auto index = find( tt, h, slot ); index != not_found )
   {
-    return static_cast<uint32_t>( 2 * it->second + is_compl );
+    return 2 * index + is_compl;
   }
 
   /* add truth table to end of cache */
-  const auto size = _data.size();
-  const auto index = static_cast<uint32_t>( 2 * size + is_compl );
-  _data.push_back( tt );
-  _indexes[tt] = static_cast<unsigned int>( size );
-  return index;
+  const auto index = static_cast<uint32_t>( _entries.size() );
+  _entries.push_back( {_words.size(), static_cast<uint32_t>( tt.num_vars() ), h} );
+  _words.insert( _words.end(), tt.cbegin(), tt.cend() );
+  _slots[slot] = index + 1u;
+  if ( 2u * _entries.size() > _slots.size() )
+  {
+    resize_slots( _entries.size() );
+  }
+  return 2 * index + is_compl;
 }
 
 template<typename TT>
-TT truth_table_cache<TT>::operator[]( uint32_t index ) const
+TT truth_table_cache<TT>::operator[]( uint32_t lit ) const
 {
-  auto& entry = _data[index >> 1];
-  return ( index & 1 ) ? ~entry : entry;
+  const auto index = lit >> 1;
+
+  uint64_t const* words;
+  uint32_t num_vars;
+  if ( index < _entries.size() )
+  {
+    const auto& e = _entries[index];
+    words = _words.data() + e.offset;
+    num_vars = e.num_vars;
+  }
+  else
+  {
+    assert( _concurrent );
+    const auto& r = _concurrent->at( index );
+    words = r.words;
+    num_vars = r.num_vars;
+  }
+
+  auto tt = create( num_vars );
+  std::copy( words, words + tt.num_blocks(), tt.begin() );
+  return ( lit & 1 ) ? ~tt : tt;
+}
+
+template<typename TT>
+void truth_table_cache<TT>::clear()
+{
+  assert( !_concurrent );
+  _entries.clear();
+  _words.clear();
+  std::fill( _slots.begin(), _slots.end(), 0u );
 }
 
+template<typename TT>
+void truth_table_cache<TT>::begin_concurrent_insert()
+{
+  assert( !_concurrent );
+  _concurrent = std::make_unique<concurrent_state>( static_cast<uint32_t>( _entries.size() ) );
+}
+
+template<typename TT>
+uint32_t truth_table_cache<TT>::insert_concurrent( TT tt )
+{
+  assert( _concurrent && "call begin_concurrent_insert before inserting concurrently" );
+
+  uint32_t is_compl{0};
+
+  if ( kitty::get_bit( tt, 0 ) )
+  {
+    is_compl = 1;
+    tt = ~tt;
+  }
+
+  /* the truth tables from before concurrent insertion do not change */
+  const auto h = hash( tt );
+  uint64_t slot;
+  if ( const auto index = find( tt, h, slot ); index != not_found )
+  {
+    return 2 * index + is_compl;
+  }
+
+  auto& cs = *_concurrent;
+  auto& s = cs.shards[h >> ( 32u - concurrent_state::shard_bits )];
+  std::lock_guard<std::mutex> lock( s.mutex );
+
+  slot = h & s.slot_mask;
+  while ( s.slots[slot] != 0u )
+  {
+    const auto index = s.slots[slot] - 1u;
+    const auto& r = cs.at( index );
+    if ( r.hash == h && r.num_vars == tt.num_vars() && std::equal( tt.cbegin(), tt.cend(), r.words ) )
+    {
+      return 2 * index + is_compl;
+    }
+    slot = ( slot + 1u ) & s.slot_mask;
+  }
+
+  const auto index = cs.next_index.fetch_add( 1u );
+  if ( index >= ( UINT32_C( 1 ) << 31 ) )
+  {
+    throw std::length_error( "truth table cache exceeds the number of representable literals" );
+  }
+
+  auto& r = cs.allocate_record( index );
+  auto* words = s.allocate( tt.num_blocks() );
+  std::copy( tt.cbegin(), tt.cend(), words );
+  r = {words, static_cast<uint32_t>( tt.num_blocks() ), static_cast<uint32_t>( tt.num_vars() ), h};
+
+  s.slots[slot] = index + 1u;
+  if ( 2u * ++s.num_entries > s.slots.size() )
+  {
+    std::vector<uint32_t> slots( 2u * s.slots.size(), 0u );
+    s.slot_mask = slots.size() - 1u;
+    for ( auto i : s.slots )
+    {
+      if ( i == 0u )
+      {
+        continue;
+      }
+      auto j = cs.at( i - 1u ).hash & s.slot_mask;
+      while ( slots[j] != 0u )
+      {
+        j = ( j + 1u ) & s.slot_mask;
+      }
+      slots[j] = i;
+    }
+    s.slots.swap( slots );
+  }
+
+  return 2 * index + is_compl;
+}
+
+template<typename TT>
+void truth_table_cache<TT>::end_concurrent_insert()
+{
+  assert( _concurrent );
+
+  const auto num_entries = _entries.size() + _concurrent->size();
+  _entries.reserve( num_entries );
+  for ( auto index = static_cast<uint32_t>( _entries.size() ); index < num_entries; ++index )
+  {
+    const auto& r = _concurrent->at( index );
+    _entries.push_back( {_words.size(), r.num_vars, r.hash} );
+    _words.insert( _words.end(), r.words, r.words + r.num_words );
+  }
+  _concurrent.reset();
+
+  resize_slots( _entries.size() );
+}
+
+template<typename TT>
+TT truth_table_cache<TT>::create( uint32_t num_vars )
+{
+  if constexpr ( std::is_constructible_v<TT, uint32_t> )
+  {
+    return TT( num_vars );
+  }
+  else
+  {
+    (void)num_vars;
+    return TT();
+  }
+}
+
+template<typename TT>
+uint32_t truth_table_cache<TT>::hash( TT const& tt )
+{
+  uint64_t h = tt.num_vars();
+  for ( auto it = tt.cbegin(); it != tt.cend(); ++it )
+  {
+    h = ( h ^ *it ) * UINT64_C( 0x9e3779b97f4a7c15 );
+    h ^= h >> 29;
+  }
+  return static_cast<uint32_t>( h >> 32 );
+}
+
+/* returns the index of `tt`, or `not_found` and the empty slot in which it can be inserted */
+template<typename TT>
+uint32_t truth_table_cache<TT>::find( TT const& tt, uint32_t h, uint64_t& slot ) const
+{
+  slot = h & _slot_mask;
+  while ( _slots[slot] != 0u )
+  {
+    const auto& e = _entries[_slots[slot] - 1u];
+    if ( e.hash == h && e.num_vars == tt.num_vars() && std::equal( tt.cbegin(), tt.cend(), _words.begin() + e.offset ) )
+    {
+      return _slots[slot] - 1u;
+    }
+    slot = ( slot + 1u ) & _slot_mask;
+  }
+  return not_found;
+}
+
+/* rehashes all entries into at least `2 * num_entries` slots */
+template<typename TT>
+void truth_table_cache<TT>::resize_slots( uint64_t num_entries )
+{
+  uint64_t num_slots = 16u;
+  while ( num_slots < 2u * num_entries )
+  {
+    num_slots <<= 1;
+  }
+
+  _slot_mask = num_slots - 1u;
+  _slots.assign( num_slots, 0u );
+  for ( auto i = 0u; i < _entries.size(); ++i )
+  {
+    auto slot = _entries[i].hash & _slot_mask;
+    while ( _slots[slot] != 0u )
+    {
+      slot = ( slot + 1u ) & _slot_mask;
+    }
+    _slots[slot] = i + 1u;
+  }
+}
+
+/*! \brief Truth table cache for functions with up to 6 variables.
+ *
+ * This specialization stores truth tables as 64-bit words, in which functions
+ * with fewer than 6 variables are replicated.  It follows the same literal
+ * convention as the general truth table cache, but finds entries in a flat
+ * open-addressing hash table and does not allocate memory per entry.
+ */
+template<>
+class truth_table_cache<uint64_t>
+{
+public:
+  /*! \brief Creates a truth table cache and reserves memory. */
+  truth_table_cache( uint32_t capacity = 1000u )
+  {
+    _data.reserve( capacity );
+    resize_slots( capacity );
+  }
+
+  /*! \brief Inserts a truth table and returns a literal. */
+  uint32_t insert( uint64_t tt )
+  {
+    const uint32_t is_compl = tt & 1u;
+    if ( is_compl )
+    {
+      tt = ~tt;
+    }
+
+    auto slot = hash( tt );
+    while ( _slots[slot] != 0u )
+    {
+      if ( _data[_slots[slot] - 1u] == tt )
+      {
+        return 2u * ( _slots[slot] - 1u ) + is_compl;
+      }
+      slot = ( slot + 1u ) & _slot_mask;
+    }
+
+    const auto size = static_cast<uint32_t>( _data.size() );
+    _data.push_back( tt );
+    _slots[slot] = size + 1u;
+    if ( 2u * _data.size() > _slots.size() )
+    {
+      resize_slots( static_cast<uint32_t>( _slots.size() ) );
+    }
+    return 2u * size + is_compl;
+  }
+
+  /*! \brief Returns truth table for a given literal. */
+  uint64_t operator[]( uint32_t lit ) const
+  {
+    const auto entry = _data[lit >> 1];
+    return ( lit & 1 ) ? ~entry : entry;
+  }
+
+  /*! \brief Returns number of normalized truth tables in the cache. */
+  auto size() const { return _data.size(); }
+
+  /*! \brief Removes all truth tables from the cache. */
+  void clear()
+  {
+    _data.clear();
+    std::fill( _slots.begin(), _slots.end(), 0u );
+  }
+
+private:
+  uint64_t hash( uint64_t tt ) const
+  {
+    return ( ( tt * UINT64_C( 0x9e3779b97f4a7c15 ) ) >> 32 ) & _slot_mask;
+  }
+
+  /* rehashes all entries into at least `2 * num_entries` slots */
+  void resize_slots( uint32_t num_entries )
+  {
+    uint64_t num_slots = 16u;
+    while ( num_slots < 2u * static_cast<uint64_t>( num_entries ) )
+    {
+      num_slots <<= 1;
+    }
+
+    _slot_mask = num_slots - 1u;
+    _slots.assign( num_slots, 0u );
+    for ( auto i = 0u; i < _data.size(); ++i )
+    {
+      auto slot = hash( _data[i] );
+      while ( _slots[slot] != 0u )
+      {
+        slot = ( slot + 1u ) & _slot_mask;
+      }
+      _slots[slot] = i + 1u;
+    }
+  }
+
+private:
+  std::vector<uint64_t> _data;
+  std::vector<uint32_t> _slots; /* entry index + 1, or 0 for an empty slot */
+  uint64_t _slot_mask{};
+};
+
 } /* namespace mockturtle */
@@ -73,39 +73,41 @@ public:
   /*! \brief Assigns all nodes to `color` */
   void clear_colors( uint32_t color = 0 ) const
   {
-    std::for_each( this->_storage->nodes.begin(), this->_storage->nodes.end(),
-                   [color]( auto& n ) { n.data[1].h1 = color; } );
+    for ( auto i = 0u; i < this->size(); ++i )
+    {
+      this->set_visited( this->index_to_node( i ), color );
+    }
   }
 
   /*! \brief Returns the color of a node */
   auto color( node const& n ) const
   {
-    return this->_storage->nodes[n].data[1].h1;
+    return this->visited( n );
   }
 
   /*! \brief Returns the color of a node */
   template<typename _Ntk = Ntk, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
   auto color( signal const& n ) const
   {
-    return this->_storage->nodes[this->get_node( n )].data[1].h1;
+    return this->visited( this->get_node( n ) );
   }
 
   /*! \brief Assigns the current color to a node */
   void paint( node const& n ) const
   {
-    this->_storage->nodes[n].data[1].h1 = current_color();
+    this->set_visited( n, current_color() );
   }
 
   /*! \brief Assigns `color` to a node */
   void paint( node const& n, uint32_t color ) const
   {
-    this->_storage->nodes[n].data[1].h1 = color;
+    this->set_visited( n, color );
   }
 
   /*! \brief Copies the color from `other` to `n` */
   void paint( node const& n, node const& other ) const
   {
-    this->_storage->nodes[n].data[1].h1 = color( other );
+    this->set_visited( n, color( other ) );
   }
 
   /*! \brief Evaluates a predicate on the color of a node */
@@ -32,12 +32,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "fanout_view.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -56,11 +64,16 @@ struct depth_view_params
  * `level` and `depth`.  The levels are computed at construction
  * and can be recomputed by calling the `update_levels` method.
  *
- * It also automatically updates levels, and depth when creating nodes or
- * creating a PO on a depth_view, however, it does not update the information,
- * when modifying or deleting nodes, neither will the critical paths be
- * recalculated (due to efficiency reasons).  In order to recalculate levels,
- * depth, and critical paths, one can call `update_levels` instead.
+ * Levels, depth, required levels, and critical paths are kept up-to-date
+ * when nodes are created, modified, or deleted, and when primary outputs
+ * are created or replaced through this view.  A change is propagated
+ * level by level through the transitive fanout (for levels) and the
+ * transitive fanin (for required levels) of the changed nodes, and stops
+ * where values do not change.  Fanouts are taken from the network if it
+ * implements `foreach_fanout` (e.g., `fanout_view`), otherwise the view
+ * keeps its own fanout lists, which are built upon the first modification.
+ * Changes that are not reported by events, such as rolling back a
+ * checkpoint, require a call to `update_levels`.
  *
  * **Required network functions:**
  * - `size`
@@ -113,7 +126,9 @@ public:
       : Ntk(),
         _ps( ps ),
         _levels( *this ),
-        _crit_path( *this ),
+        _tails( *this, -1 ),
+        _po_tails( *this, -1 ),
+        _state( std::make_shared<state>() ),
         _cost_fn( cost_fn )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -125,7 +140,7 @@ public:
     static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    Ntk::events().on_add.push_back( [this]( auto const& n ) { on_add( n ); } );
+    add_event_handlers();
   }
 
   /*! \brief Standard constructor.
@@ -137,7 +152,9 @@ public:
       : Ntk( ntk ),
         _ps( ps ),
         _levels( ntk ),
-        _crit_path( ntk ),
+        _tails( ntk, -1 ),
+        _po_tails( ntk, -1 ),
+        _state( std::make_shared<state>() ),
         _cost_fn( cost_fn )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -150,8 +167,7 @@ public:
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
     update_levels();
-
-    Ntk::events().on_add.push_back( [this]( auto const& n ) { on_add( n ); } );
+    add_event_handlers();
   }
 
   // We should add these or make sure that members are properly copied
@@ -160,7 +176,7 @@ public:
 
   uint32_t depth() const
   {
-    return _depth;
+    return _state->depth;
   }
 
   uint32_t level( node const& n ) const
@@ -168,9 +184,21 @@ public:
     return _levels[n];
   }
 
+  /*! \brief Returns the required level of a node.
+   *
+   * This is the largest level the node can have without increasing the
+   * depth of the network.  Nodes that are not in the transitive fanin of a
+   * primary output have no required level, and the maximum value is
+   * returned.
+   */
+  uint32_t required( node const& n ) const
+  {
+    return _tails[n] < 0 ? std::numeric_limits<uint32_t>::max() : _state->depth - _tails[n];
+  }
+
   bool is_on_critical_path( node const& n ) const
   {
-    return _crit_path[n];
+    return _tails[n] >= 0 && _levels[n] + _tails[n] == _state->depth;
   }
 
   void set_level( node const& n, uint32_t level )
@@ -180,13 +208,15 @@ public:
 
   void set_depth( uint32_t level )
   {
-    _depth = level;
+    _state->depth = level;
   }
 
   void update_levels()
   {
     _levels.reset( 0 );
-    _crit_path.reset( false );
+    _tails.reset( -1 );
+    _po_tails.reset( -1 );
+    _state->has_fanout = false;
 
     this->incr_trav_id();
     compute_levels();
@@ -195,15 +225,59 @@ public:
   void resize_levels()
   {
     _levels.resize();
+    _tails.resize( -1 );
+    _po_tails.resize( -1 );
   }
 
   void create_po( signal const& f )
   {
     Ntk::create_po( f );
-    _depth = std::max( _depth, _levels[f] );
+
+    const auto n = this->get_node( f );
+    const auto offset = po_offset( f );
+    _state->depth = std::max( _state->depth, _levels[n] + offset );
+    if ( _po_tails[n] < 0 )
+    {
+      _state->po_drivers.push_back( n );
+    }
+    if ( offset > _po_tails[n] )
+    {
+      _po_tails[n] = offset;
+      update_tails( {n} );
+    }
+  }
+
+  template<typename _Ntk = Ntk>
+  auto replace_in_outputs( node const& old_node, signal const& new_signal ) -> decltype( std::declval<_Ntk&>().replace_in_outputs( old_node, new_signal ) )
+  {
+    Ntk::replace_in_outputs( old_node, new_signal );
+    update_outputs();
+  }
+
+  template<typename _Ntk = Ntk, typename = std::enable_if_t<has_substitute_node_v<_Ntk>>>
+  void substitute_node( node const& old_node, signal const& new_signal )
+  {
+    Ntk::substitute_node( old_node, new_signal );
+
+    /* outputs are replaced without notification; they are updated when the
+       old node is deleted, which does not happen for CIs */
+    if ( _po_tails[old_node] >= 0 )
+    {
+      update_outputs();
+    }
   }
 
 private:
+  struct state
+  {
+    uint32_t depth{};
+    std::vector<node> po_drivers;
+
+    /* own fanout lists, if Ntk does not implement foreach_fanout */
+    bool has_fanout{false};
+    detail::packed_fanout_storage fanout;
+  };
+
   uint32_t compute_levels( node const& n )
   {
     if ( this->visited( n ) == this->trav_id() )
@@ -214,6 +288,7 @@ private:
 
     if ( this->is_constant( n ) || this->is_pi( n ) )
     {
+      _topo_order.push_back( n );
       return _levels[n] = 0;
     }
 
@@ -227,72 +302,316 @@ private:
       level = std::max( level, clevel );
     } );
 
+    _topo_order.push_back( n );
     return _levels[n] = level + _cost_fn( *this, n );
   }
 
   void compute_levels()
   {
-    _depth = 0;
+    _state->depth = 0;
+    _state->po_drivers.clear();
+    _topo_order.clear();
     this->foreach_po( [&]( auto const& f ) {
-      auto clevel = compute_levels( this->get_node( f ) );
+      const auto n = this->get_node( f );
+      const auto offset = po_offset( f );
+      _state->depth = std::max( _state->depth, compute_levels( n ) + offset );
+      if ( _po_tails[n] < 0 )
+      {
+        _state->po_drivers.push_back( n );
+      }
+      _po_tails[n] = std::max( _po_tails[n], offset );
+    } );
+
+    /* dangling nodes get levels as well, as if they had been added */
+    this->foreach_gate( [&]( auto const& n ) {
+      compute_levels( n );
+    } );
+
+    /* longest paths to the outputs in reverse topological order */
+    for ( auto it = _topo_order.rbegin(); it != _topo_order.rend(); ++it )
+    {
+      const auto n = *it;
+      _tails[n] = std::max( _tails[n], _po_tails[n] );
+      if ( _tails[n] < 0 || this->is_constant( n ) || this->is_pi( n ) )
+      {
+        continue;
+      }
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        auto& tail = _tails[this->get_node( f )];
+        tail = std::max( tail, _tails[n] + edge_offset( n, f ) );
+      } );
+    }
+    _topo_order.clear();
+  }
+
+  int32_t po_offset( signal const& f ) const
+  {
+    return ( _ps.count_complements && this->is_complemented( f ) ) ? 1 : 0;
+  }
+
+  /* level difference between a fanin f and its fanout n */
+  int32_t edge_offset( node const& n, signal const& f ) const
+  {
+    return _cost_fn( *this, n ) + ( ( _ps.count_complements && this->is_complemented( f ) ) ? 1 : 0 );
+  }
+
+  uint32_t compute_level( node const& n ) const
+  {
+    if ( this->is_constant( n ) || this->is_pi( n ) )
+    {
+      return 0;
+    }
+
+    uint32_t level{0};
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      auto clevel = _levels[f];
       if ( _ps.count_complements && this->is_complemented( f ) )
       {
         clevel++;
       }
-      _depth = std::max( _depth, clevel );
+      level = std::max( level, clevel );
     } );
+    return level + _cost_fn( *this, n );
+  }
 
-    this->foreach_po( [&]( auto const& f ) {
-      const auto n = this->get_node( f );
-      if ( _levels[n] == _depth )
+  int32_t compute_tail( node const& n )
+  {
+    int32_t tail = _po_tails[n];
+    foreach_fanout_of( n, [&]( node const& p ) {
+      if ( _tails[p] < 0 )
       {
-        set_critical_path( n );
+        return;
       }
+      this->foreach_fanin( p, [&]( auto const& f ) {
+        if ( this->get_node( f ) == n )
+        {
+          tail = std::max( tail, _tails[p] + edge_offset( p, f ) );
+        }
+      } );
     } );
+    return tail;
   }
 
-  void set_critical_path( node const& n )
+  template<typename Fn>
+  void foreach_fanout_of( node const& n, Fn&& fn )
   {
-    _crit_path[n] = true;
-    if ( !this->is_constant( n ) && !this->is_pi( n ) )
+    if constexpr ( has_foreach_fanout_v<Ntk> )
     {
-      const auto lvl = _levels[n];
-      this->foreach_fanin( n, [&]( auto const& f ) {
-        const auto cn = this->get_node( f );
-        auto offset = _cost_fn( *this, n );
-        if ( _ps.count_complements && this->is_complemented( f ) )
+      Ntk::foreach_fanout( n, fn );
+    }
+    else
+    {
+      if ( !_state->has_fanout )
+      {
+        build_fanout();
+      }
+      const auto index = this->node_to_index( n );
+      for ( auto i = 0u; i < _state->fanout.size( index ); ++i )
+      {
+        fn( this->index_to_node( _state->fanout.fanout( index, i ) ) );
+      }
+    }
+  }
+
+  void build_fanout()
+  {
+    _state->fanout.build( this->size(), [&]( auto&& add_edge ) {
+      this->foreach_gate( [&]( auto const& n ) {
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          add_edge( this->node_to_index( this->get_node( f ) ), this->node_to_index( n ) );
+        } );
+      } );
+    } );
+    _state->has_fanout = true;
+  }
+
+  /* propagates level changes of the given nodes through their transitive fanout */
+  void update_levels_from( node const& n )
+  {
+    bool recompute_depth{false};
+    std::set<std::pair<uint32_t, node>> queue;
+    queue.emplace( _levels[n], n );
+
+    while ( !queue.empty() )
+    {
+      const auto m = queue.begin()->second;
+      queue.erase( queue.begin() );
+
+      const auto level = compute_level( m );
+      if ( level == _levels[m] )
+      {
+        continue;
+      }
+
+      if ( _po_tails[m] >= 0 )
+      {
+        if ( level + _po_tails[m] > _state->depth )
         {
-          offset++;
+          _state->depth = level + _po_tails[m];
         }
-        if ( _levels[cn] + offset == lvl && !_crit_path[cn] )
+        else if ( _levels[m] + _po_tails[m] == _state->depth )
         {
-          set_critical_path( cn );
+          recompute_depth = true;
         }
+      }
+      _levels[m] = level;
+
+      foreach_fanout_of( m, [&]( node const& p ) {
+        queue.emplace( _levels[p], p );
       } );
     }
+
+    if ( recompute_depth )
+    {
+      update_depth();
+    }
+  }
+
+  /* propagates changes of longest output paths through the transitive fanin */
+  void update_tails( std::vector<node> const& nodes )
+  {
+    std::set<std::pair<uint32_t, node>, std::greater<std::pair<uint32_t, node>>> queue;
+    for ( auto const& n : nodes )
+    {
+      queue.emplace( _levels[n], n );
+    }
+
+    while ( !queue.empty() )
+    {
+      const auto m = queue.begin()->second;
+      queue.erase( queue.begin() );
+
+      if ( const auto tail = compute_tail( m ); tail != _tails[m] )
+      {
+        _tails[m] = tail;
+        this->foreach_fanin( m, [&]( auto const& f ) {
+          queue.emplace( _levels[f], this->get_node( f ) );
+        } );
+      }
+    }
+  }
+
+  void update_depth()
+  {
+    _state->depth = 0;
+    this->foreach_po( [&]( auto const& f ) {
+      _state->depth = std::max( _state->depth, _levels[f] + po_offset( f ) );
+    } );
+  }
+
+  /* recomputes output information, after outputs may have been replaced */
+  void update_outputs()
+  {
+    std::vector<node> changed;
+    for ( auto const& n : _state->po_drivers )
+    {
+      _po_tails[n] = -1;
+      changed.push_back( n );
+    }
+    _state->po_drivers.clear();
+
+    this->foreach_po( [&]( auto const& f ) {
+      const auto n = this->get_node( f );
+      if ( _po_tails[n] < 0 )
+      {
+        _state->po_drivers.push_back( n );
+        changed.push_back( n );
+      }
+      _po_tails[n] = std::max( _po_tails[n], po_offset( f ) );
+    } );
+
+    update_depth();
+    update_tails( changed );
+  }
+
+  void add_event_handlers()
+  {
+    Ntk::events().on_add.push_back( [this]( auto const& n ) { on_add( n ); } );
+    Ntk::events().on_modified.push_back( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    Ntk::events().on_delete.push_back( [this]( auto const& n ) { on_delete( n ); } );
   }
 
   void on_add( node const& n )
   {
-    _levels.resize();
+    resize_levels();
 
-    uint32_t level{0};
+    if constexpr ( !has_foreach_fanout_v<Ntk> )
+    {
+      if ( _state->has_fanout )
+      {
+        _state->fanout.resize( this->size() );
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          _state->fanout.insert( this->node_to_index( this->get_node( f ) ), this->node_to_index( n ) );
+        } );
+      }
+    }
+
+    _levels[n] = compute_level( n );
+  }
+
+  template<typename Previous>
+  void on_modified( node const& n, Previous const& previous )
+  {
+    if constexpr ( !has_foreach_fanout_v<Ntk> )
+    {
+      if ( _state->has_fanout )
+      {
+        for ( auto const& f : previous )
+        {
+          _state->fanout.erase( this->node_to_index( this->get_node( f ) ), this->node_to_index( n ) );
+        }
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          _state->fanout.insert( this->node_to_index( this->get_node( f ) ), this->node_to_index( n ) );
+        } );
+      }
+    }
+
+    update_levels_from( n );
+
+    std::vector<node> fanins;
+    for ( auto const& f : previous )
+    {
+      fanins.push_back( this->get_node( f ) );
+    }
     this->foreach_fanin( n, [&]( auto const& f ) {
-      auto clevel = _levels[f];
-      if ( _ps.count_complements && this->is_complemented( f ) )
+      fanins.push_back( this->get_node( f ) );
+    } );
+    update_tails( fanins );
+  }
+
+  void on_delete( node const& n )
+  {
+    if constexpr ( !has_foreach_fanout_v<Ntk> )
+    {
+      if ( _state->has_fanout )
       {
-        clevel++;
+        _state->fanout.clear( this->node_to_index( n ) );
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          _state->fanout.erase( this->node_to_index( this->get_node( f ) ), this->node_to_index( n ) );
+        } );
       }
-      level = std::max( level, clevel );
+    }
+
+    _tails[n] = -1;
+    std::vector<node> fanins;
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( this->get_node( f ) );
     } );
+    update_tails( fanins );
 
-    _levels[n] = level + _cost_fn( *this, n );
+    /* outputs of deleted nodes have been replaced */
+    if ( _po_tails[n] >= 0 )
+    {
+      update_outputs();
+    }
   }
 
   depth_view_params _ps;
   node_map<uint32_t, Ntk> _levels;
-  node_map<uint32_t, Ntk> _crit_path;
-  uint32_t _depth{};
+  node_map<int32_t, Ntk> _tails;    /* longest path to an output, -1 if none */
+  node_map<int32_t, Ntk> _po_tails; /* offset to driven outputs, -1 if none */
+  std::shared_ptr<state> _state;
+  std::vector<node> _topo_order;
   NodeCostFn _cost_fn;
 };
 
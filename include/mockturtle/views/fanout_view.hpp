@@ -32,13 +32,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
+#include <memory>
 #include <stack>
 #include <vector>
 
 #include "../traits.hpp"
 #include "../networks/detail/foreach.hpp"
-#include "../utils/node_map.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -51,6 +53,151 @@ struct fanout_view_params
   bool update_on_delete{true};
 };
 
+namespace detail
+{
+
+/*! \brief Compact fanout lists of all nodes.
+ *
+ * All fanout lists are stored as node indexes in one array in compressed
+ * sparse row format, which is built in one pass over the network.  Each list
+ * occupies a slot of some capacity.  A list that outgrows its slot is moved
+ * to the end of the array with twice the capacity, and the array is packed
+ * again once it has more than twice as many entries as there are fanouts.
+ */
+class packed_fanout_storage
+{
+public:
+  /*! \brief Number of fanouts of node with index `n`. */
+  uint32_t size( uint32_t n ) const
+  {
+    return _sizes[n];
+  }
+
+  /*! \brief Number of nodes. */
+  uint32_t num_nodes() const
+  {
+    return static_cast<uint32_t>( _sizes.size() );
+  }
+
+  /*! \brief Index of the `i`-th fanout of node with index `n`. */
+  uint32_t fanout( uint32_t n, uint32_t i ) const
+  {
+    return _data[_offsets[n] + i];
+  }
+
+  /*! \brief Builds all lists from `(node, fanout)` index pairs.
+   *
+   * `foreach_edge` is called twice with a function that takes a node index
+   * and a fanout index; it must enumerate the same pairs both times.
+   * A fanout that repeats the last one in the list of a node is skipped.
+   */
+  template<typename EdgeFn>
+  void build( uint32_t num_nodes, EdgeFn&& foreach_edge )
+  {
+    _sizes.assign( num_nodes, 0u );
+    _capacities.assign( num_nodes, 0u );
+    foreach_edge( [&]( uint32_t n, uint32_t fanout ) {
+      (void)fanout;
+      ++_capacities[n];
+    } );
+
+    _offsets.resize( num_nodes );
+    uint32_t offset{0u};
+    for ( auto n = 0u; n < num_nodes; ++n )
+    {
+      _offsets[n] = offset;
+      offset += _capacities[n];
+    }
+
+    _data.resize( offset );
+    _num_fanouts = 0u;
+    foreach_edge( [&]( uint32_t n, uint32_t fanout ) {
+      if ( _sizes[n] == 0u || _data[_offsets[n] + _sizes[n] - 1u] != fanout )
+      {
+        _data[_offsets[n] + _sizes[n]++] = fanout;
+        ++_num_fanouts;
+      }
+    } );
+  }
+
+  /*! \brief Adds empty lists for new nodes. */
+  void resize( uint32_t num_nodes )
+  {
+    if ( num_nodes > _sizes.size() )
+    {
+      _offsets.resize( num_nodes, static_cast<uint32_t>( _data.size() ) );
+      _sizes.resize( num_nodes, 0u );
+      _capacities.resize( num_nodes, 0u );
+    }
+  }
+
+  /*! \brief Appends `fanout` to the list of node with index `n`. */
+  void insert( uint32_t n, uint32_t fanout )
+  {
+    if ( _sizes[n] == _capacities[n] )
+    {
+      relocate( n, std::max( 2u * _capacities[n], 2u ) );
+    }
+    _data[_offsets[n] + _sizes[n]++] = fanout;
+    ++_num_fanouts;
+  }
+
+  /*! \brief Removes all occurrences of `fanout` from the list of node with index `n`. */
+  void erase( uint32_t n, uint32_t fanout )
+  {
+    const auto begin = _data.begin() + _offsets[n];
+    const auto size = static_cast<uint32_t>( std::remove( begin, begin + _sizes[n], fanout ) - begin );
+    _num_fanouts -= _sizes[n] - size;
+    _sizes[n] = size;
+  }
+
+  /*! \brief Removes all fanouts of node with index `n`. */
+  void clear( uint32_t n )
+  {
+    _num_fanouts -= _sizes[n];
+    _sizes[n] = 0u;
+  }
+
+  /*! \brief Packs all lists without gaps. */
+  void repack()
+  {
+    std::vector<uint32_t> data;
+    data.reserve( _num_fanouts );
+    for ( auto n = 0u; n < _sizes.size(); ++n )
+    {
+      const auto begin = _data.begin() + _offsets[n];
+      _offsets[n] = static_cast<uint32_t>( data.size() );
+      data.insert( data.end(), begin, begin + _sizes[n] );
+      _capacities[n] = _sizes[n];
+    }
+    _data = std::move( data );
+  }
+
+private:
+  void relocate( uint32_t n, uint32_t capacity )
+  {
+    if ( _data.size() > 2u * _num_fanouts )
+    {
+      repack();
+    }
+
+    const auto offset = static_cast<uint32_t>( _data.size() );
+    _data.resize( offset + capacity );
+    std::copy_n( _data.begin() + _offsets[n], _sizes[n], _data.begin() + offset );
+    _offsets[n] = offset;
+    _capacities[n] = capacity;
+  }
+
+private:
+  std::vector<uint32_t> _offsets;
+  std::vector<uint32_t> _sizes;
+  std::vector<uint32_t> _capacities;
+  std::vector<uint32_t> _data;
+  std::size_t _num_fanouts{0u};
+};
+
+} // namespace detail
+
 /*! \brief Implements `foreach_fanout` methods for networks.
  *
  * This view computes the fanout of each node of the network.
@@ -58,6 +205,9 @@ struct fanout_view_params
  * fanout are computed at construction and can be recomputed by
  * calling the `update_fanout` method.
  *
+ * The fanout lists of all nodes are kept in one compact array (see
+ * `detail::packed_fanout_storage`) instead of one vector per node.
+ *
  * **Required network functions:**
  * - `foreach_node`
  * - `foreach_fanin`
@@ -88,7 +238,7 @@ public:
 
   explicit fanout_view( fanout_view_params const& ps = {} )
     : Ntk()
-    , _fanout( *this )
+    , _fanout( std::make_shared<detail::packed_fanout_storage>() )
     , _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -96,44 +246,12 @@ public:
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
     update_fanout();
-
-    if ( _ps.update_on_add )
-    {
-      Ntk::events().on_add.push_back( [this]( auto const& n ) {
-        _fanout.resize();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
-        } );
-      } );
-    }
-
-    if ( _ps.update_on_modified )
-    {
-      Ntk::events().on_modified.push_back( [this]( auto const& n, auto const& previous ) {
-        (void)previous;
-        for ( auto const& f : previous ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
-        }
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
-        } );
-      } );
-    }
-
-    if ( _ps.update_on_delete )
-    {
-      Ntk::events().on_delete.push_back( [this]( auto const& n ) {
-        _fanout[n].clear();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
-        } );
-      } );
-    }
+    add_event_handlers();
   }
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
     : Ntk( ntk )
-    , _fanout( ntk )
+    , _fanout( std::make_shared<detail::packed_fanout_storage>() )
     , _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -141,46 +259,42 @@ public:
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
     update_fanout();
-
-    if ( _ps.update_on_add )
-    {
-      Ntk::events().on_add.push_back( [this]( auto const& n ) {
-        _fanout.resize();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
-        } );
-      } );
-    }
-
-    if ( _ps.update_on_modified )
-    {
-      Ntk::events().on_modified.push_back( [this]( auto const& n, auto const& previous ) {
-        (void)previous;
-        for ( auto const& f : previous ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
-        }
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
-        } );
-      } );
-    }
-
-    if ( _ps.update_on_delete )
-    {
-      Ntk::events().on_delete.push_back( [this]( auto const& n ) {
-        _fanout[n].clear();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
-        } );
-      } );
-    }
+    add_event_handlers();
   }
 
   template<typename Fn>
   void foreach_fanout( node const& n, Fn&& fn ) const
   {
     assert( n < this->size() );
-    detail::foreach_element( _fanout[n].begin(), _fanout[n].end(), fn );
+
+    /* the list is re-read in each step, since fn may add fanouts to other nodes */
+    const auto index = Ntk::node_to_index( n );
+    for ( uint32_t i = 0u; i < _fanout->size( index ); ++i )
+    {
+      const auto p = Ntk::index_to_node( _fanout->fanout( index, i ) );
+      if constexpr ( detail::is_callable_without_index_v<Fn, node, bool> )
+      {
+        if ( !fn( p ) )
+        {
+          return;
+        }
+      }
+      else if constexpr ( detail::is_callable_with_index_v<Fn, node, bool> )
+      {
+        if ( !fn( p, i ) )
+        {
+          return;
+        }
+      }
+      else if constexpr ( detail::is_callable_without_index_v<Fn, node, void> )
+      {
+        fn( p );
+      }
+      else
+      {
+        fn( p, i );
+      }
+    }
   }
 
   void update_fanout()
@@ -190,7 +304,10 @@ public:
 
   std::vector<node> fanout( node const& n ) const /* deprecated */
   {
-    return _fanout[n];
+    std::vector<node> fanout;
+    fanout.reserve( _fanout->size( Ntk::node_to_index( n ) ) );
+    foreach_fanout( n, [&]( auto const& p ) { fanout.push_back( p ); } );
+    return fanout;
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -203,7 +320,7 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      const auto parents = _fanout[_old];
+      const auto parents = fanout( _old );
       for ( auto n : parents )
       {
         if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
@@ -221,22 +338,54 @@ public:
   }
 
 private:
-  void compute_fanout()
+  void add_event_handlers()
   {
-    _fanout.reset();
+    if ( _ps.update_on_add )
+    {
+      Ntk::events().on_add.push_back( [this]( auto const& n ) {
+        _fanout->resize( Ntk::size() );
+        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
+          _fanout->insert( Ntk::node_to_index( Ntk::get_node( f ) ), Ntk::node_to_index( n ) );
+        } );
+      } );
+    }
+
+    if ( _ps.update_on_modified )
+    {
+      Ntk::events().on_modified.push_back( [this]( auto const& n, auto const& previous ) {
+        for ( auto const& f : previous ) {
+          _fanout->erase( Ntk::node_to_index( Ntk::get_node( f ) ), Ntk::node_to_index( n ) );
+        }
+        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
+          _fanout->insert( Ntk::node_to_index( Ntk::get_node( f ) ), Ntk::node_to_index( n ) );
+        } );
+      } );
+    }
 
-    this->foreach_gate( [&]( auto const& n ){
-        this->foreach_fanin( n, [&]( auto const& c ){
-            auto& fanout = _fanout[c];
-            if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
-            {
-              fanout.push_back( n );
-            }
-          });
-      });
+    if ( _ps.update_on_delete )
+    {
+      Ntk::events().on_delete.push_back( [this]( auto const& n ) {
+        _fanout->clear( Ntk::node_to_index( n ) );
+        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
+          _fanout->erase( Ntk::node_to_index( Ntk::get_node( f ) ), Ntk::node_to_index( n ) );
+        } );
+      } );
+    }
+  }
+
+  void compute_fanout()
+  {
+    _fanout->build( Ntk::size(), [&]( auto&& add_edge ) {
+      this->foreach_gate( [&]( auto const& n ) {
+        this->foreach_fanin( n, [&]( auto const& c ) {
+          add_edge( Ntk::node_to_index( Ntk::get_node( c ) ), Ntk::node_to_index( n ) );
+        } );
+      } );
+    } );
   }
 
-  node_map<std::vector<node>, Ntk> _fanout;
+  /* shared, like a node_map, such that copies of the view see updates */
+  std::shared_ptr<detail::packed_fanout_storage> _fanout;
   fanout_view_params _ps;
 };
 
@@ -33,12 +33,22 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/names_storage.hpp"
 
-#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace mockturtle
 {
 
+/*! \brief Assigns names to signals and outputs
+ *
+ * Names are interned in a `names_storage`, which stores each name and each
+ * prefix of a hierarchical name (separated by `.`) only once.  Signals and
+ * outputs refer to their names by ids, which are kept in vectors indexed by
+ * node index and output index, respectively.
+ */
 template<class Ntk>
 class names_view : public Ntk
 {
@@ -55,6 +65,7 @@ public:
 
   names_view( names_view<Ntk> const& named_ntk )
     : Ntk( named_ntk )
+    , _names( named_ntk._names )
     , _signal_names( named_ntk._signal_names )
     , _output_names( named_ntk._output_names )
   {
@@ -62,14 +73,22 @@ public:
 
   names_view<Ntk>& operator=( names_view<Ntk> const& named_ntk )
   {
-    std::map<signal, std::string> new_signal_names;
-    std::vector<signal> current_pis;
-    Ntk::foreach_pi( [&]( auto const& n ) {
-        current_pis.emplace_back( Ntk::make_signal( n ) );
+    std::vector<uint32_t> current_names;
+    Ntk::foreach_pi( [&]( node const& n ) {
+        current_names.push_back( name_id( Ntk::make_signal( n ) ) );
       });
-    named_ntk.foreach_pi( [&]( auto const& n, auto i ) {
-        if ( const auto it = _signal_names.find( current_pis[i] ); it != _signal_names.end() )
-          new_signal_names[named_ntk.make_signal( n )] = it->second;
+
+    std::vector<uint32_t> new_signal_names;
+    named_ntk.foreach_pi( [&]( node const& n, uint32_t i ) {
+        if ( i < current_names.size() && current_names[i] != names_storage::root )
+        {
+          const auto index = signal_index( named_ntk.make_signal( n ) );
+          if ( index >= new_signal_names.size() )
+          {
+            new_signal_names.resize( index + 1u, names_storage::root );
+          }
+          new_signal_names[index] = current_names[i];
+        }
       } );
 
     Ntk::operator=( named_ntk );
@@ -99,37 +118,75 @@ public:
 
   bool has_name( signal const& s ) const
   {
-    return ( _signal_names.find( s ) != _signal_names.end() );
+    return name_id( s ) != names_storage::root;
   }
 
   void set_name( signal const& s, std::string const& name )
   {
-    _signal_names[s] = name;
+    const auto index = signal_index( s );
+    if ( index >= _signal_names.size() )
+    {
+      _signal_names.resize( index + 1u, names_storage::root );
+    }
+    _signal_names[index] = _names.insert( name );
   }
 
   std::string get_name( signal const& s ) const
   {
-    return _signal_names.at( s );
+    const auto id = name_id( s );
+    if ( id == names_storage::root )
+    {
+      throw std::out_of_range( "signal has no name" );
+    }
+    return _names[id];
   }
 
   bool has_output_name( uint32_t index ) const
   {
-    return ( _output_names.find( index ) != _output_names.end() );
+    return index < _output_names.size() && _output_names[index] != names_storage::root;
   }
 
   void set_output_name( uint32_t index, std::string const& name )
   {
-    _output_names[index] = name;
+    if ( index >= _output_names.size() )
+    {
+      _output_names.resize( index + 1u, names_storage::root );
+    }
+    _output_names[index] = _names.insert( name );
   }
 
   std::string get_output_name( uint32_t index ) const
   {
-    return _output_names.at( index );
+    if ( !has_output_name( index ) )
+    {
+      throw std::out_of_range( "output has no name" );
+    }
+    return _names[_output_names[index]];
+  }
+
+  /*! \brief Returns the storage in which all names are interned. */
+  names_storage const& names() const
+  {
+    return _names;
+  }
+
+private:
+  /* names are assigned to signals, i.e., a node and its complement can have different names */
+  uint64_t signal_index( signal const& s ) const
+  {
+    return 2u * static_cast<uint64_t>( Ntk::node_to_index( Ntk::get_node( s ) ) ) + ( Ntk::is_complemented( s ) ? 1u : 0u );
+  }
+
+  uint32_t name_id( signal const& s ) const
+  {
+    const auto index = signal_index( s );
+    return index < _signal_names.size() ? _signal_names[index] : names_storage::root;
   }
 
 private:
-  std::map<signal, std::string> _signal_names;
-  std::map<uint32_t, std::string> _output_names;
+  names_storage _names;
+  std::vector<uint32_t> _signal_names; /* name id by signal index, or root */
+  std::vector<uint32_t> _output_names; /* name id by output index, or root */
 }; /* names_view */
 
 template<class T>
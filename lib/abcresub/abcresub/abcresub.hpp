@@ -1329,7 +1329,7 @@ inline Vec_Int_t * Gia_ManResubOne( Vec_Ptr_t * vDivs, int nWords, int nLimit, i
   SeeAlso     []
 
 ***********************************************************************/
-static Gia_ResbMan_t * s_pResbMan = NULL;
+static thread_local Gia_ResbMan_t * s_pResbMan = NULL;
 
 inline void Abc_ResubPrepareManager( int nWords )
 {
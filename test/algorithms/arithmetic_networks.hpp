@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <mockturtle/generators/arithmetic.hpp>
+
+namespace mockturtle
+{
+
+template<class Ntk>
+Ntk make_adder( uint32_t num_bits, bool lookahead )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( num_bits ), b( num_bits );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+
+  if ( lookahead )
+  {
+    carry_lookahead_adder_inplace( ntk, a, b, carry );
+  }
+  else
+  {
+    carry_ripple_adder_inplace( ntk, a, b, carry );
+  }
+
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  return ntk;
+}
+
+template<class Ntk>
+Ntk make_multiplier( uint32_t num_bits, bool swap_operands )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( num_bits ), b( num_bits );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  for ( auto const& f : swap_operands ? carry_ripple_multiplier( ntk, b, a ) : carry_ripple_multiplier( ntk, a, b ) )
+  {
+    ntk.create_po( f );
+  }
+  return ntk;
+}
+
+} // namespace mockturtle
@@ -1,12 +1,19 @@
 #include <catch.hpp>
 
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
 #include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration/spectr_cut.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/random_logic_generator.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 
 using namespace mockturtle;
 
@@ -176,6 +183,135 @@ TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
   }
 }
 
+template<bool ComputeTruth, typename CutData, class Ntk>
+void check_parallel_cut_enumeration( Ntk const& ntk, uint32_t cut_size = 4u )
+{
+  cut_enumeration_params ps;
+  ps.cut_size = cut_size;
+  const auto expected = cut_enumeration<Ntk, ComputeTruth, CutData>( ntk, ps );
+
+  for ( auto num_threads : {2u, 3u, 0u} )
+  {
+    ps.num_threads = num_threads;
+    const auto cuts = cut_enumeration<Ntk, ComputeTruth, CutData>( ntk, ps );
+
+    CHECK( cuts.total_cuts() == expected.total_cuts() );
+    CHECK( cuts.total_tuples() == expected.total_tuples() );
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const& set = cuts.cuts( ntk.node_to_index( n ) );
+      auto const& expected_set = expected.cuts( ntk.node_to_index( n ) );
+      REQUIRE( set.size() == expected_set.size() );
+      for ( auto i = 0u; i < set.size(); ++i )
+      {
+        CHECK( std::equal( set[i].begin(), set[i].end(), expected_set[i].begin(), expected_set[i].end() ) );
+        if constexpr ( ComputeTruth )
+        {
+          CHECK( set[i]->func_id == expected_set[i]->func_id );
+          CHECK( cuts.truth_table( set[i] ) == expected.truth_table( expected_set[i] ) );
+        }
+      }
+    } );
+  }
+}
+
+TEST_CASE( "parallel cut enumeration is deterministic", "[cut_enumeration]" )
+{
+  const auto aig = default_random_aig_generator().generate( 12u, 400u );
+  check_parallel_cut_enumeration<false, empty_cut_data>( aig );
+  check_parallel_cut_enumeration<true, empty_cut_data>( aig );
+  check_parallel_cut_enumeration<true, empty_cut_data>( aig, 7u );
+
+  /* the spectral cut cost function reads the truth table of the new cut */
+  check_parallel_cut_enumeration<true, cut_enumeration_spectr_cut>( aig );
+
+  const auto mig = mixed_random_mig_generator().generate( 10u, 200u );
+  check_parallel_cut_enumeration<true, empty_cut_data>( mig );
+}
+
+template<class Ntk>
+void check_cut_functions( Ntk const& ntk, uint32_t cut_size, bool minimize_truth_table )
+{
+  cut_enumeration_params ps;
+  ps.cut_size = cut_size;
+  ps.cut_limit = 12u;
+  ps.minimize_truth_table = minimize_truth_table;
+  const auto cuts = cut_enumeration<Ntk, true>( ntk, ps );
+
+  /* the function of a node must be the cut function applied to the functions of the leaves */
+  default_simulator<kitty::dynamic_truth_table> sim( ntk.num_pis() );
+  const auto node_tts = simulate_nodes<kitty::dynamic_truth_table>( ntk, sim );
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    for ( auto const& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    {
+      const auto tt = cuts.truth_table( *cut );
+      REQUIRE( tt.num_vars() == cut->size() );
+
+      auto composed = node_tts[n].construct();
+      for ( auto bit = 0u; bit < composed.num_bits(); ++bit )
+      {
+        uint64_t pattern{0u}, i{0u};
+        for ( auto leaf : *cut )
+        {
+          pattern |= static_cast<uint64_t>( kitty::get_bit( node_tts[ntk.index_to_node( leaf )], bit ) ) << i++;
+        }
+        if ( kitty::get_bit( tt, pattern ) )
+        {
+          kitty::set_bit( composed, bit );
+        }
+      }
+      CHECK( composed == node_tts[n] );
+
+      if ( minimize_truth_table )
+      {
+        auto tt_min = tt;
+        CHECK( kitty::min_base_inplace( tt_min ).size() == cut->size() );
+      }
+    }
+  } );
+}
+
+TEST_CASE( "compute truth tables of cuts with up to 6 and more leaves", "[cut_enumeration]" )
+{
+  const auto aig = default_random_aig_generator().generate( 10u, 200u );
+  const auto mig = mixed_random_mig_generator().generate( 10u, 150u );
+
+  for ( auto cut_size : {3u, 6u, 7u} )
+  {
+    check_cut_functions( aig, cut_size, false );
+    check_cut_functions( aig, cut_size, true );
+    check_cut_functions( mig, cut_size, false );
+    check_cut_functions( mig, cut_size, true );
+  }
+}
+
+namespace
+{
+
+/* AIG that only computes dynamic truth tables */
+struct dynamic_compute_aig : aig_network
+{
+  using aig_network::aig_network;
+
+  template<typename Iterator, typename = std::enable_if_t<std::is_same_v<typename std::iterator_traits<Iterator>::value_type, kitty::dynamic_truth_table>>>
+  kitty::dynamic_truth_table compute( node const& n, Iterator begin, Iterator end ) const
+  {
+    return aig_network::compute( n, begin, end );
+  }
+};
+
+} // namespace
+
+TEST_CASE( "compute truth tables of cuts in a network without word computation", "[cut_enumeration]" )
+{
+  static_assert( has_compute_v<dynamic_compute_aig, kitty::dynamic_truth_table> );
+  static_assert( !has_compute_v<dynamic_compute_aig, kitty::static_truth_table<6>> );
+
+  const dynamic_compute_aig aig{default_random_aig_generator().generate( 10u, 200u )._storage};
+  check_cut_functions( aig, 4u, false );
+  check_cut_functions( aig, 6u, true );
+}
+
 TEST_CASE( "enumerate cuts for an AIG (small graph version)", "[fast_small_cut_enumeration]" )
 {
   aig_network aig;
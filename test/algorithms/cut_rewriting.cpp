@@ -7,6 +7,8 @@
 #include <mockturtle/algorithms/node_resynthesis/xag_minmc2.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/views/fanout_view.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
@@ -17,6 +19,10 @@
 #include <mockturtle/utils/cost_functions.hpp>
 #include <mockturtle/traits.hpp>
 
+#include <kitty/static_truth_table.hpp>
+
+#include <algorithm>
+
 using namespace mockturtle;
 
 TEST_CASE( "In-place cut rewriting of bad MAJ", "[cut_rewriting]" )
@@ -461,3 +467,48 @@ TEST_CASE( "Cut rewriting with stacked depth-fanout views", "[cut_rewriting]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "In-place cut rewriting with several threads", "[cut_rewriting]" )
+{
+  const auto build = []( auto& ntk ) {
+    std::vector<typename std::decay_t<decltype( ntk )>::signal> a( 4 ), b( 4 );
+    std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+    std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+    for ( auto const& f : carry_ripple_multiplier( ntk, a, b ) )
+    {
+      ntk.create_po( f );
+    }
+    auto carry = ntk.get_constant( false );
+    carry_ripple_adder_inplace( ntk, a, b, carry );
+    for ( auto const& f : a )
+    {
+      ntk.create_po( f );
+    }
+  };
+
+  const auto check = [&]( auto ntk ) {
+    using ntk_t = decltype( ntk );
+    build( ntk );
+    const auto expected = simulate<kitty::static_truth_table<8u>>( ntk );
+
+    xag_npn_resynthesis<ntk_t> resyn;
+    cut_rewriting_params ps;
+    ps.cut_enumeration_ps.cut_size = 4;
+
+    auto serial = cleanup_dangling( ntk );
+    cut_rewriting_with_compatibility_graph( serial, resyn, ps );
+    serial = cleanup_dangling( serial );
+
+    ps.num_threads = 3u;
+    auto parallel = cleanup_dangling( ntk );
+    cut_rewriting_with_compatibility_graph( parallel, resyn, ps );
+    parallel = cleanup_dangling( parallel );
+
+    CHECK( parallel.num_gates() < ntk.num_gates() );
+    CHECK( parallel.num_gates() == serial.num_gates() );
+    CHECK( simulate<kitty::static_truth_table<8u>>( parallel ) == expected );
+  };
+
+  check( aig_network{} );
+  check( xag_network{} );
+}
@@ -51,3 +51,38 @@ TEST_CASE( "Find multiple ITE with exact MC synthesis", "[exact_mc_synthesis]" )
     CHECK( simulate<kitty::dynamic_truth_table>( xag, {3u} )[0] == func );
   }
 }
+
+TEST_CASE( "Exact MC synthesis with portfolio solving", "[exact_mc_synthesis]" )
+{
+  const auto test_one = [&]( uint32_t num_vars, const std::string& expression, uint32_t num_ands ) {
+    kitty::dynamic_truth_table func( num_vars );
+    kitty::create_from_expression( func, expression );
+
+    for ( auto num_threads : {0u, 2u, 5u} )
+    {
+      exact_mc_synthesis_params ps;
+      ps.num_threads = num_threads;
+      const auto xag = exact_mc_synthesis<xag_network>( func, ps );
+      CHECK( simulate<kitty::dynamic_truth_table>( xag, {num_vars} )[0] == func );
+      CHECK( *multiplicative_complexity( xag ) == num_ands );
+    }
+  };
+
+  test_one( 3u, "<abc>", 1u );
+  test_one( 4u, "(abcd)", 3u );
+  test_one( 3u, "[(ab)(!ac)]", 1u );
+  test_one( 4u, "{(ab)(cd)}", 3u );
+
+  kitty::dynamic_truth_table maj( 3 );
+  kitty::create_majority( maj );
+
+  exact_mc_synthesis_params ps;
+  ps.num_threads = 3u;
+  ps.portfolio = {{bill::solvers::bsat2, false}, {bill::solvers::ghack, false}, {bill::solvers::glucose_41, false}};
+  const auto xags = exact_mc_synthesis_multiple<xag_network>( maj, 3u, ps );
+  CHECK( xags.size() == 2u );
+  for ( auto const& xag : xags )
+  {
+    CHECK( simulate<kitty::dynamic_truth_table>( xag, {3u} )[0] == maj );
+  }
+}
@@ -5,6 +5,9 @@
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/algorithms/functional_reduction.hpp>
 #include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/sweeping_equivalence_checking.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
@@ -129,3 +132,72 @@ TEST_CASE( "functional reduction on XMG", "[functional_reduction]" )
   CHECK( ntk.size() == 9 );
   CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
 }
+
+TEST_CASE( "parallel functional reduction on AIG", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( a, !b );
+  const auto f2 = ntk.create_and( !a, b );
+  const auto f3 = ntk.create_and( !a, !b );
+  const auto f4 = ntk.create_and( a, b );
+  const auto f5 = ntk.create_or( f1, f2 ); // a ^ b
+  const auto f6 = ntk.create_or( f3, f4 ); // a == b
+  const auto f7 = ntk.create_and( f5, f6 ); // 0
+
+  ntk.create_po( f5 );
+  ntk.create_po( f6 );
+  ntk.create_po( f7 );
+
+  auto vals = simulate<kitty::static_truth_table<2>>( ntk );
+
+  functional_reduction_params ps;
+  ps.num_threads = 2u;
+  functional_reduction_stats st;
+  functional_reduction( ntk, ps, &st );
+  ntk = cleanup_dangling( ntk );
+  CHECK( ntk.size() == 6 );
+  CHECK( st.num_const_accepts == 1u );
+  CHECK( vals == simulate<kitty::static_truth_table<2>>( ntk ) );
+}
+
+TEST_CASE( "parallel functional reduction of two adders", "[functional_reduction]" )
+{
+  aig_network ntk;
+  std::vector<aig_network::signal> a( 16u ), b( 16u );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  auto a1 = a, a2 = a;
+  auto c1 = ntk.get_constant( false ), c2 = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, a1, b, c1 );
+  carry_lookahead_adder_inplace( ntk, a2, b, c2 );
+  std::for_each( a1.begin(), a1.end(), [&]( auto f ) { ntk.create_po( f ); } );
+  std::for_each( a2.begin(), a2.end(), [&]( auto f ) { ntk.create_po( f ); } );
+  const auto orig = ntk;
+
+  for ( auto num_threads : {2u, 3u} )
+  {
+    auto copy = cleanup_dangling( orig );
+
+    functional_reduction_params ps;
+    ps.num_threads = num_threads;
+    ps.batch_size = 16u;
+    functional_reduction_stats st;
+    functional_reduction( copy, ps, &st );
+    copy = cleanup_dangling( copy );
+
+    CHECK( st.num_equ_accepts > 0u );
+    CHECK( copy.num_gates() < orig.num_gates() );
+    CHECK( *sweeping_equivalence_checking( *miter<aig_network>( orig, copy ) ) );
+
+    /* both adders are merged into one */
+    for ( auto i = 0u; i < 16u; ++i )
+    {
+      CHECK( copy.po_at( i ) == copy.po_at( i + 16u ) );
+    }
+  }
+}
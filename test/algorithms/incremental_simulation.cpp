@@ -0,0 +1,131 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/incremental_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/random_logic_generator.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <random>
+
+using namespace mockturtle;
+
+template<class Ntk, class Simulator>
+void check_signatures( Ntk const& ntk, incremental_simulator<Ntk, Simulator>& isim, Simulator const& sim )
+{
+  unordered_node_map<kitty::partial_truth_table, Ntk> expected( ntk );
+  simulate_nodes( ntk, expected, sim, true );
+
+  isim.update();
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( isim.get( n ) == expected[n] );
+  } );
+}
+
+TEST_CASE( "Incremental simulation after node substitution", "[incremental_simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( c, d );
+  const auto f4 = aig.create_or( f2, f3 );
+  aig.create_po( f4 );
+
+  fanout_view fanout_aig{aig};
+  partial_simulator sim( 4u, 100u );
+  incremental_simulator isim( fanout_aig, sim );
+  CHECK( isim.num_simulated_gates() == 0u );
+  check_signatures( fanout_aig, isim, sim );
+
+  /* new gates are simulated when they are created */
+  const auto g = fanout_aig.create_xor( a, d );
+  CHECK( isim.num_simulated_gates() == 3u );
+
+  /* only the transitive fanout of f1 is re-simulated */
+  fanout_aig.substitute_node( aig.get_node( f1 ), g );
+  check_signatures( fanout_aig, isim, sim );
+  CHECK( isim.num_simulated_gates() == 5u );
+  CHECK( isim.get( f4 ) == ( ( ( sim.compute_pi( 0u ) ^ sim.compute_pi( 3u ) ) & sim.compute_pi( 2u ) ) | ( sim.compute_pi( 2u ) & sim.compute_pi( 3u ) ) ) );
+
+  /* appended patterns are simulated for all gates */
+  sim.add_pattern( {true, false, true, false} );
+  check_signatures( fanout_aig, isim, sim );
+  CHECK( isim.get( f4 ).num_bits() == 101u );
+  CHECK( kitty::get_bit( isim.get( f4 ), 100u ) );
+}
+
+TEST_CASE( "Incremental simulation with random substitutions", "[incremental_simulation]" )
+{
+  auto aig = default_random_aig_generator().generate( 12u, 300u );
+  fanout_view fanout_aig{aig};
+
+  partial_simulator sim( aig.num_pis(), 130u );
+  incremental_simulator isim( fanout_aig, sim );
+
+  std::default_random_engine gen( 42u );
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    std::vector<aig_network::node> gates;
+    fanout_aig.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+    if ( gates.size() < 2u )
+    {
+      break;
+    }
+
+    /* replace a gate by the AND of one of its fanins and a different PI */
+    const auto n = gates[std::uniform_int_distribution<std::size_t>( 1u, gates.size() - 1u )( gen )];
+    std::vector<aig_network::signal> fanins;
+    fanout_aig.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.push_back( f );
+    } );
+    auto pi = fanout_aig.make_signal( fanout_aig.pi_at( std::uniform_int_distribution<uint32_t>( 0u, aig.num_pis() - 1u )( gen ) ) );
+    if ( fanout_aig.get_node( pi ) == fanout_aig.get_node( fanins[1] ) )
+    {
+      continue;
+    }
+    fanout_aig.substitute_node( n, fanout_aig.create_and( fanins[0], !pi ) );
+
+    if ( i % 4u == 0u )
+    {
+      std::vector<bool> pattern( aig.num_pis() );
+      for ( auto j = 0u; j < pattern.size(); ++j )
+      {
+        pattern[j] = ( gen() & 1 ) != 0;
+      }
+      sim.add_pattern( pattern );
+    }
+
+    check_signatures( fanout_aig, isim, sim );
+  }
+}
+
+TEST_CASE( "Incremental simulation of MIGs", "[incremental_simulation]" )
+{
+  auto mig = mixed_random_mig_generator().generate( 10u, 200u );
+  fanout_view fanout_mig{mig};
+
+  partial_simulator sim( mig.num_pis(), 64u );
+  incremental_simulator isim( fanout_mig, sim );
+
+  std::vector<mig_network::node> gates;
+  fanout_mig.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+  fanout_mig.substitute_node( gates[gates.size() / 2u], fanout_mig.create_maj( mig.make_signal( gates[0] ), mig.make_signal( gates[1] ), !mig.make_signal( gates[2] ) ) );
+
+  for ( auto i = 0u; i < 70u; ++i )
+  {
+    sim.add_pattern( std::vector<bool>( mig.num_pis(), i % 2u == 0u ) );
+  }
+  check_signatures( fanout_mig, isim, sim );
+}
@@ -1,9 +1,12 @@
 #include <catch.hpp>
 
 #include <mockturtle/traits.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
 #include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/views/mapping_view.hpp>
 
 using namespace mockturtle;
@@ -141,3 +144,64 @@ TEST_CASE( "LUT mapping with functions of full adder", "[lut_mapping]" )
   CHECK( mapped_aig.cell_function( aig.get_node( sum ) )._bits[0] == 0x96 );
   CHECK( mapped_aig.cell_function( aig.get_node( carry ) )._bits[0] == 0x17 );
 }
+
+TEST_CASE( "Parallel LUT mapping", "[lut_mapping]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 16u ), b( 16u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  const auto cells_of = []( mapping_view<aig_network, true> const& mapped ) {
+    std::vector<std::vector<uint32_t>> cells( mapped.size() );
+    mapped.foreach_gate( [&]( auto n ) {
+      if ( mapped.is_cell_root( n ) )
+      {
+        mapped.foreach_cell_fanin( n, [&]( auto fanin ) {
+          cells[mapped.node_to_index( n )].push_back( mapped.node_to_index( fanin ) );
+        } );
+      }
+    } );
+    return cells;
+  };
+
+  const auto map = [&]( uint32_t num_threads, uint32_t rounds_ela ) {
+    mapping_view<aig_network, true> mapped{aig};
+    lut_mapping_params ps;
+    ps.num_threads = num_threads;
+    ps.rounds_ela = rounds_ela;
+    lut_mapping<mapping_view<aig_network, true>, true>( mapped, ps );
+
+    /* the mapping is a cover of the network */
+    mapped.foreach_po( [&]( auto f ) {
+      CHECK( ( mapped.is_pi( mapped.get_node( f ) ) || mapped.is_constant( mapped.get_node( f ) ) || mapped.is_cell_root( mapped.get_node( f ) ) ) );
+    } );
+    mapped.foreach_gate( [&]( auto n ) {
+      if ( mapped.is_cell_root( n ) )
+      {
+        mapped.foreach_cell_fanin( n, [&]( auto fanin ) {
+          CHECK( ( mapped.is_pi( fanin ) || mapped.is_constant( fanin ) || mapped.is_cell_root( fanin ) ) );
+        } );
+      }
+    } );
+    CHECK( simulate<kitty::partial_truth_table>( *collapse_mapped_network<klut_network>( mapped ), partial_simulator( 32u, 256u, 7u ) ) == simulate<kitty::partial_truth_table>( aig, partial_simulator( 32u, 256u, 7u ) ) );
+
+    return cells_of( mapped );
+  };
+
+  /* delay and area flow rounds give the same mapping as the sequential mapper */
+  CHECK( map( 1u, 0u ) == map( 3u, 0u ) );
+
+  /* exact area rounds are reproducible for a fixed number of threads */
+  for ( auto num_threads : {2u, 4u} )
+  {
+    CHECK( map( num_threads, 1u ) == map( num_threads, 1u ) );
+  }
+}
@@ -80,3 +80,27 @@ TEST_CASE( "check equivalence of AIG and XAG as k-LUT miter", "[miter]" )
 
   CHECK( simulate<kitty::static_truth_table<2u>>( *miter_ntk )[0]._bits == 0b0000 );
 }
+
+TEST_CASE( "miter with one output per output pair", "[miter]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  aig.create_po( aig.create_and( a, b ) );
+  aig.create_po( aig.create_or( a, b ) );
+
+  xag_network xag;
+  const auto c = xag.create_pi();
+  const auto d = xag.create_pi();
+  xag.create_po( xag.create_and( c, d ) );
+  xag.create_po( xag.create_xor( c, d ) );
+
+  auto miter_ntk = miter<aig_network>( aig, xag, false );
+
+  CHECK( miter_ntk );
+  CHECK( miter_ntk->num_pos() == 2u );
+
+  const auto tts = simulate<kitty::static_truth_table<2u>>( *miter_ntk );
+  CHECK( tts[0]._bits == 0b0000 );
+  CHECK( tts[1]._bits == 0b1000 );
+}
@@ -360,3 +360,38 @@ TEST_CASE( "Node resynthesis with direct synthesis", "[node_resynthesis]" )
     CHECK( simulate<kitty::dynamic_truth_table>( xmg, {3u} )[0] == tt );
   }
 }
+
+template<class Ntk, class ResynFn>
+void check_npn_resynthesis( ResynFn const& resyn )
+{
+  for ( auto word = 0u; word < ( 1u << 16u ); word += 251u )
+  {
+    kitty::dynamic_truth_table tt( 4u );
+    kitty::create_from_words( tt, &word, &word + 1 );
+
+    Ntk ntk;
+    std::vector<signal<Ntk>> pis( 4u );
+    std::generate( pis.begin(), pis.end(), [&]() { return ntk.create_pi(); } );
+    resyn( ntk, tt, pis.begin(), pis.end(), [&]( auto const& f ) {
+      ntk.create_po( f );
+      return true;
+    } );
+
+    CHECK( ntk.num_pos() > 0u );
+    for ( auto const& po_tt : simulate<kitty::dynamic_truth_table>( ntk, {4u} ) )
+    {
+      CHECK( po_tt == tt );
+    }
+  }
+}
+
+TEST_CASE( "Node resynthesis with shared NPN databases", "[node_resynthesis]" )
+{
+  /* all instances read the same databases */
+  for ( auto i = 0u; i < 2u; ++i )
+  {
+    check_npn_resynthesis<mig_network>( mig_npn_resynthesis{} );
+    check_npn_resynthesis<mig_network>( mig_npn_resynthesis{true} );
+    check_npn_resynthesis<xmg_network>( xmg_npn_resynthesis{} );
+  }
+}
@@ -1,12 +1,23 @@
 #include <catch.hpp>
 
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/print.hpp>
 
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/chain_store.hpp>
 
 using namespace mockturtle;
 
@@ -170,3 +181,197 @@ TEST_CASE( "Exact XMG for XOR3", "[exact]" )
   CHECK( xmg.num_gates() == 1u );
   CHECK( simulate<kitty::dynamic_truth_table>( xmg, sim )[0] == _xor );
 }
+
+template<class Ntk, class ResynFn>
+void check_exact_functions( ResynFn const& resyn, std::vector<kitty::dynamic_truth_table> const& functions, uint32_t expected_gates )
+{
+  for ( auto const& function : functions )
+  {
+    Ntk ntk;
+    std::vector<signal<Ntk>> pis;
+    for ( auto i = 0u; i < function.num_vars(); ++i )
+    {
+      pis.push_back( ntk.create_pi() );
+    }
+
+    resyn( ntk, function, pis.begin(), pis.end(), [&]( auto const& f ) {
+      ntk.create_po( f );
+      return false;
+    } );
+
+    default_simulator<kitty::dynamic_truth_table> sim( function.num_vars() );
+    CHECK( ntk.num_pos() == 1u );
+    CHECK( ntk.num_gates() == expected_gates );
+    CHECK( simulate<kitty::dynamic_truth_table>( ntk, sim )[0] == function );
+  }
+}
+
+/* returns the number of gates for each function and checks the synthesized networks by simulation */
+template<class Ntk, class ResynFn>
+std::vector<uint32_t> simulate_exact_functions( ResynFn const& resyn, std::vector<kitty::dynamic_truth_table> const& functions )
+{
+  std::vector<uint32_t> num_gates;
+  for ( auto const& function : functions )
+  {
+    Ntk ntk;
+    std::vector<signal<Ntk>> pis;
+    for ( auto i = 0u; i < function.num_vars(); ++i )
+    {
+      pis.push_back( ntk.create_pi() );
+    }
+
+    resyn( ntk, function, pis.begin(), pis.end(), [&]( auto const& f ) {
+      ntk.create_po( f );
+      return false;
+    } );
+
+    default_simulator<kitty::dynamic_truth_table> sim( function.num_vars() );
+    CHECK( ntk.num_pos() == 1u );
+    CHECK( simulate<kitty::dynamic_truth_table>( ntk, sim )[0] == function );
+    num_gates.push_back( ntk.num_gates() );
+  }
+  return num_gates;
+}
+
+/* all functions of the NPN class of `hex`, obtained by swapping and flipping inputs and complementing the output */
+std::vector<kitty::dynamic_truth_table> npn_class_of( std::string const& hex, uint32_t num_vars )
+{
+  kitty::dynamic_truth_table tt( num_vars );
+  kitty::create_from_hex_string( tt, hex );
+
+  std::set<std::string> visited{kitty::to_hex( tt )};
+  std::vector<kitty::dynamic_truth_table> functions{tt};
+  for ( auto i = 0u; i < functions.size(); ++i )
+  {
+    std::vector<kitty::dynamic_truth_table> next{~functions[i]};
+    for ( auto v = 0u; v < num_vars; ++v )
+    {
+      next.push_back( kitty::flip( functions[i], static_cast<uint8_t>( v ) ) );
+      if ( v + 1u < num_vars )
+      {
+        next.push_back( kitty::swap( functions[i], static_cast<uint8_t>( v ), static_cast<uint8_t>( v + 1u ) ) );
+      }
+    }
+    for ( auto const& f : next )
+    {
+      if ( visited.insert( kitty::to_hex( f ) ).second )
+      {
+        functions.push_back( f );
+      }
+    }
+  }
+  return functions;
+}
+
+TEST_CASE( "Exact resynthesis with a persistent chain store", "[exact]" )
+{
+  const std::string filename = "mockturtle-test-exact-chains.bin";
+  std::remove( filename.c_str() );
+
+  /* NPN variants of the majority function */
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto const& hex : {"e8", "d4", "b2", "8e", "17", "2b", "4d", "71"} )
+  {
+    functions.emplace_back( 3u );
+    kitty::create_from_hex_string( functions.back(), hex );
+  }
+
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    exact_resynthesis_params ps;
+    ps.store = std::make_shared<chain_store>( filename );
+    CHECK( ps.store->size() == ( run == 0u ? 0u : 3u ) );
+
+    check_exact_functions<aig_network>( exact_aig_resynthesis<aig_network>( false, ps ), functions, 4u );
+    check_exact_functions<klut_network>( exact_resynthesis<klut_network>( 2u, ps ), functions, 4u );
+
+    exact_xmg_resynthesis_params xps;
+    xps.store = ps.store;
+    check_exact_functions<xmg_network>( exact_xmg_resynthesis<xmg_network>( xps ), functions, 1u );
+
+    /* one entry per NPN class and kind */
+    CHECK( ps.store->size() == 3u );
+  }
+
+  std::remove( filename.c_str() );
+}
+
+TEST_CASE( "Exact resynthesis of non-symmetric functions with a persistent chain store", "[exact]" )
+{
+  const std::string filename = "mockturtle-test-exact-chains-asym.bin";
+  std::remove( filename.c_str() );
+
+  /* NPN classes of ITE and of x2 ^ (x0 | x1), which are replayed with non-identity permutations */
+  auto functions = npn_class_of( "d8", 3u );
+  const auto xor_or = npn_class_of( "1e", 3u );
+  CHECK( functions.size() == 24u );
+  CHECK( std::find_if( xor_or.begin(), xor_or.end(), []( auto const& f ) { return kitty::to_hex( f ) == "78"; } ) != xor_or.end() );
+  functions.insert( functions.end(), xor_or.begin(), xor_or.end() );
+
+  std::vector<std::vector<uint32_t>> cold_gates;
+  for ( auto run = 0u; run < 2u; ++run )
+  {
+    exact_resynthesis_params ps;
+    ps.store = std::make_shared<chain_store>( filename );
+    CHECK( ps.store->size() == ( run == 0u ? 0u : 6u ) );
+
+    exact_xmg_resynthesis_params xps;
+    xps.store = ps.store;
+
+    std::vector<std::vector<uint32_t>> gates;
+    gates.push_back( simulate_exact_functions<aig_network>( exact_aig_resynthesis<aig_network>( false, ps ), functions ) );
+    gates.push_back( simulate_exact_functions<klut_network>( exact_resynthesis<klut_network>( 2u, ps ), functions ) );
+    gates.push_back( simulate_exact_functions<xmg_network>( exact_xmg_resynthesis<xmg_network>( xps ), functions ) );
+
+    /* one entry per NPN class and kind */
+    CHECK( ps.store->size() == 6u );
+
+    if ( run == 0u )
+    {
+      cold_gates = gates;
+    }
+    else
+    {
+      CHECK( gates == cold_gates );
+    }
+  }
+
+  std::remove( filename.c_str() );
+}
+
+TEST_CASE( "Exact resynthesis with portfolio synthesis", "[exact]" )
+{
+  /* NPN variants of the majority function */
+  std::vector<kitty::dynamic_truth_table> functions;
+  for ( auto const& hex : {"e8", "d4", "b2", "8e", "17", "2b", "4d", "71"} )
+  {
+    functions.emplace_back( 3u );
+    kitty::create_from_hex_string( functions.back(), hex );
+  }
+
+  for ( auto num_threads : {1u, 0u, 2u, 4u} )
+  {
+    exact_resynthesis_params ps;
+    ps.num_threads = num_threads;
+
+    check_exact_functions<aig_network>( exact_aig_resynthesis<aig_network>( false, ps ), functions, 4u );
+    check_exact_functions<xag_network>( exact_aig_resynthesis<xag_network>( true, ps ), functions, 4u );
+    check_exact_functions<klut_network>( exact_resynthesis<klut_network>( 2u, ps ), functions, 4u );
+    check_exact_functions<klut_network>( exact_resynthesis<klut_network>( 3u, ps ), functions, 1u );
+  }
+
+  /* configurations that ignore gate primitives are skipped for AIGs */
+  exact_resynthesis_params ps;
+  ps.num_threads = 2u;
+  ps.portfolio = {{percy::SLV_BSAT2, percy::ENC_MSV, percy::SYNTH_STD},
+                  {percy::SLV_BSAT2, percy::ENC_SSV, percy::SYNTH_STD_CEGAR}};
+  check_exact_functions<aig_network>( exact_aig_resynthesis<aig_network>( false, ps ), functions, 4u );
+
+  /* configurations whose encoder does not support the method are skipped */
+  ps.portfolio = {{percy::SLV_BSAT2, percy::ENC_FENCE, percy::SYNTH_STD},
+                  {percy::SLV_BSAT2, percy::ENC_MSV, percy::SYNTH_FENCE},
+                  {percy::SLV_BSAT2, percy::ENC_MSV, percy::SYNTH_STD}};
+  check_exact_functions<klut_network>( exact_resynthesis<klut_network>( 2u, ps ), functions, 4u );
+  ps.portfolio = {{percy::SLV_BSAT2, percy::ENC_FENCE, percy::SYNTH_STD}};
+  check_exact_functions<klut_network>( exact_resynthesis<klut_network>( 2u, ps ), functions, 4u );
+}
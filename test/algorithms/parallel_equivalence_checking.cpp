@@ -0,0 +1,83 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/parallel_equivalence_checking.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/sweeping_equivalence_checking.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include "arithmetic_networks.hpp"
+
+using namespace mockturtle;
+
+TEST_CASE( "Parallel equivalence check of adders", "[parallel_equivalence_checking]" )
+{
+  const auto adder1 = make_adder<aig_network>( 16u, false );
+  const auto adder2 = make_adder<aig_network>( 16u, true );
+  const auto miter_aig = *miter<aig_network>( adder1, adder2, false );
+  CHECK( miter_aig.num_pos() == 17u );
+
+  for ( auto num_threads : {1u, 2u, 4u} )
+  {
+    parallel_equivalence_checking_params ps;
+    ps.num_threads = num_threads;
+    parallel_equivalence_checking_stats st;
+    const auto result = parallel_equivalence_checking( miter_aig, ps, &st );
+    CHECK( result );
+    CHECK( *result );
+    CHECK( st.output_status == std::vector<miter_output_status>( 17u, miter_output_status::equivalent ) );
+    CHECK( !st.failing_output );
+  }
+
+  /* small groups */
+  parallel_equivalence_checking_params ps;
+  ps.num_threads = 3u;
+  ps.max_group_size = 10u;
+  parallel_equivalence_checking_stats st;
+  CHECK( *parallel_equivalence_checking( miter_aig, ps, &st ) );
+  CHECK( st.num_groups > 1u );
+
+  /* a single-output miter is one group */
+  CHECK( *parallel_equivalence_checking( *miter<aig_network>( adder1, adder2 ), ps, &st ) );
+  CHECK( st.num_groups == 1u );
+}
+
+TEST_CASE( "Parallel equivalence check of non-equivalent networks", "[parallel_equivalence_checking]" )
+{
+  const auto adder = make_adder<xag_network>( 12u, false );
+  auto faulty = make_adder<xag_network>( 12u, true );
+  faulty.substitute_node( faulty.get_node( faulty.po_at( 7u ) ), faulty.create_and( faulty.make_signal( faulty.pi_at( 0u ) ), faulty.make_signal( faulty.pi_at( 12u ) ) ) );
+  const auto miter_xag = *miter<xag_network>( adder, faulty, false );
+
+  for ( auto num_threads : {1u, 2u} )
+  {
+    parallel_equivalence_checking_params ps;
+    ps.num_threads = num_threads;
+    ps.conflict_interval = 10u;
+    parallel_equivalence_checking_stats st;
+    const auto result = parallel_equivalence_checking( miter_xag, ps, &st );
+    CHECK( result );
+    CHECK( !*result );
+    REQUIRE( st.failing_output );
+    CHECK( st.output_status[*st.failing_output] == miter_output_status::not_equivalent );
+
+    default_simulator<bool> sim( st.counter_example );
+    CHECK( simulate<bool>( miter_xag, sim )[*st.failing_output] );
+    CHECK( simulate<bool>( adder, sim ) != simulate<bool>( faulty, sim ) );
+  }
+}
+
+TEST_CASE( "Parallel output checking after SAT sweeping", "[parallel_equivalence_checking]" )
+{
+  const auto miter_aig = *miter<aig_network>( make_adder<aig_network>( 16u, false ), make_adder<aig_network>( 16u, true ), false );
+
+  sweeping_equivalence_checking_params ps;
+  ps.num_threads = 2u;
+  const auto result = sweeping_equivalence_checking( miter_aig, ps );
+  CHECK( result );
+  CHECK( *result );
+}
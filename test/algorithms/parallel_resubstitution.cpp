@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/mig_resub.hpp>
+#include <mockturtle/algorithms/parallel_resubstitution.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/xmg_resub.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/generators/random_logic_generator.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <kitty/static_truth_table.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk, class ResubFn>
+void check_parallel_resubstitution( Ntk ntk, ResubFn&& resub_fn )
+{
+  const auto expected = simulate<kitty::static_truth_table<12u>>( ntk );
+
+  parallel_resubstitution_params ps;
+  ps.num_threads = 3u;
+  ps.max_region_size = 40u;
+  ps.num_passes = 3u;
+  parallel_resubstitution_stats st;
+  parallel_resubstitution( ntk, resub_fn, ps, &st );
+
+  CHECK( st.num_regions > 3u );
+  CHECK( st.final_size == ntk.num_gates() );
+  CHECK( st.final_size <= st.initial_size );
+  CHECK( simulate<kitty::static_truth_table<12u>>( ntk ) == expected );
+}
+
+TEST_CASE( "Parallel resubstitution of random AIGs", "[parallel_resubstitution]" )
+{
+  for ( auto seed = 0u; seed < 4u; ++seed )
+  {
+    const auto aig = default_random_aig_generator().generate( 12u, 300u, seed );
+    check_parallel_resubstitution( aig, []( aig_network& region ) { aig_resubstitution( region ); } );
+  }
+}
+
+TEST_CASE( "Parallel resubstitution of random MIGs", "[parallel_resubstitution]" )
+{
+  for ( auto seed = 0u; seed < 4u; ++seed )
+  {
+    const auto mig = mixed_random_mig_generator().generate( 12u, 300u, seed );
+    check_parallel_resubstitution( mig, []( mig_network& region ) {
+      depth_view depth_mig{region};
+      fanout_view fanout_mig{depth_mig};
+      mig_resubstitution( fanout_mig );
+    } );
+  }
+}
+
+TEST_CASE( "Parallel resubstitution of an XMG adder", "[parallel_resubstitution]" )
+{
+  xmg_network xmg;
+  std::vector<xmg_network::signal> a( 6 ), b( 6 );
+  std::generate( a.begin(), a.end(), [&]() { return xmg.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xmg.create_pi(); } );
+  auto carry = xmg.get_constant( false );
+  carry_ripple_adder_inplace( xmg, a, b, carry );
+  for ( auto const& f : carry_ripple_multiplier( xmg, a, b ) )
+  {
+    xmg.create_po( f );
+  }
+  xmg.create_po( carry );
+
+  check_parallel_resubstitution( xmg, []( xmg_network& region ) {
+    depth_view depth_xmg{region};
+    fanout_view fanout_xmg{depth_xmg};
+    xmg_resubstitution( fanout_xmg );
+  } );
+}
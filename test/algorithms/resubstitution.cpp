@@ -16,6 +16,8 @@
 #include <mockturtle/algorithms/xmg_resub.hpp>
 #include <mockturtle/algorithms/xag_resub_withDC.hpp>
 #include <mockturtle/algorithms/sim_resub.hpp>
+#include <mockturtle/algorithms/parallel_resubstitution.hpp>
+#include <mockturtle/generators/random_logic_generator.hpp>
 
 #include <kitty/static_truth_table.hpp>
 
@@ -205,3 +207,26 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+/* `sim_resub.hpp` can only be included in one test file, hence parallel
+ * simulation-guided resubstitution is tested here */
+TEST_CASE( "Parallel simulation-guided resubstitution of random AIGs", "[resubstitution]" )
+{
+  for ( auto seed = 0u; seed < 4u; ++seed )
+  {
+    auto aig = default_random_aig_generator().generate( 12u, 300u, seed );
+    const auto expected = simulate<kitty::static_truth_table<12u>>( aig );
+
+    parallel_resubstitution_params ps;
+    ps.num_threads = 3u;
+    ps.max_region_size = 40u;
+    ps.num_passes = 3u;
+    parallel_resubstitution_stats st;
+    parallel_resubstitution( aig, []( aig_network& region ) { sim_resubstitution( region ); }, ps, &st );
+
+    CHECK( st.num_regions > 3u );
+    CHECK( st.final_size == aig.num_gates() );
+    CHECK( st.final_size <= st.initial_size );
+    CHECK( simulate<kitty::static_truth_table<12u>>( aig ) == expected );
+  }
+}
@@ -1,8 +1,13 @@
 #include <catch.hpp>
 
 #include <mockturtle/traits.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
 #include <mockturtle/algorithms/satlut_mapping.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/views/mapping_view.hpp>
 
 using namespace mockturtle;
@@ -33,3 +38,44 @@ TEST_CASE( "SAT-LUT mapping of AIG", "[satlut_mapping]" )
 
   satlut_mapping( mapped_aig );
 }
+
+TEST_CASE( "Windowed SAT-LUT mapping with several threads", "[satlut_mapping]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  const auto remap = [&]( uint32_t num_threads ) {
+    mapping_view<aig_network, true> mapped{aig};
+    lut_mapping<mapping_view<aig_network, true>, true>( mapped );
+    const auto cells_init = mapped.num_cells();
+
+    satlut_mapping_params ps;
+    ps.conflict_limit = 1000u;
+    ps.num_threads = num_threads;
+    satlut_mapping<mapping_view<aig_network, true>, true>( mapped, 32u, ps );
+    CHECK( mapped.num_cells() <= cells_init );
+
+    const auto klut = *collapse_mapped_network<klut_network>( mapped );
+    CHECK( simulate<kitty::static_truth_table<16u>>( klut ) == simulate<kitty::static_truth_table<16u>>( aig ) );
+
+    std::vector<std::vector<uint32_t>> cells( mapped.size() );
+    mapped.foreach_gate( [&]( auto n ) {
+      if ( mapped.is_cell_root( n ) )
+      {
+        mapped.foreach_cell_fanin( n, [&]( auto fanin ) {
+          cells[n].push_back( fanin );
+        } );
+      }
+    } );
+    return cells;
+  };
+
+  remap( 1u );
+  CHECK( remap( 3u ) == remap( 3u ) );
+}
@@ -0,0 +1,83 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/simulation_engine.hpp>
+#include <mockturtle/generators/random_logic_generator.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_engine( Ntk const& ntk, uint32_t num_patterns, uint32_t num_threads )
+{
+  partial_simulator sim( ntk.num_pis(), num_patterns );
+
+  unordered_node_map<kitty::partial_truth_table, Ntk> expected( ntk );
+  simulate_nodes( ntk, expected, sim, true );
+
+  simulation_engine_params ps;
+  ps.num_threads = num_threads;
+  ps.min_parallel_gates = 1u;
+  unordered_node_map<kitty::partial_truth_table, Ntk> actual( ntk );
+  simulate_nodes( ntk, actual, sim, ps );
+
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( actual[n] == expected[n] );
+  } );
+}
+
+TEST_CASE( "Simulate AIGs and XAGs with the simulation engine", "[simulation_engine]" )
+{
+  const auto aig = default_random_aig_generator().generate( 16u, 500u );
+  const auto xag = default_random_xag_generator().generate( 16u, 500u );
+
+  for ( auto num_patterns : {1u, 64u, 300u, 1024u} )
+  {
+    check_engine( aig, num_patterns, 1u );
+    check_engine( aig, num_patterns, 3u );
+    check_engine( xag, num_patterns, 1u );
+    check_engine( xag, num_patterns, 3u );
+  }
+}
+
+TEST_CASE( "Simulate MIGs with the simulation engine", "[simulation_engine]" )
+{
+  const auto mig = mixed_random_mig_generator().generate( 16u, 500u );
+
+  check_engine( mig, 200u, 1u );
+  check_engine( mig, 200u, 4u );
+}
+
+TEST_CASE( "Simulate XMGs with the simulation engine", "[simulation_engine]" )
+{
+  xmg_network xmg;
+  const auto a = xmg.create_pi();
+  const auto b = xmg.create_pi();
+  const auto c = xmg.create_pi();
+  const auto d = xmg.create_pi();
+
+  const auto f1 = xmg.create_maj( a, !b, c );
+  const auto f2 = xmg.create_xor3( !f1, b, d );
+  const auto f3 = xmg.create_and( f2, a );
+  const auto f4 = xmg.create_xor3( f3, !c, f1 );
+  xmg.create_po( f4 );
+
+  check_engine( xmg, 130u, 1u );
+  check_engine( xmg, 130u, 2u );
+
+  partial_simulator sim( xmg.num_pis(), 100u );
+  simulation_engine engine( xmg );
+  engine.run( sim );
+  CHECK( engine.num_bits() == 100u );
+  CHECK( engine.num_levels() == 4u );
+
+  const auto pats = sim.get_patterns();
+  const auto maj = ( pats[0] & ~pats[1] ) | ( pats[0] & pats[2] ) | ( ~pats[1] & pats[2] );
+  CHECK( engine.get_signature( f1 ) == maj );
+  CHECK( engine.get_signature( f2 ) == ( ~maj ^ pats[1] ^ pats[3] ) );
+}
@@ -0,0 +1,85 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/sweeping_equivalence_checking.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include "arithmetic_networks.hpp"
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_equivalent( Ntk const& ntk1, Ntk const& ntk2 )
+{
+  const auto miter_ntk = *miter<Ntk>( ntk1, ntk2 );
+
+  sweeping_equivalence_checking_stats st;
+  const auto result = sweeping_equivalence_checking( miter_ntk, {}, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_classes > 0u );
+}
+
+TEST_CASE( "Sweeping equivalence check of adders", "[sweeping_equivalence_checking]" )
+{
+  check_equivalent( make_adder<aig_network>( 16u, false ), make_adder<aig_network>( 16u, true ) );
+  check_equivalent( make_adder<xag_network>( 16u, false ), make_adder<xag_network>( 16u, true ) );
+  check_equivalent( make_adder<mig_network>( 16u, false ), make_adder<mig_network>( 16u, true ) );
+  check_equivalent( make_adder<xmg_network>( 16u, false ), make_adder<xmg_network>( 16u, true ) );
+}
+
+TEST_CASE( "Sweeping equivalence check of multipliers", "[sweeping_equivalence_checking]" )
+{
+  const auto aig1 = make_multiplier<aig_network>( 6u, false );
+  const auto aig2 = make_multiplier<aig_network>( 6u, true );
+  const auto miter_aig = *miter<aig_network>( aig1, aig2 );
+
+  sweeping_equivalence_checking_stats st;
+  const auto result = sweeping_equivalence_checking( miter_aig, {}, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_merged > 0u );
+  CHECK( equivalence_checking( miter_aig ) == result );
+}
+
+TEST_CASE( "Sweeping equivalence check of non-equivalent networks", "[sweeping_equivalence_checking]" )
+{
+  /* the outputs differ only for one pattern, which is unlikely to be simulated */
+  aig_network aig1, aig2;
+  std::vector<aig_network::signal> pis1, pis2;
+  for ( auto i = 0u; i < 24u; ++i )
+  {
+    pis1.push_back( aig1.create_pi() );
+    pis2.push_back( aig2.create_pi() );
+  }
+  aig1.create_po( aig1.create_nary_and( pis1 ) );
+  aig1.create_po( aig1.create_xor( pis1[0], pis1[1] ) );
+  aig2.create_po( aig2.get_constant( false ) );
+  aig2.create_po( aig2.create_xor( pis2[1], pis2[0] ) );
+
+  sweeping_equivalence_checking_stats st;
+  const auto result = sweeping_equivalence_checking( *miter<aig_network>( aig1, aig2 ), {}, &st );
+  CHECK( result );
+  CHECK( !*result );
+  CHECK( st.counter_example == std::vector<bool>( 24u, true ) );
+
+  /* the counter-example of a difference found by simulation */
+  auto adder = make_adder<xag_network>( 8u, false );
+  auto faulty = make_adder<xag_network>( 8u, true );
+  faulty.substitute_node( faulty.get_node( faulty.po_at( 3u ) ), faulty.create_and( faulty.make_signal( faulty.pi_at( 0u ) ), faulty.make_signal( faulty.pi_at( 8u ) ) ) );
+
+  const auto result2 = sweeping_equivalence_checking( *miter<xag_network>( adder, faulty ), {}, &st );
+  CHECK( result2 );
+  CHECK( !*result2 );
+
+  default_simulator<bool> sim( st.counter_example );
+  CHECK( simulate<bool>( adder, sim ) != simulate<bool>( faulty, sim ) );
+}
@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/binary_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include <fstream>
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_binary_roundtrip( std::string const& filename )
+{
+  Ntk ntk;
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto c = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( a, b );
+  const auto f2 = ntk.create_xor( f1, c );
+  const auto f3 = ntk.create_or( f2, !a );
+  ntk.create_po( f2 );
+  ntk.create_po( !f3 );
+
+  /* a dead node */
+  const auto f4 = ntk.create_and( b, c );
+  ntk.take_out_node( ntk.get_node( f4 ) );
+  ntk.set_value( ntk.get_node( f1 ), 42u );
+
+  CHECK( write_binary( ntk, filename ) );
+  const auto loaded = read_binary<Ntk>( filename );
+  REQUIRE( loaded );
+  auto ntk2 = *loaded;
+
+  CHECK( ntk.size() == ntk2.size() );
+  CHECK( ntk.num_pis() == ntk2.num_pis() );
+  CHECK( ntk.num_pos() == ntk2.num_pos() );
+  CHECK( ntk.num_gates() == ntk2.num_gates() );
+  CHECK( ntk._storage->nodes == ntk2._storage->nodes );
+  CHECK( ntk._storage->inputs == ntk2._storage->inputs );
+  CHECK( ntk._storage->outputs == ntk2._storage->outputs );
+  CHECK( ntk2.is_dead( ntk2.get_node( f4 ) ) );
+  CHECK( ntk2.value( ntk2.get_node( f1 ) ) == 42u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( ntk ) == simulate<kitty::static_truth_table<3u>>( ntk2 ) );
+
+  /* structural hashing works on the loaded network */
+  const auto size = ntk2.size();
+  CHECK( ntk2.create_and( b, a ) == f1 );
+  CHECK( ntk2.size() == size );
+  ntk2.create_and( a, c );
+  CHECK( ntk2.size() == size + 1u );
+  CHECK( ntk.size() == size );
+}
+
+TEST_CASE( "write and read AIGs in binary format", "[binary_network]" )
+{
+  check_binary_roundtrip<aig_network>( "aig.mtbn" );
+}
+
+TEST_CASE( "write and read XAGs in binary format", "[binary_network]" )
+{
+  check_binary_roundtrip<xag_network>( "xag.mtbn" );
+}
+
+TEST_CASE( "write and read MIGs in binary format", "[binary_network]" )
+{
+  check_binary_roundtrip<mig_network>( "mig.mtbn" );
+}
+
+TEST_CASE( "write and read XMGs in binary format", "[binary_network]" )
+{
+  check_binary_roundtrip<xmg_network>( "xmg.mtbn" );
+}
+
+TEST_CASE( "write and read k-LUT networks in binary format", "[binary_network]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto d = klut.create_pi();
+
+  kitty::dynamic_truth_table tt( 4u );
+  kitty::create_from_hex_string( tt, "cafe" );
+
+  const auto f1 = klut.create_maj( a, b, c );
+  const auto f2 = klut.create_node( {a, b, c, d}, tt );
+  const auto f3 = klut.create_xor( f1, f2 );
+  klut.create_po( f3 );
+  klut.create_po( f1 );
+
+  CHECK( write_binary( klut, "klut.mtbn" ) );
+  const auto loaded = read_binary<klut_network>( "klut.mtbn" );
+  REQUIRE( loaded );
+  auto klut2 = *loaded;
+
+  CHECK( klut.size() == klut2.size() );
+  CHECK( klut.num_gates() == klut2.num_gates() );
+  CHECK( klut._storage->nodes == klut2._storage->nodes );
+  CHECK( klut._storage->data.cache.size() == klut2._storage->data.cache.size() );
+  CHECK( klut2.node_function( f2 ) == tt );
+  CHECK( klut2.fanin_size( f2 ) == 4u );
+  CHECK( simulate<kitty::static_truth_table<4u>>( klut ) == simulate<kitty::static_truth_table<4u>>( klut2 ) );
+
+  /* structural hashing works on the loaded network */
+  CHECK( klut2.create_node( {a, b, c, d}, tt ) == f2 );
+  CHECK( klut2.size() == klut.size() );
+}
+
+TEST_CASE( "reject invalid binary network files", "[binary_network]" )
+{
+  CHECK( !read_binary<aig_network>( "does_not_exist.mtbn" ) );
+
+  {
+    std::ofstream os( "invalid.mtbn", std::ios::binary );
+    os << "this is not a network";
+  }
+  CHECK( !read_binary<aig_network>( "invalid.mtbn" ) );
+
+  mig_network mig;
+  mig.create_po( mig.create_maj( mig.create_pi(), mig.create_pi(), mig.create_pi() ) );
+  CHECK( write_binary( mig, "mig.mtbn" ) );
+  CHECK( !read_binary<xmg_network>( "mig.mtbn" ) );
+  CHECK( read_binary<mig_network>( "mig.mtbn" ) );
+}
@@ -9,6 +9,10 @@
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+
 using namespace mockturtle;
 
 TEST_CASE( "create and use constants in an AIG", "[aig]" )
@@ -932,3 +936,303 @@ TEST_CASE( "substitute multiple nodes", "[aig]" )
     }
   });
 }
+
+TEST_CASE( "substitute nodes using the fanout index in AIGs", "[aig]" )
+{
+  auto const build = []( aig_network& aig ) {
+    const auto x1 = aig.create_pi();
+    const auto x2 = aig.create_pi();
+    const auto x3 = aig.create_pi();
+
+    const auto f1 = aig.create_nand( x1, x2 );
+    const auto f2 = aig.create_nand( x1, f1 );
+    const auto f3 = aig.create_nand( x2, f1 );
+    const auto f4 = aig.create_nand( f2, f3 );
+    const auto f5 = aig.create_and( f4, x3 );
+    aig.create_po( f4 );
+    aig.create_po( f5 );
+    return std::make_pair( f1, x3 );
+  };
+
+  aig_network aig1, aig2;
+  const auto [f1, x3] = build( aig1 );
+  build( aig2 );
+
+  CHECK( !aig2.has_fanout_index() );
+  aig2.build_fanout_index();
+  CHECK( aig2.has_fanout_index() );
+  CHECK( aig2._storage->fanout.at( aig2.get_node( f1 ) ).size() == 2u );
+
+  /* nodes created after building the index are tracked */
+  const auto g = aig2.create_and( f1, x3 );
+  CHECK( aig2._storage->fanout.at( aig2.get_node( f1 ) ).size() == 3u );
+  aig2.take_out_node( aig2.get_node( g ) );
+  CHECK( aig2._storage->fanout.at( aig2.get_node( f1 ) ).size() == 2u );
+
+  aig1.substitute_node( aig1.get_node( f1 ), x3 );
+  aig2.substitute_node( aig2.get_node( f1 ), x3 );
+
+  CHECK( aig1.num_gates() == aig2.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig1 ) == simulate<kitty::static_truth_table<3u>>( aig2 ) );
+  aig1.foreach_node( [&]( auto const& n ) {
+    CHECK( aig1.fanout_size( n ) == aig2.fanout_size( n ) );
+    CHECK( aig1.is_dead( n ) == aig2.is_dead( n ) );
+  } );
+  CHECK( aig2._storage->fanout.at( aig2.get_node( f1 ) ).empty() );
+
+  aig2.foreach_gate( [&]( auto const& n ) {
+    aig2.foreach_fanin( n, [&]( auto const& f ) {
+      auto const& fanouts = aig2._storage->fanout.at( aig2.get_node( f ) );
+      CHECK( std::find( fanouts.begin(), fanouts.end(), n ) != fanouts.end() );
+    } );
+  } );
+
+  aig2.clear_fanout_index();
+  CHECK( !aig2.has_fanout_index() );
+}
+
+TEST_CASE( "create nodes concurrently in an AIG", "[aig]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 16u );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+  /* hashed before entering the concurrent mode */
+  const auto f = aig.create_and( pis[0], pis[1] );
+
+  aig.begin_concurrent_strash( 1000u );
+  CHECK( aig.is_concurrent_strash() );
+
+  /* pre-allocated node slots are not visible */
+  CHECK( aig.size() == 18u );
+
+  /* all threads create overlapping sets of nodes in different orders */
+  const auto build = [&]( auto& ntk, uint32_t t, std::vector<aig_network::signal>& result ) {
+    for ( auto i = 0u; i < pis.size(); ++i )
+    {
+      for ( auto j = i + 1; j < pis.size(); ++j )
+      {
+        const auto g = ntk.create_and( pis[( i + t ) % pis.size()], !pis[( j + t ) % pis.size()] );
+        result.push_back( ntk.create_and( g, pis[( i + j ) % pis.size()] ) );
+      }
+    }
+    result.push_back( ntk.create_and( pis[1], pis[0] ) );
+  };
+
+  std::vector<std::vector<aig_network::signal>> results( 4u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&, t]() { build( aig, t, results[t] ); } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  /* only created nodes are visible before leaving the mode */
+  const auto concurrent_size = aig.size();
+  uint32_t concurrent_gates{0};
+  aig.foreach_gate( [&]( auto const& ) { ++concurrent_gates; } );
+  CHECK( concurrent_gates + 17u == concurrent_size );
+
+  aig.end_concurrent_strash();
+  CHECK( !aig.is_concurrent_strash() );
+
+  /* compare to sequential construction */
+  aig_network ref;
+  std::vector<aig_network::signal> ref_pis( 16u );
+  std::generate( ref_pis.begin(), ref_pis.end(), [&]() { return ref.create_pi(); } );
+  ref.create_and( ref_pis[0], ref_pis[1] );
+  std::vector<aig_network::signal> ref_result;
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    build( ref, t, ref_result );
+  }
+
+  CHECK( aig.num_gates() == ref.num_gates() );
+  CHECK( aig.size() == ref.size() );
+  CHECK( concurrent_size == ref.size() );
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    CHECK( results[t].back() == f );
+  }
+
+  /* nodes are topologically ordered and have consistent fanout sizes */
+  uint32_t total_fanout{0}, ref_total_fanout{0};
+  aig.foreach_gate( [&]( auto const& n ) {
+    aig.foreach_fanin( n, [&]( auto const& fi ) {
+      CHECK( aig.get_node( fi ) < n );
+    } );
+  } );
+  aig.foreach_node( [&]( auto const& n ) {
+    total_fanout += aig.fanout_size( n );
+  } );
+  ref.foreach_node( [&]( auto const& n ) {
+    ref_total_fanout += ref.fanout_size( n );
+  } );
+  CHECK( total_fanout == ref_total_fanout );
+  CHECK( total_fanout == 2u * aig.num_gates() );
+
+  /* nodes created concurrently are structurally hashed afterwards */
+  const auto num_gates = aig.num_gates();
+  const auto g = aig.create_and( aig.create_and( pis[3], !pis[5] ), pis[8] );
+  CHECK( aig.num_gates() == num_gates );
+  CHECK( std::find( results[0].begin(), results[0].end(), g ) != results[0].end() );
+}
+
+TEST_CASE( "exceed capacity in concurrent AIG mode", "[aig]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  aig.begin_concurrent_strash( 1u );
+  aig.create_and( a, b );
+  CHECK( aig.create_and( a, b ) == aig.create_and( b, a ) );
+  CHECK_THROWS_AS( aig.create_and( a, c ), std::length_error );
+  aig.end_concurrent_strash();
+
+  CHECK( aig.num_gates() == 1u );
+  CHECK( aig.size() == 5u );
+}
+
+TEST_CASE( "structural hashing in compact AIG storage", "[aig]" )
+{
+  CHECK( sizeof( compact_aig_node ) == 8u );
+
+  compact_aig_storage storage;
+  compact_aig_node n1, n2;
+  n1.children[0] = compact_aig_node::pointer_type( 1u, 0u );
+  n1.children[1] = compact_aig_node::pointer_type( 2u, 1u );
+  n2.children[0] = compact_aig_node::pointer_type( 1u, 1u );
+  n2.children[1] = compact_aig_node::pointer_type( 2u, 1u );
+
+  storage.nodes.push_back( n1 );
+  storage.hash.insert( 1u );
+
+  CHECK( storage.hash.find( n1 ) != storage.hash.end() );
+  CHECK( *storage.hash.find( n1 ) == 1u );
+  CHECK( storage.hash.find( n2 ) == storage.hash.end() );
+
+  storage.nodes.push_back( n2 );
+  storage.hash.insert( 2u );
+  CHECK( storage.hash.size() == 2u );
+
+  /* copies rebind the hash table to their own nodes */
+  compact_aig_storage copy( storage );
+  storage.hash.erase( n1 );
+  storage.nodes.clear();
+  CHECK( *copy.hash.find( n1 ) == 1u );
+  CHECK( *copy.hash.find( n2 ) == 2u );
+}
+
+TEST_CASE( "compact AIGs after node substitution", "[aig]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f2, a );
+  aig.create_po( f3 );
+  aig.create_po( f2 );
+  aig.build_fanout_index();
+
+  /* the new node has a larger index than the fanout of f1 */
+  const auto f4 = aig.create_and( b, c );
+  aig.substitute_node( aig.get_node( f1 ), f4 );
+
+  CHECK( aig.size() == 8u );
+  CHECK( aig.num_gates() == 3u );
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+
+  const auto old_to_new = aig.compact();
+  CHECK( old_to_new.size() == 8u );
+  CHECK( old_to_new[aig_network::node( 0 )] == 0u );
+  CHECK( old_to_new[aig.get_node( a )] == 1u );
+  CHECK( old_to_new[aig.get_node( f1 )] == std::numeric_limits<aig_network::node>::max() );
+  CHECK( old_to_new[aig.get_node( f4 )] < old_to_new[aig.get_node( f2 )] );
+
+  CHECK( aig.size() == 7u );
+  CHECK( aig.num_gates() == 3u );
+  aig.foreach_gate( [&]( auto const& n ) {
+    CHECK( !aig.is_dead( n ) );
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( aig.get_node( f ) < n );
+    } );
+  } );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( tts[0]._bits == 0x80 );
+  CHECK( tts[1]._bits == 0xc0 );
+
+  /* structural hashing and fanout index are rebuilt */
+  const auto g = aig.create_and( c, b );
+  CHECK( aig.get_node( g ) == old_to_new[aig.get_node( f4 )] );
+  CHECK( aig.size() == 7u );
+  CHECK( aig.has_fanout_index() );
+  aig.substitute_node( aig.get_node( g ), c );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[1]._bits == 0xf0 );
+}
+
+TEST_CASE( "rollback changes to an AIG", "[aig]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_or( f2, a );
+  aig.create_po( f3 );
+  aig.create_po( !f2 );
+  aig.build_fanout_index();
+
+  aig_network ref{std::make_shared<aig_storage>( *aig._storage )};
+  const auto check_unchanged = [&]() {
+    CHECK( aig.size() == ref.size() );
+    CHECK( aig.num_pis() == ref.num_pis() );
+    CHECK( aig.num_pos() == ref.num_pos() );
+    CHECK( aig._storage->nodes == ref._storage->nodes );
+    CHECK( aig._storage->outputs == ref._storage->outputs );
+    CHECK( aig._storage->hash.size() == ref._storage->hash.size() );
+    ref.foreach_node( [&]( auto const& n ) {
+      CHECK( aig.fanout_size( n ) == ref.fanout_size( n ) );
+      CHECK( aig.is_dead( n ) == ref.is_dead( n ) );
+    } );
+    CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == simulate<kitty::static_truth_table<3u>>( ref ) );
+  };
+
+  aig.checkpoint();
+  CHECK( aig.has_checkpoint() );
+  const auto d = aig.create_pi();
+  const auto g1 = aig.create_and( b, d );
+  aig.create_po( g1 );
+  aig.substitute_node( aig.get_node( f1 ), g1 );
+  aig.substitute_node( aig.get_node( f2 ), aig.create_xor( c, d ) );
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+  CHECK( aig.num_pis() == 4u );
+  aig.rollback();
+
+  CHECK( !aig.has_checkpoint() );
+  check_unchanged();
+
+  /* the structural hash table and the fanout index are restored */
+  CHECK( aig.create_and( b, a ) == f1 );
+  CHECK( aig.create_and( c, f1 ) == f2 );
+  CHECK( aig.size() == ref.size() );
+  aig.substitute_node( aig.get_node( f1 ), a );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[1]._bits == 0x5f );
+
+  /* released changes are kept */
+  aig.checkpoint();
+  aig.create_and( b, c );
+  aig.release_checkpoint();
+  CHECK( !aig.has_checkpoint() );
+  CHECK( aig.size() == ref.size() + 1u );
+}
@@ -573,3 +573,85 @@ TEST_CASE( "visited values in k-LUT networks", "[klut]" )
     CHECK( klut.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "create large LUTs in a k-LUT network", "[klut]" )
+{
+  klut_network klut;
+
+  std::vector<klut_network::signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.push_back( klut.create_pi() );
+  }
+
+  kitty::dynamic_truth_table tt_and( 8u ), tt_xor( 8u ), tt_or( 7u );
+  kitty::create_from_hex_string( tt_and, "8000000000000000000000000000000000000000000000000000000000000000" );
+  kitty::create_parity( tt_xor );
+  kitty::create_from_hex_string( tt_or, "fffffffffffffffffffffffffffffffe" );
+
+  const auto f1 = klut.create_node( pis, tt_and );
+  const auto f2 = klut.create_node( pis, tt_xor );
+  const auto f3 = klut.create_node( {pis.begin(), pis.begin() + 7}, tt_or );
+
+  CHECK( klut.create_node( pis, tt_and ) == f1 );
+  CHECK( klut.size() == 13u );
+  CHECK( klut.fanin_size( f1 ) == 8u );
+  CHECK( klut.fanin_size( f3 ) == 7u );
+  CHECK( klut.node_function( f1 ) == tt_and );
+  CHECK( klut.node_function( f2 ) == tt_xor );
+  CHECK( klut.node_function( f3 ) == tt_or );
+  CHECK( klut.fanout_size( pis[0] ) == 3u );
+
+  std::vector<klut_network::node> fanins;
+  klut.foreach_fanin( f2, [&]( auto const& f ) { fanins.push_back( f ); } );
+  CHECK( fanins == pis );
+
+  /* substitution in large fanin lists */
+  const auto f4 = klut.create_not( pis[0] );
+  klut.substitute_node( klut.get_node( pis[3] ), f4 );
+  fanins.clear();
+  klut.foreach_fanin( f3, [&]( auto const& f ) { fanins.push_back( f ); } );
+  CHECK( fanins[3] == f4 );
+  CHECK( klut.fanout_size( f4 ) == 3u );
+}
+
+TEST_CASE( "structural hashing in compact k-LUT storage", "[klut]" )
+{
+  CHECK( sizeof( compact_klut_node ) == 40u );
+
+  compact_klut_storage storage;
+  compact_klut_node n1, n2;
+  n1.num_fanins = n1.num_vars = 2u;
+  n1.function = 4u;
+  n1.fanins[0] = 1u;
+  n1.fanins[1] = 2u;
+
+  /* a node with fanins in the arena */
+  n2.num_fanins = n2.num_vars = 8u;
+  n2.function = 4u;
+  n2.fanins[0] = storage.fanin_arena.size();
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    storage.fanin_arena.emplace_back( i + 1u );
+  }
+
+  storage.nodes.push_back( n1 );
+  storage.hash.insert( 1u );
+  storage.nodes.push_back( n2 );
+  storage.hash.insert( 2u );
+  CHECK( storage.hash.size() == 2u );
+
+  const std::vector<uint64_t> fanins{1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u};
+  CHECK( *storage.hash.find( compact_klut_key{fanins.data(), 2u, 2u, 4u} ) == 1u );
+  CHECK( *storage.hash.find( compact_klut_key{fanins.data(), 8u, 8u, 4u} ) == 2u );
+  CHECK( storage.hash.find( compact_klut_key{fanins.data(), 2u, 2u, 6u} ) == storage.hash.end() );
+  CHECK( storage.hash.find( compact_klut_key{fanins.data(), 7u, 7u, 4u} ) == storage.hash.end() );
+
+  /* copies rebind the hash table to their own nodes */
+  compact_klut_storage copy( storage );
+  storage.hash.clear();
+  storage.nodes.clear();
+  storage.fanin_arena.clear();
+  CHECK( *copy.hash.find( compact_klut_key{fanins.data(), 2u, 2u, 4u} ) == 1u );
+  CHECK( *copy.hash.find( compact_klut_key{fanins.data(), 8u, 8u, 4u} ) == 2u );
+}
@@ -4,6 +4,7 @@
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/traits.hpp>
 
@@ -687,3 +688,68 @@ TEST_CASE( "node substitution in MIGs", "[mig]" )
     }
   } );
 }
+
+TEST_CASE( "node substitution using the fanout index in MIGs", "[mig]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  mig.build_fanout_index();
+
+  const auto f1 = mig.create_maj( a, b, c );
+  const auto f2 = mig.create_and( a, f1 );
+  const auto f3 = mig.create_or( f1, c );
+  mig.create_po( f2 );
+  mig.create_po( f3 );
+
+  CHECK( mig._storage->fanout.at( mig.get_node( f1 ) ).size() == 2u );
+  CHECK( mig._storage->fanout.at( mig.get_node( a ) ).size() == 2u );
+
+  mig.substitute_node( mig.get_node( f1 ), b );
+
+  CHECK( mig.is_dead( mig.get_node( f1 ) ) );
+  CHECK( mig._storage->fanout.at( mig.get_node( f1 ) ).empty() );
+  CHECK( mig._storage->fanout.at( mig.get_node( b ) ).size() == 2u );
+  CHECK( mig._storage->fanout.at( mig.get_node( a ) ).size() == 1u );
+  mig.foreach_fanin( mig.get_node( f2 ), [&]( auto const& s ) {
+    CHECK( mig.get_node( s ) != mig.get_node( f1 ) );
+  } );
+}
+
+TEST_CASE( "rollback changes to an MIG", "[mig]" )
+{
+  mig_network mig;
+  const auto a = mig.create_pi();
+  const auto b = mig.create_pi();
+  const auto c = mig.create_pi();
+  const auto g = mig.create_maj( a, b, c );
+  const auto f = mig.create_maj( a, g, c );
+  mig.create_po( f );
+
+  const auto nodes = mig._storage->nodes;
+  const auto outputs = mig._storage->outputs;
+
+  mig.checkpoint();
+  CHECK( mig.has_checkpoint() );
+  /* <a<abc>c> = <abc> */
+  mig.substitute_node( mig.get_node( f ), g );
+  CHECK( mig.num_gates() == 1 );
+  mig.rollback();
+
+  CHECK( !mig.has_checkpoint() );
+  CHECK( mig.size() == 6 );
+  CHECK( mig.num_gates() == 2 );
+  CHECK( mig._storage->nodes == nodes );
+  CHECK( mig._storage->outputs == outputs );
+  CHECK( mig._storage->hash.size() == 2 );
+  mig.foreach_gate( [&]( auto const& n ) { CHECK( mig.fanout_size( n ) == 1 ); } );
+
+  /* the structural hash table is restored */
+  CHECK( mig.create_maj( c, b, a ) == g );
+
+  /* substituting again gives the same result */
+  mig.substitute_node( mig.get_node( f ), g );
+  mig = cleanup_dangling( mig );
+  CHECK( mig.num_gates() == 1 );
+}
@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include <kitty/algorithm.hpp>
@@ -729,3 +730,42 @@ TEST_CASE( "create nary functions in XAGs", "[xag]" )
   kitty::create_parity( copy );
   CHECK( result[2] == copy );
 }
+
+TEST_CASE( "compact XAGs after node substitution", "[xag]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+
+  const auto f1 = xag.create_and( a, b );
+  const auto f2 = xag.create_xor( f1, c );
+  const auto f3 = xag.create_and( f2, a );
+  xag.create_po( f3 );
+  xag.create_po( f2 );
+
+  /* the new node has a larger index than the fanout of f1 */
+  const auto f4 = xag.create_xor( b, c );
+  xag.substitute_node( xag.get_node( f1 ), f4 );
+  CHECK( xag.size() == 8u );
+
+  const auto old_to_new = xag.compact();
+  CHECK( old_to_new[xag.get_node( f1 )] == std::numeric_limits<xag_network::node>::max() );
+  CHECK( xag.size() == 7u );
+  CHECK( xag.num_gates() == 3u );
+  CHECK( xag.is_xor( old_to_new[xag.get_node( f2 )] ) );
+  CHECK( xag.is_and( old_to_new[xag.get_node( f3 )] ) );
+  CHECK( xag.is_xor( old_to_new[xag.get_node( f4 )] ) );
+  xag.foreach_gate( [&]( auto const& n ) {
+    xag.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( xag.get_node( f ) < n );
+    } );
+  } );
+
+  const auto tts = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( tts[0]._bits == 0x88 );
+  CHECK( tts[1]._bits == 0xcc );
+
+  CHECK( xag.get_node( xag.create_xor( c, b ) ) == old_to_new[xag.get_node( f4 )] );
+  CHECK( xag.size() == 7u );
+}
@@ -0,0 +1,132 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include <mockturtle/utils/chain_store.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+percy::chain and_chain()
+{
+  kitty::dynamic_truth_table op( 2u );
+  kitty::create_from_hex_string( op, "8" );
+
+  percy::chain c;
+  c.reset( 2, 1, 1, 2 );
+  c.set_step( 0, 0, 1, op );
+  c.set_output( 0, 3 << 1 );
+  return c;
+}
+
+/* writes a record with a valid checksum for `payload` */
+void append_record( std::string const& filename, std::string const& payload )
+{
+  uint32_t hash = 2166136261u;
+  for ( auto c : payload )
+  {
+    hash = ( hash ^ static_cast<uint8_t>( c ) ) * 16777619u;
+  }
+
+  std::string record = "MTCS";
+  for ( auto value : {static_cast<uint32_t>( payload.size() ), hash} )
+  {
+    for ( auto i = 0u; i < 4u; ++i )
+    {
+      record.push_back( static_cast<char>( ( value >> ( 8u * i ) ) & 0xff ) );
+    }
+  }
+
+  std::ofstream os( filename, std::ios::binary | std::ios::app );
+  os << record << payload;
+}
+
+} // namespace
+
+TEST_CASE( "Chain store persists and shares entries", "[chain_store]" )
+{
+  const std::string filename = "mockturtle-test-chains.bin";
+  std::remove( filename.c_str() );
+
+  kitty::dynamic_truth_table f_and( 2u ), f_or( 2u );
+  kitty::create_from_hex_string( f_and, "8" );
+  kitty::create_from_hex_string( f_or, "e" );
+
+  /* AND and OR are in the same NPN class */
+  const auto repr = std::get<0>( chain_store::canonization( f_and ) );
+  CHECK( repr == std::get<0>( chain_store::canonization( f_or ) ) );
+
+  chain_store store1( filename );
+  chain_store store2( filename );
+  CHECK( store1.size() == 0u );
+  CHECK( !store1.find( "aig", repr ) );
+
+  store1.insert( "aig", repr, {and_chain()} );
+  CHECK( store1.size() == 1u );
+  CHECK( !store1.find( "xag", repr ) );
+
+  /* entries of other stores are visible after refresh */
+  CHECK( !store2.find( "aig", repr ) );
+  store2.refresh();
+  const auto chains = store2.find( "aig", repr );
+  REQUIRE( chains );
+  REQUIRE( chains->size() == 1u );
+  CHECK( ( *chains )[0].get_nr_steps() == 1 );
+  CHECK( ( *chains )[0].get_step( 0 ) == std::vector<int>{0, 1} );
+  CHECK( ( *chains )[0].get_operator( 0 ) == and_chain().get_operator( 0 ) );
+  CHECK( ( *chains )[0].get_outputs() == std::vector<int>{6} );
+
+  /* an incomplete record at the end of the file is ignored */
+  {
+    std::ofstream os( filename, std::ios::binary | std::ios::app );
+    os.write( "MTCS\x20\x00\x00", 7 );
+  }
+  chain_store store3( filename );
+  CHECK( store3.size() == 1u );
+
+  /* records after garbage are still read */
+  store2.insert( "xag", repr, {and_chain(), and_chain()} );
+  chain_store store4( filename );
+  CHECK( store4.size() == 2u );
+  REQUIRE( store4.find( "xag", repr ) );
+  CHECK( store4.find( "xag", repr )->size() == 2u );
+
+  std::remove( filename.c_str() );
+}
+
+TEST_CASE( "Chain store rejects malformed records and failed writes", "[chain_store]" )
+{
+  const std::string filename = "mockturtle-test-chains-malformed.bin";
+  std::remove( filename.c_str() );
+
+  kitty::dynamic_truth_table f_and( 2u );
+  kitty::create_from_hex_string( f_and, "8" );
+
+  /* a record with too many variables but a valid checksum */
+  std::string payload( "\x03" "aig" "\x28" );
+  payload.append( 16u, '\0' );
+  append_record( filename, payload );
+
+  chain_store store( filename );
+  CHECK( store.size() == 0u );
+  CHECK( store.insert( "aig", f_and, {and_chain()} ) );
+  CHECK( chain_store( filename ).size() == 1u );
+
+  /* entries that cannot be written are not stored */
+  chain_store missing( "mockturtle-missing-directory/chains.bin" );
+  CHECK( !missing.insert( "aig", f_and, {and_chain()} ) );
+  CHECK( missing.size() == 0u );
+  CHECK( !missing.find( "aig", f_and ) );
+
+  kitty::dynamic_truth_table large( chain_store::max_num_vars + 1u );
+  CHECK( !store.insert( "aig", large, {and_chain()} ) );
+  CHECK( store.size() == 1u );
+
+  std::remove( filename.c_str() );
+}
@@ -0,0 +1,53 @@
+#include <catch.hpp>
+
+#include <string>
+
+#include <mockturtle/utils/names_storage.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "intern names", "[names_storage]" )
+{
+  names_storage names( '.', 2u );
+
+  CHECK( names.size() == 0u );
+
+  const auto a = names.insert( "top.u1.a" );
+  const auto b = names.insert( "top.u1.b" );
+  CHECK( names.size() == 4u );
+  CHECK( names[a] == "top.u1.a" );
+  CHECK( names[b] == "top.u1.b" );
+  CHECK( names.local_name( a ) == "a" );
+  CHECK( names.prefix( a ) == names.prefix( b ) );
+  CHECK( names[names.prefix( a )] == "top.u1" );
+  CHECK( names.prefix( names.prefix( names.prefix( a ) ) ) == names_storage::root );
+
+  CHECK( names.insert( "top.u1.a" ) == a );
+  CHECK( names.insert( names.prefix( a ), "a" ) == a );
+  CHECK( names.insert( "top.u1" ) == names.prefix( a ) );
+  CHECK( names.size() == 4u );
+
+  /* local names are not split */
+  const auto c = names.insert( names.prefix( a ), "c.d" );
+  CHECK( names[c] == "top.u1.c.d" );
+  CHECK( names.insert( "top.u1.c.d" ) != c );
+
+  /* empty components */
+  for ( std::string const name : {"", ".", "a.", ".a", "a..b", "x"} )
+  {
+    CHECK( names[names.insert( name )] == name );
+  }
+
+  /* grow the hash table */
+  for ( auto i = 0u; i < 1000u; ++i )
+  {
+    const auto id = names.insert( "top.n" + std::to_string( i ) );
+    CHECK( names[id] == "top.n" + std::to_string( i ) );
+  }
+  CHECK( names[a] == "top.u1.a" );
+  CHECK( names.insert( "top.n500" ) == names.insert( names.prefix( names.prefix( a ) ), "n500" ) );
+
+  names_storage paths( '/' );
+  CHECK( paths[paths.insert( "top/u1.a" )] == "top/u1.a" );
+  CHECK( paths.size() == 2u );
+}
@@ -0,0 +1,31 @@
+#include <catch.hpp>
+
+#include <algorithm>
+
+#include <mockturtle/utils/npn4_table.hpp>
+
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "NPN table agrees with exact NPN canonization", "[npn4_table]" )
+{
+  auto const& npn = npn4_table::instance();
+  CHECK( &npn == &npn4_table::instance() );
+  CHECK( npn.num_classes() == 222u );
+
+  kitty::static_truth_table<4u> tt;
+  do
+  {
+    const auto [repr, phase, perm] = kitty::exact_npn_canonization( tt );
+    const auto [t_repr, t_phase, t_perm] = npn.canonization( tt );
+
+    CHECK( repr == t_repr );
+    CHECK( phase == t_phase );
+    CHECK( std::equal( perm.begin(), perm.end(), t_perm.begin() ) );
+
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+}
@@ -1,8 +1,12 @@
 #include <catch.hpp>
 
+#include <thread>
+#include <vector>
+
 #include <mockturtle/utils/truth_table_cache.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
 
 using namespace mockturtle;
 
@@ -45,3 +49,145 @@ TEST_CASE( "working with a truth table cache", "[truth_table_cache]" )
   CHECK( cache[8] == f_maj );
   CHECK( cache[9] == ~f_maj );
 }
+
+TEST_CASE( "working with a truth table cache for 64-bit words", "[truth_table_cache]" )
+{
+  truth_table_cache<uint64_t> cache( 4u );
+
+  CHECK( cache.insert( 0u ) == 0 );
+  CHECK( cache.insert( 0xaaaaaaaaaaaaaaaa ) == 2 );
+  CHECK( cache.insert( 0x8888888888888888 ) == 4 );
+  CHECK( cache.insert( ~UINT64_C( 0 ) ) == 1 );
+  CHECK( cache.insert( 0x5555555555555555 ) == 3 );
+  CHECK( cache.size() == 3 );
+
+  /* grow the hash table */
+  for ( auto i = 0u; i < 1000u; ++i )
+  {
+    CHECK( cache.insert( static_cast<uint64_t>( i + 3u ) << 1 ) == 2u * ( i + 3u ) );
+  }
+  CHECK( cache.size() == 1003 );
+  CHECK( cache.insert( 0x8888888888888888 ) == 4 );
+  CHECK( cache[5] == 0x7777777777777777 );
+  CHECK( cache[2u * 500u] == UINT64_C( 1000 ) );
+
+  cache.clear();
+  CHECK( cache.size() == 0 );
+  CHECK( cache.insert( 0x8888888888888888 ) == 0 );
+}
+
+TEST_CASE( "truth tables of different sizes in a truth table cache", "[truth_table_cache]" )
+{
+  truth_table_cache<kitty::dynamic_truth_table> cache( 2u );
+
+  std::vector<kitty::dynamic_truth_table> tts;
+  for ( auto num_vars = 0u; num_vars <= 9u; ++num_vars )
+  {
+    kitty::dynamic_truth_table tt( num_vars );
+    for ( auto i = 0u; i < 20u; ++i )
+    {
+      kitty::create_random( tt, 10u * num_vars + i );
+      tts.push_back( tt );
+    }
+  }
+
+  std::vector<uint32_t> lits;
+  for ( auto const& tt : tts )
+  {
+    lits.push_back( cache.insert( tt ) );
+  }
+
+  const auto copy = cache;
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    CHECK( cache.insert( tts[i] ) == lits[i] );
+    CHECK( cache.insert( ~tts[i] ) == ( lits[i] ^ 1 ) );
+    CHECK( cache[lits[i]] == tts[i] );
+    CHECK( copy[lits[i]] == tts[i] );
+  }
+  CHECK( cache.size() == copy.size() );
+
+  /* functions that differ only in their number of variables */
+  kitty::dynamic_truth_table x1( 1u ), x1_2( 2u );
+  kitty::create_nth_var( x1, 0u );
+  kitty::create_nth_var( x1_2, 0u );
+  CHECK( cache.insert( x1 ) != cache.insert( x1_2 ) );
+  CHECK( cache[cache.insert( x1 )].num_vars() == 1u );
+
+  truth_table_cache<kitty::static_truth_table<3>> static_cache;
+  kitty::static_truth_table<3> maj;
+  kitty::create_majority( maj );
+  CHECK( static_cache.insert( maj ) == 0 );
+  CHECK( static_cache.insert( ~maj ) == 1 );
+  CHECK( static_cache[1] == ~maj );
+}
+
+TEST_CASE( "concurrent insertion into a truth table cache", "[truth_table_cache]" )
+{
+  truth_table_cache<kitty::dynamic_truth_table> cache;
+
+  /* some truth tables are inserted before concurrent insertion */
+  std::vector<kitty::dynamic_truth_table> tts;
+  for ( auto i = 0u; i < 2000u; ++i )
+  {
+    kitty::dynamic_truth_table tt( 4u + i % 6u );
+    kitty::create_random( tt, i % 700u );
+    tts.push_back( ( i % 3u == 0u ) ? ~tt : tt );
+  }
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    cache.insert( tts[i] );
+  }
+
+  const auto num_threads = 4u;
+  std::vector<std::vector<uint32_t>> lits( num_threads );
+
+  cache.begin_concurrent_insert();
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      for ( auto i = 0u; i < tts.size(); ++i )
+      {
+        const auto& tt = tts[( i + 500u * t ) % tts.size()];
+        const auto lit = cache.insert_concurrent( tt );
+        lits[t].push_back( lit );
+        if ( cache[lit] != tt )
+        {
+          lits[t].back() = ~UINT32_C( 0 );
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    for ( auto i = 0u; i < tts.size(); ++i )
+    {
+      CHECK( lits[t][i] == lits[0][( i + 500u * t ) % tts.size()] );
+    }
+  }
+
+  const auto size = cache.size();
+  cache.end_concurrent_insert();
+  CHECK( cache.size() == size );
+
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    CHECK( cache[lits[0][i]] == tts[i] );
+    CHECK( cache.insert( tts[i] ) == lits[0][i] );
+  }
+  CHECK( cache.size() == size );
+
+  /* the cache has one entry per normalized truth table */
+  truth_table_cache<kitty::dynamic_truth_table> sequential;
+  for ( auto const& tt : tts )
+  {
+    sequential.insert( tt );
+  }
+  CHECK( cache.size() == sequential.size() );
+}
@@ -1,11 +1,18 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+
 #include <mockturtle/traits.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
 
 using namespace mockturtle;
 
@@ -136,3 +143,133 @@ TEST_CASE( "compute levels during node construction with cost function", "[depth
   CHECK( dxag.depth() == 1u );
 }
 
+
+/* compares incremental information against levels computed from scratch */
+template<class Ntk>
+void check_incremental_levels( Ntk const& ntk, bool count_complements )
+{
+  const auto offset = [&]( auto const& f ) { return ( count_complements && ntk.is_complemented( f ) ) ? 1 : 0; };
+
+  std::vector<uint32_t> levels( ntk.size(), 0u );
+  std::vector<int32_t> tails( ntk.size(), -1 );
+  uint32_t depth{0u};
+
+  /* substitutions may break the index order, hence compute a topological order first */
+  std::vector<node<Ntk>> topo_order;
+  std::vector<bool> visited( ntk.size(), false );
+  const std::function<void( node<Ntk> const& )> visit = [&]( auto const& n ) {
+    if ( visited[n] || ntk.is_ci( n ) || ntk.is_constant( n ) )
+    {
+      return;
+    }
+    visited[n] = true;
+    ntk.foreach_fanin( n, [&]( auto const& f ) { visit( ntk.get_node( f ) ); } );
+    topo_order.push_back( n );
+  };
+  ntk.foreach_gate( visit );
+
+  for ( auto const& n : topo_order )
+  {
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      levels[n] = std::max( levels[n], levels[ntk.get_node( f )] + offset( f ) );
+    } );
+    ++levels[n];
+  }
+  ntk.foreach_po( [&]( auto const& f ) {
+    depth = std::max( depth, levels[ntk.get_node( f )] + offset( f ) );
+    tails[ntk.get_node( f )] = std::max( tails[ntk.get_node( f )], static_cast<int32_t>( offset( f ) ) );
+  } );
+  for ( auto it = topo_order.rbegin(); it != topo_order.rend(); ++it )
+  {
+    if ( tails[*it] < 0 )
+    {
+      continue;
+    }
+    ntk.foreach_fanin( *it, [&]( auto const& f ) {
+      tails[ntk.get_node( f )] = std::max( tails[ntk.get_node( f )], tails[*it] + 1 + offset( f ) );
+    } );
+  }
+
+  CHECK( ntk.depth() == depth );
+  ntk.foreach_node( [&]( auto const& n ) {
+    if ( ntk.is_dead( n ) )
+    {
+      return;
+    }
+    CHECK( ntk.level( n ) == levels[n] );
+    CHECK( ntk.required( n ) == ( tails[n] < 0 ? std::numeric_limits<uint32_t>::max() : depth - tails[n] ) );
+    CHECK( ntk.is_on_critical_path( n ) == ( tails[n] >= 0 && levels[n] + tails[n] == depth ) );
+  } );
+}
+
+template<class Ntk, class Base = Ntk>
+void test_incremental_levels( bool count_complements )
+{
+  Ntk ntk;
+  std::vector<signal<Ntk>> signals;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    signals.push_back( ntk.create_pi() );
+  }
+
+  std::mt19937 rng( 1u );
+  const auto random_signal = [&]( uint32_t bound ) {
+    auto f = signals[rng() % bound];
+    while ( ntk.is_dead( ntk.get_node( f ) ) )
+    {
+      f = signals[rng() % bound];
+    }
+    return rng() % 2u ? ntk.create_not( f ) : f;
+  };
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    signals.push_back( ntk.create_and( random_signal( static_cast<uint32_t>( signals.size() ) ), random_signal( static_cast<uint32_t>( signals.size() ) ) ) );
+  }
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    ntk.create_po( random_signal( static_cast<uint32_t>( signals.size() ) ) );
+  }
+
+  depth_view_params ps;
+  ps.count_complements = count_complements;
+  Base base{ntk};
+  depth_view<Base> view{base, {}, ps};
+  check_incremental_levels( view, count_complements );
+
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    if ( i % 3u == 0u )
+    {
+      signals.push_back( view.create_and( random_signal( static_cast<uint32_t>( signals.size() ) ), random_signal( static_cast<uint32_t>( signals.size() ) ) ) );
+      if ( i % 9u == 0u )
+      {
+        view.create_po( signals.back() );
+      }
+    }
+    else
+    {
+      /* substitute by an older signal, which cannot be in the transitive fanout */
+      const auto n = view.get_node( signals[8u + rng() % ( signals.size() - 8u )] );
+      if ( view.is_dead( n ) )
+      {
+        continue;
+      }
+      std::vector<signal<Ntk>> candidates;
+      std::copy_if( signals.begin(), signals.end(), std::back_inserter( candidates ), [&]( auto const& f ) {
+        return view.get_node( f ) < n && !view.is_dead( view.get_node( f ) );
+      } );
+      view.substitute_node( n, candidates[rng() % candidates.size()] ^ ( rng() % 2u == 0u ) );
+    }
+    check_incremental_levels( view, count_complements );
+  }
+}
+
+TEST_CASE( "update levels incrementally on modification and deletion", "[depth_view]" )
+{
+  for ( auto count_complements : {false, true} )
+  {
+    test_incremental_levels<aig_network>( count_complements );
+    test_incremental_levels<mig_network>( count_complements );
+    test_incremental_levels<aig_network, fanout_view<aig_network>>( count_complements );
+  }
+}
@@ -1,6 +1,8 @@
 #include <catch.hpp>
 
+#include <random>
 #include <set>
+#include <vector>
 
 #include <mockturtle/traits.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -81,3 +83,58 @@ TEST_CASE( "compute fanout for AIG", "[fanout_view]" )
     CHECK( nodes == std::set<node<aig_network>>{ aig.get_node( f4 ) } );
   }
 }
+
+TEST_CASE( "update fanout incrementally for AIG", "[fanout_view]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> signals;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    signals.push_back( aig.create_pi() );
+  }
+
+  std::mt19937 rng( 42u );
+  const auto random_signal = [&]() {
+    const auto f = signals[rng() % signals.size()];
+    return rng() % 2u ? !f : f;
+  };
+
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    signals.push_back( aig.create_and( random_signal(), random_signal() ) );
+  }
+
+  fanout_view fanout_aig{aig};
+
+  /* new nodes move lists of their fanins and eventually repack the storage */
+  for ( auto i = 0u; i < 2000u; ++i )
+  {
+    signals.push_back( fanout_aig.create_and( random_signal(), random_signal() ) );
+  }
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    const auto n = fanout_aig.get_node( signals[16u + rng() % ( signals.size() - 16u )] );
+    if ( fanout_aig.is_dead( n ) )
+    {
+      continue;
+    }
+    fanout_aig.substitute_node( n, signals[rng() % 16u] );
+  }
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fanout_aig.create_po( random_signal() );
+  }
+
+  fanout_view fanout_aig2{aig};
+  aig.foreach_node( [&]( auto const& n ) {
+    if ( aig.is_dead( n ) )
+    {
+      return;
+    }
+    std::set<node<aig_network>> nodes, nodes2;
+    fanout_aig.foreach_fanout( n, [&]( const auto& p ) { nodes.insert( p ); } );
+    fanout_aig2.foreach_fanout( n, [&]( const auto& p ) { nodes2.insert( p ); } );
+    CHECK( nodes == nodes2 );
+    CHECK( fanout_aig.fanout( n ).size() == nodes.size() );
+  } );
+}
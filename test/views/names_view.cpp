@@ -99,3 +99,51 @@ TEST_CASE( "copy names", "[names_view]" )
   test_copy_names_view<xmg_network>();
   test_copy_names_view<klut_network>();
 }
+
+TEST_CASE( "hierarchical and complemented names", "[names_view]" )
+{
+  names_view<aig_network> ntk;
+  auto const a = ntk.create_pi( "top.u1.a" );
+  auto const b = ntk.create_pi( "top.u1.b" );
+  auto const f = ntk.create_and( a, b );
+  ntk.create_po( f, "top.f" );
+  ntk.create_po( !f );
+
+  ntk.set_name( f, "top.u1.f" );
+  ntk.set_name( !f, "top.u1.f_n" );
+
+  CHECK( ntk.get_name( a ) == "top.u1.a" );
+  CHECK( ntk.get_name( b ) == "top.u1.b" );
+  CHECK( ntk.get_name( f ) == "top.u1.f" );
+  CHECK( ntk.get_name( !f ) == "top.u1.f_n" );
+  CHECK( !ntk.has_name( !a ) );
+  CHECK( ntk.get_output_name( 0 ) == "top.f" );
+  CHECK( !ntk.has_output_name( 1 ) );
+  CHECK( !ntk.has_output_name( 2 ) );
+  CHECK_THROWS_AS( ntk.get_name( !a ), std::out_of_range );
+  CHECK_THROWS_AS( ntk.get_output_name( 1 ), std::out_of_range );
+
+  /* top, top.u1, 4 signal names, and top.f */
+  CHECK( ntk.names().size() == 7u );
+
+  ntk.set_name( a, "a" );
+  CHECK( ntk.get_name( a ) == "a" );
+  ntk.set_name( b, "" );
+  CHECK( ntk.has_name( b ) );
+  CHECK( ntk.get_name( b ).empty() );
+}
+
+TEST_CASE( "assign names view", "[names_view]" )
+{
+  names_view<klut_network> ntk1, ntk2;
+  auto const a = ntk1.create_pi( "a" );
+  ntk1.create_po( a, "f" );
+  ntk2.create_pi();
+  auto const b = ntk2.create_pi();
+  ntk2.create_po( b );
+
+  /* names of primary inputs are kept */
+  ntk1 = ntk2;
+  CHECK( ntk1.get_name( ntk1.make_signal( ntk1.pi_at( 0 ) ) ) == "a" );
+  CHECK( !ntk1.has_name( ntk1.make_signal( ntk1.pi_at( 1 ) ) ) );
+}